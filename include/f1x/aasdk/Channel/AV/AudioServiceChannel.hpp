@@ -37,6 +37,10 @@ public:
     AudioServiceChannel(boost::asio::io_service::strand& strand, messenger::IMessenger::Pointer messenger,  messenger::ChannelId channelId);
 
     void receive(IAudioServiceChannelEventHandler::Pointer eventHandler) override;
+    void subscribe(IAudioServiceChannelEventHandler::Pointer eventHandler) override;
+    void subscribe(messenger::ReceiveRing::Pointer ring) override;
+    void handleMessage(messenger::Message::Pointer message, IAudioServiceChannelEventHandler::Pointer eventHandler) override;
+    void unsubscribe() override;
     void sendChannelOpenResponse(const proto::messages::ChannelOpenResponse& response, SendPromise::Pointer promise) override;
     void sendAVChannelSetupResponse(const proto::messages::AVChannelSetupResponse& response, SendPromise::Pointer promise) override;
     void sendAVMediaAckIndication(const proto::messages::AVMediaAckIndication& indication, SendPromise::Pointer promise) override;
@@ -22,7 +22,9 @@
 #include <aasdk_proto/AVChannelSetupResponseMessage.pb.h>
 #include <aasdk_proto/AVMediaAckIndicationMessage.pb.h>
 #include <aasdk_proto/ChannelOpenResponseMessage.pb.h>
+#include <f1x/aasdk/Error/Error.hpp>
 #include <f1x/aasdk/Messenger/ChannelId.hpp>
+#include <f1x/aasdk/Messenger/ReceiveRing.hpp>
 #include <f1x/aasdk/Channel/Promise.hpp>
 #include <f1x/aasdk/Channel/AV/IAudioServiceChannelEventHandler.hpp>
 
@@ -44,6 +46,27 @@ public:
     virtual ~IAudioServiceChannel() = default;
 
     virtual void receive(IAudioServiceChannelEventHandler::Pointer eventHandler) = 0;
+
+    virtual void subscribe(IAudioServiceChannelEventHandler::Pointer eventHandler)
+    {
+        this->receive(std::move(eventHandler));
+    }
+
+    virtual void subscribe(messenger::ReceiveRing::Pointer)
+    {
+        throw error::Error(error::ErrorCode::OPERATION_NOT_SUPPORTED);
+    }
+
+    virtual void handleMessage(messenger::Message::Pointer, IAudioServiceChannelEventHandler::Pointer)
+    {
+        throw error::Error(error::ErrorCode::OPERATION_NOT_SUPPORTED);
+    }
+
+    virtual void unsubscribe()
+    {
+
+    }
+
     virtual void sendChannelOpenResponse(const proto::messages::ChannelOpenResponse& response, SendPromise::Pointer promise) = 0;
     virtual void sendAVChannelSetupResponse(const proto::messages::AVChannelSetupResponse& response, SendPromise::Pointer promise) = 0;
     virtual void sendAVMediaAckIndication(const proto::messages::AVMediaAckIndication& indication, SendPromise::Pointer promise) = 0;
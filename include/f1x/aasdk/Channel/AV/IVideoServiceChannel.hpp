@@ -23,7 +23,9 @@
 #include <aasdk_proto/VideoFocusIndicationMessage.pb.h>
 #include <aasdk_proto/AVMediaAckIndicationMessage.pb.h>
 #include <aasdk_proto/ChannelOpenResponseMessage.pb.h>
+#include <f1x/aasdk/Error/Error.hpp>
 #include <f1x/aasdk/Messenger/ChannelId.hpp>
+#include <f1x/aasdk/Messenger/ReceiveRing.hpp>
 #include <f1x/aasdk/Channel/Promise.hpp>
 #include <f1x/aasdk/Channel/AV/IVideoServiceChannelEventHandler.hpp>
 
@@ -45,6 +47,27 @@ public:
     virtual ~IVideoServiceChannel() = default;
 
     virtual void receive(IVideoServiceChannelEventHandler::Pointer eventHandler) = 0;
+
+    virtual void subscribe(IVideoServiceChannelEventHandler::Pointer eventHandler)
+    {
+        this->receive(std::move(eventHandler));
+    }
+
+    virtual void subscribe(messenger::ReceiveRing::Pointer)
+    {
+        throw error::Error(error::ErrorCode::OPERATION_NOT_SUPPORTED);
+    }
+
+    virtual void handleMessage(messenger::Message::Pointer, IVideoServiceChannelEventHandler::Pointer)
+    {
+        throw error::Error(error::ErrorCode::OPERATION_NOT_SUPPORTED);
+    }
+
+    virtual void unsubscribe()
+    {
+
+    }
+
     virtual void sendChannelOpenResponse(const proto::messages::ChannelOpenResponse& response, SendPromise::Pointer promise) = 0;
     virtual void sendAVChannelSetupResponse(const proto::messages::AVChannelSetupResponse& response, SendPromise::Pointer promise) = 0;
     virtual void sendVideoFocusIndication(const proto::messages::VideoFocusIndication& indication, SendPromise::Pointer promise) = 0;
@@ -36,6 +36,10 @@ public:
     VideoServiceChannel(boost::asio::io_service::strand& strand, messenger::IMessenger::Pointer messenger);
 
     void receive(IVideoServiceChannelEventHandler::Pointer eventHandler) override;
+    void subscribe(IVideoServiceChannelEventHandler::Pointer eventHandler) override;
+    void subscribe(messenger::ReceiveRing::Pointer ring) override;
+    void handleMessage(messenger::Message::Pointer message, IVideoServiceChannelEventHandler::Pointer eventHandler) override;
+    void unsubscribe() override;
     void sendChannelOpenResponse(const proto::messages::ChannelOpenResponse& response, SendPromise::Pointer promise) override;
     void sendAVChannelSetupResponse(const proto::messages::AVChannelSetupResponse& response, SendPromise::Pointer promise) override;
     void sendVideoFocusIndication(const proto::messages::VideoFocusIndication& indication, SendPromise::Pointer promise) override;
@@ -36,6 +36,8 @@ public:
     BluetoothServiceChannel(boost::asio::io_service::strand& strand, messenger::IMessenger::Pointer messenger);
 
     void receive(IBluetoothServiceChannelEventHandler::Pointer eventHandler) override;
+    void subscribe(IBluetoothServiceChannelEventHandler::Pointer eventHandler) override;
+    void unsubscribe() override;
     messenger::ChannelId getId() const override;
     void sendChannelOpenResponse(const proto::messages::ChannelOpenResponse& response, SendPromise::Pointer promise) override;
     void sendBluetoothPairingResponse(const proto::messages::BluetoothPairingResponse& response, SendPromise::Pointer promise) override;
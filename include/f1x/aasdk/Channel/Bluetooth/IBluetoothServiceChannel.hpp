@@ -43,6 +43,17 @@ public:
     virtual ~IBluetoothServiceChannel() = default;
 
     virtual void receive(IBluetoothServiceChannelEventHandler::Pointer eventHandler) = 0;
+
+    virtual void subscribe(IBluetoothServiceChannelEventHandler::Pointer eventHandler)
+    {
+        this->receive(std::move(eventHandler));
+    }
+
+    virtual void unsubscribe()
+    {
+
+    }
+
     virtual void sendChannelOpenResponse(const proto::messages::ChannelOpenResponse& response, SendPromise::Pointer promise) = 0;
     virtual void sendBluetoothPairingResponse(const proto::messages::BluetoothPairingResponse& response, SendPromise::Pointer promise) = 0;
     virtual messenger::ChannelId getId() const = 0;
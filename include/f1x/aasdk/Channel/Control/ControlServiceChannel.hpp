@@ -38,6 +38,8 @@ public:
     ControlServiceChannel(boost::asio::io_service::strand& strand, messenger::IMessenger::Pointer messenger);
 
     void receive(IControlServiceChannelEventHandler::Pointer eventHandler) override;
+    void subscribe(IControlServiceChannelEventHandler::Pointer eventHandler) override;
+    void unsubscribe() override;
 
     void sendVersionRequest(SendPromise::Pointer promise) override;
     void sendHandshake(common::Data handshakeBuffer, SendPromise::Pointer promise) override;
@@ -49,6 +49,16 @@ public:
 
     virtual void receive(IControlServiceChannelEventHandler::Pointer eventHandler) = 0;
 
+    virtual void subscribe(IControlServiceChannelEventHandler::Pointer eventHandler)
+    {
+        this->receive(std::move(eventHandler));
+    }
+
+    virtual void unsubscribe()
+    {
+
+    }
+
     virtual void sendVersionRequest(SendPromise::Pointer promise) = 0;
     virtual void sendHandshake(common::Data handshakeBuffer, SendPromise::Pointer promise) = 0;
     virtual void sendAuthComplete(const proto::messages::AuthCompleteIndication& response, SendPromise::Pointer promise) = 0;
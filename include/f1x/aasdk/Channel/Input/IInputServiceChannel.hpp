@@ -45,6 +45,17 @@ public:
     virtual ~IInputServiceChannel() = default;
 
     virtual void receive(IInputServiceChannelEventHandler::Pointer eventHandler) = 0;
+
+    virtual void subscribe(IInputServiceChannelEventHandler::Pointer eventHandler)
+    {
+        this->receive(std::move(eventHandler));
+    }
+
+    virtual void unsubscribe()
+    {
+
+    }
+
     virtual void sendChannelOpenResponse(const proto::messages::ChannelOpenResponse& response, SendPromise::Pointer promise) = 0;
     virtual void sendInputEventIndication(const proto::messages::InputEventIndication& indication, SendPromise::Pointer promise) = 0;
     virtual void sendBindingResponse(const proto::messages::BindingResponse& response, SendPromise::Pointer promise) = 0;
@@ -36,6 +36,8 @@ class InputServiceChannel: public IInputServiceChannel, public ServiceChannel, p
     InputServiceChannel(boost::asio::io_service::strand& strand, messenger::IMessenger::Pointer messenger);
 
     void receive(IInputServiceChannelEventHandler::Pointer eventHandler) override;
+    void subscribe(IInputServiceChannelEventHandler::Pointer eventHandler) override;
+    void unsubscribe() override;
     void sendChannelOpenResponse(const proto::messages::ChannelOpenResponse& response, SendPromise::Pointer promise) override;
     void sendInputEventIndication(const proto::messages::InputEventIndication& indication, SendPromise::Pointer promise) override;
     void sendBindingResponse(const proto::messages::BindingResponse& response, SendPromise::Pointer promise) override;
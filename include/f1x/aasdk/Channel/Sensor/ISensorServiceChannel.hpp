@@ -44,6 +44,17 @@ public:
     virtual ~ISensorServiceChannel() = default;
 
     virtual void receive(ISensorServiceChannelEventHandler::Pointer eventHandler) = 0;
+
+    virtual void subscribe(ISensorServiceChannelEventHandler::Pointer eventHandler)
+    {
+        this->receive(std::move(eventHandler));
+    }
+
+    virtual void unsubscribe()
+    {
+
+    }
+
     virtual messenger::ChannelId getId() const = 0;
     virtual void sendChannelOpenResponse(const proto::messages::ChannelOpenResponse& response, SendPromise::Pointer promise) = 0;
     virtual void sendSensorEventIndication(const proto::messages::SensorEventIndication& indication, SendPromise::Pointer promise) = 0;
@@ -36,6 +36,8 @@ public:
     SensorServiceChannel(boost::asio::io_service::strand& strand, messenger::IMessenger::Pointer messenger);
 
     void receive(ISensorServiceChannelEventHandler::Pointer eventHandler) override;
+    void subscribe(ISensorServiceChannelEventHandler::Pointer eventHandler) override;
+    void unsubscribe() override;
     messenger::ChannelId getId() const override;
     void sendChannelOpenResponse(const proto::messages::ChannelOpenResponse& response, SendPromise::Pointer promise) override;
     void sendSensorEventIndication(const proto::messages::SensorEventIndication& indication, SendPromise::Pointer promise) override;
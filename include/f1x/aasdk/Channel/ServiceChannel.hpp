@@ -18,8 +18,10 @@
 
 #pragma once
 
+#include <mutex>
 #include <boost/asio.hpp>
 #include <f1x/aasdk/Messenger/IMessenger.hpp>
+#include <f1x/aasdk/Messenger/ReceiveSubscription.hpp>
 #include <f1x/aasdk/Channel/Promise.hpp>
 
 namespace f1x
@@ -31,17 +33,30 @@ namespace channel
 
 class ServiceChannel
 {
+public:
+    void bindExecutor(io::WorkStealingExecutor::Strand::Pointer executorStrand);
+
 protected:
     ServiceChannel(boost::asio::io_service::strand& strand,
                    messenger::IMessenger::Pointer messenger,
                    messenger::ChannelId channelId);
 
     virtual ~ServiceChannel() = default;
+    messenger::Message::Pointer createMessage(messenger::EncryptionType encryptionType, messenger::MessageType type, size_t payloadSize = 0);
     void send(messenger::Message::Pointer message, SendPromise::Pointer promise);
+    void startSubscription(messenger::ReceiveSubscription::MessageHandler messageHandler, messenger::ReceiveSubscription::ErrorHandler errorHandler);
+    void startSubscription(messenger::IReceiveSubscription::Pointer subscription);
+    void stopSubscription();
+    bool isSubscribed() const;
 
     boost::asio::io_service::strand& strand_;
     messenger::IMessenger::Pointer messenger_;
     messenger::ChannelId channelId_;
+
+private:
+    mutable std::mutex subscriptionMutex_;
+    messenger::IReceiveSubscription::Pointer subscription_;
+    io::WorkStealingExecutor::Strand::Pointer executorStrand_;
 };
 
 }
@@ -0,0 +1,49 @@
+/*
+*  This file is part of aasdk library project.
+*  Copyright (C) 2018 f1x.studio (Michal Szwaj)
+*
+*  aasdk is free software: you can redistribute it and/or modify
+*  it under the terms of the GNU General Public License as published by
+*  the Free Software Foundation; either version 3 of the License, or
+*  (at your option) any later version.
+
+*  aasdk is distributed in the hope that it will be useful,
+*  but WITHOUT ANY WARRANTY; without even the implied warranty of
+*  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+*  GNU General Public License for more details.
+*
+*  You should have received a copy of the GNU General Public License
+*  along with aasdk. If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#pragma once
+
+#include <memory>
+#include <vector>
+#include <f1x/aasdk/Common/Data.hpp>
+
+namespace f1x
+{
+namespace aasdk
+{
+namespace common
+{
+
+struct DataSegment
+{
+    explicit DataSegment(std::shared_ptr<Data> _storage);
+    DataSegment(std::shared_ptr<Data> _storage, Data::size_type offset, Data::size_type _size);
+
+    bool isWhole() const;
+
+    std::shared_ptr<Data> storage;
+    DataConstBuffer buffer;
+};
+
+typedef std::vector<DataSegment> DataChain;
+
+size_t getSize(const DataChain& chain);
+
+}
+}
+}
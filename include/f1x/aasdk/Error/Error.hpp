@@ -32,22 +32,24 @@ namespace error
 class Error: public std::exception
 {
 public:
-    Error();
-    Error(ErrorCode code, uint32_t nativeCode = 0);
+    Error() noexcept;
+    Error(ErrorCode code, uint32_t nativeCode = 0) noexcept;
 
-    ErrorCode getCode() const;
-    uint32_t getNativeCode() const;
+    ErrorCode getCode() const noexcept;
+    uint32_t getNativeCode() const noexcept;
     const char* what() const noexcept override;
 
-    bool operator!() const;
-    bool operator==(const Error& other) const;
-    bool operator==(const ErrorCode& code) const;
-    bool operator!=(const ErrorCode& code) const;
+    bool operator!() const noexcept;
+    bool operator==(const Error& other) const noexcept;
+    bool operator==(const ErrorCode& code) const noexcept;
+    bool operator!=(const ErrorCode& code) const noexcept;
 
 private:
     ErrorCode code_;
     uint32_t nativeCode_;
-    std::string message_;
+    // Formatted by the constructor instead of lazily by what(): errors are shared across threads
+    // (promises, worker tasks), and filling the buffer on first use would race between readers.
+    char message_[64];
 };
 
 }
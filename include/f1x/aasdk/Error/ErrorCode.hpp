@@ -62,7 +62,12 @@ enum class ErrorCode
     OPERATION_ABORTED = 30,
     OPERATION_IN_PROGRESS = 31,
     PARSE_PAYLOAD = 32,
-    TCP_TRANSFER = 33
+    TCP_TRANSFER = 33,
+    MESSENGER_SEND_DEADLINE_EXCEEDED = 34,
+    SSL_CIPHER_LIST = 35,
+    THREAD_AFFINITY = 36,
+    THREAD_SCHEDULING = 37,
+    OPERATION_NOT_SUPPORTED = 38
 };
 
 }
@@ -0,0 +1,189 @@
+/*
+*  This file is part of aasdk library project.
+*  Copyright (C) 2018 f1x.studio (Michal Szwaj)
+*
+*  aasdk is free software: you can redistribute it and/or modify
+*  it under the terms of the GNU General Public License as published by
+*  the Free Software Foundation; either version 3 of the License, or
+*  (at your option) any later version.
+
+*  aasdk is distributed in the hope that it will be useful,
+*  but WITHOUT ANY WARRANTY; without even the implied warranty of
+*  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+*  GNU General Public License for more details.
+*
+*  You should have received a copy of the GNU General Public License
+*  along with aasdk. If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#pragma once
+
+#if defined(__cpp_impl_coroutine)
+
+#include <coroutine>
+#include <exception>
+#include <optional>
+#include <utility>
+#include <f1x/aasdk/Error/Error.hpp>
+#include <f1x/aasdk/IO/Promise.hpp>
+#include <f1x/aasdk/IO/RecyclingMemory.hpp>
+
+namespace f1x
+{
+namespace aasdk
+{
+namespace io
+{
+
+// Detached coroutine started eagerly by the caller. Exceptions must not escape its body.
+class Task
+{
+public:
+    struct promise_type
+    {
+        Task get_return_object() noexcept
+        {
+            return Task();
+        }
+
+        std::suspend_never initial_suspend() noexcept
+        {
+            return {};
+        }
+
+        std::suspend_never final_suspend() noexcept
+        {
+            return {};
+        }
+
+        void return_void() noexcept
+        {
+
+        }
+
+        void unhandled_exception() noexcept
+        {
+            std::terminate();
+        }
+
+        static void* operator new(size_t size)
+        {
+            return RecyclingMemory::allocate(size);
+        }
+
+        static void operator delete(void* pointer, size_t size) noexcept
+        {
+            RecyclingMemory::deallocate(pointer, size);
+        }
+    };
+};
+
+template<typename ResolveArgumentType, typename InitiatorType>
+class PromiseAwaiter
+{
+public:
+    typedef Promise<ResolveArgumentType> PromiseType;
+
+    PromiseAwaiter(boost::asio::io_service::strand& strand, InitiatorType initiator)
+        : strand_(strand)
+        , initiator_(std::move(initiator))
+    {
+
+    }
+
+    bool await_ready() const noexcept
+    {
+        return false;
+    }
+
+    void await_suspend(std::coroutine_handle<> handle)
+    {
+        auto promise = std::allocate_shared<PromiseType>(RecyclingAllocator<PromiseType>(), strand_, PromiseResolution::DISPATCH);
+        promise->then([this, handle](ResolveArgumentType argument) mutable {
+                result_.emplace(std::move(argument));
+                handle.resume();
+            },
+            [this, handle](const error::Error& e) mutable {
+                error_ = e;
+                handle.resume();
+            });
+
+        auto initiator(std::move(initiator_));
+        initiator(std::move(promise));
+    }
+
+    ResolveArgumentType await_resume()
+    {
+        if(error_ != error::ErrorCode::NONE)
+        {
+            throw error_;
+        }
+
+        return std::move(*result_);
+    }
+
+private:
+    boost::asio::io_service::strand& strand_;
+    InitiatorType initiator_;
+    std::optional<ResolveArgumentType> result_;
+    error::Error error_;
+};
+
+template<typename InitiatorType>
+class PromiseAwaiter<void, InitiatorType>
+{
+public:
+    typedef Promise<void> PromiseType;
+
+    PromiseAwaiter(boost::asio::io_service::strand& strand, InitiatorType initiator)
+        : strand_(strand)
+        , initiator_(std::move(initiator))
+    {
+
+    }
+
+    bool await_ready() const noexcept
+    {
+        return false;
+    }
+
+    void await_suspend(std::coroutine_handle<> handle)
+    {
+        auto promise = std::allocate_shared<PromiseType>(RecyclingAllocator<PromiseType>(), strand_, PromiseResolution::DISPATCH);
+        promise->then([handle]() mutable {
+                handle.resume();
+            },
+            [this, handle](const error::Error& e) mutable {
+                error_ = e;
+                handle.resume();
+            });
+
+        auto initiator(std::move(initiator_));
+        initiator(std::move(promise));
+    }
+
+    void await_resume()
+    {
+        if(error_ != error::ErrorCode::NONE)
+        {
+            throw error_;
+        }
+    }
+
+private:
+    boost::asio::io_service::strand& strand_;
+    InitiatorType initiator_;
+    error::Error error_;
+};
+
+template<typename ResolveArgumentType, typename InitiatorType>
+PromiseAwaiter<ResolveArgumentType, InitiatorType> async(boost::asio::io_service::strand& strand, InitiatorType initiator)
+{
+    return PromiseAwaiter<ResolveArgumentType, InitiatorType>(strand, std::move(initiator));
+}
+
+}
+}
+}
+
+#endif
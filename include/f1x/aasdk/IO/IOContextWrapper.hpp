@@ -63,6 +63,7 @@ public:
 
     void reset();
     bool isActive() const;
+    bool isRunningInThisThread() const;
 
 private:
     boost::asio::io_service* ioService_;
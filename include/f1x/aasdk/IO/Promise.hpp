@@ -18,11 +18,15 @@
 
 #pragma once
 
-#include <functional>
+#include <atomic>
+#include <memory>
+#include <thread>
 #include <boost/core/noncopyable.hpp>
 #include <boost/asio.hpp>
 #include <f1x/aasdk/Error/Error.hpp>
 #include <f1x/aasdk/IO/IOContextWrapper.hpp>
+#include <f1x/aasdk/IO/PromiseAllocator.hpp>
+#include <f1x/aasdk/IO/PromiseHandler.hpp>
 
 namespace f1x
 {
@@ -31,331 +35,291 @@ namespace aasdk
 namespace io
 {
 
-template<typename ResolveArgumentType, typename ErrorArgumentType = error::Error>
-class Promise: boost::noncopyable
+enum class PromiseResolution
 {
-public:
-    typedef ResolveArgumentType ValueType;
-    typedef ErrorArgumentType ErrorType;
-    typedef std::function<void(ResolveArgumentType)> ResolveHandler;
-    typedef std::function<void(ErrorArgumentType)> RejectHandler;
-    typedef std::shared_ptr<Promise> Pointer;
+    POST,
+    DISPATCH
+};
 
-    static Pointer defer(boost::asio::io_service& ioService)
+class PromiseDispatchDepth
+{
+public:
+    PromiseDispatchDepth() noexcept
     {
-        return std::make_shared<Promise>(ioService);
+        ++PromiseDispatchDepth::get();
     }
 
-    static Pointer defer(boost::asio::io_service::strand& strand)
+    ~PromiseDispatchDepth()
     {
-        return std::make_shared<Promise>(strand);
+        --PromiseDispatchDepth::get();
     }
 
-    Promise(boost::asio::io_service& ioService)
-        : ioContextWrapper_(ioService)
-    {
+    PromiseDispatchDepth(const PromiseDispatchDepth&) = delete;
+    PromiseDispatchDepth& operator=(const PromiseDispatchDepth&) = delete;
 
-    }
-
-    Promise(boost::asio::io_service::strand& strand)
-        : ioContextWrapper_(strand)
+    static bool isExceeded() noexcept
     {
-
-    }
-
-    void then(ResolveHandler resolveHandler, RejectHandler rejectHandler = RejectHandler())
-    {
-        std::lock_guard<decltype(mutex_)> lock(mutex_);
-
-        resolveHandler_ = std::move(resolveHandler);
-        rejectHandler_ = std::move(rejectHandler);
-    }
-
-    void resolve(ResolveArgumentType argument)
-    {
-        std::lock_guard<decltype(mutex_)> lock(mutex_);
-
-        if(resolveHandler_ != nullptr && this->isPending())
-        {
-            ioContextWrapper_.post([argument = std::move(argument), resolveHandler = std::move(resolveHandler_)]() mutable {
-                resolveHandler(std::move(argument));
-            });
-        }
-
-        ioContextWrapper_.reset();
-        rejectHandler_ = RejectHandler();
-    }
-
-    void reject(ErrorArgumentType error)
-    {
-        std::lock_guard<decltype(mutex_)> lock(mutex_);
-
-        if(rejectHandler_ != nullptr && this->isPending())
-        {
-            ioContextWrapper_.post([error = std::move(error), rejectHandler = std::move(rejectHandler_)]() mutable {
-                rejectHandler(std::move(error));
-            });
-        }
-
-        ioContextWrapper_.reset();
-        resolveHandler_ = ResolveHandler();
+        return PromiseDispatchDepth::get() >= cMaxDepth;
     }
 
 private:
-    bool isPending() const
+    static size_t& get() noexcept
     {
-        return ioContextWrapper_.isActive();
+        static thread_local size_t depth = 0;
+        return depth;
     }
 
-    ResolveHandler resolveHandler_;
-    RejectHandler rejectHandler_;
-    IOContextWrapper ioContextWrapper_;
-    std::mutex mutex_;
+    static constexpr size_t cMaxDepth = 16;
 };
 
-template<typename ErrorArgumentType>
-class Promise<void, ErrorArgumentType>: boost::noncopyable
+template<typename PromiseType, typename ResolveHandlerType, typename RejectHandlerType>
+class PromiseBase: public std::enable_shared_from_this<PromiseType>, boost::noncopyable
 {
 public:
-    typedef ErrorArgumentType ErrorType;
-    typedef std::function<void()> ResolveHandler;
-    typedef std::function<void(ErrorArgumentType)> RejectHandler;
-    typedef std::shared_ptr<Promise> Pointer;
+    // Copyable handler types for callers that keep handlers around; then() also takes move-only functors.
+    typedef typename ResolveHandlerType::Function ResolveHandler;
+    typedef typename RejectHandlerType::Function RejectHandler;
+    typedef std::shared_ptr<PromiseType> Pointer;
 
-    static Pointer defer(boost::asio::io_service& ioService)
+    static Pointer defer(boost::asio::io_service& ioService, PromiseResolution resolution = PromiseResolution::POST)
     {
-        return std::make_shared<Promise>(ioService);
+        return std::make_shared<PromiseType>(ioService, resolution);
     }
 
-    static Pointer defer(boost::asio::io_service::strand& strand)
+    static Pointer defer(boost::asio::io_service::strand& strand, PromiseResolution resolution = PromiseResolution::POST)
     {
-        return std::make_shared<Promise>(strand);
+        return std::make_shared<PromiseType>(strand, resolution);
     }
 
-    Promise(boost::asio::io_service& ioService)
+    PromiseBase(boost::asio::io_service& ioService, PromiseResolution resolution = PromiseResolution::POST)
         : ioContextWrapper_(ioService)
+        , resolution_(resolution)
+        , state_(State::PENDING)
     {
 
     }
 
-    Promise(boost::asio::io_service::strand& strand)
+    PromiseBase(boost::asio::io_service::strand& strand, PromiseResolution resolution = PromiseResolution::POST)
         : ioContextWrapper_(strand)
+        , resolution_(resolution)
+        , state_(State::PENDING)
     {
 
     }
 
-    void then(ResolveHandler resolveHandler, RejectHandler rejectHandler = RejectHandler())
+    template<typename ResolveFunctorType, typename RejectFunctorType = RejectHandler>
+    void then(ResolveFunctorType&& resolveHandler, RejectFunctorType&& rejectHandler = RejectFunctorType())
     {
-        std::lock_guard<decltype(mutex_)> lock(mutex_);
+        auto state = state_.load(std::memory_order_acquire);
+
+        do
+        {
+            if(state == State::COMPLETED)
+            {
+                return;
+            }
+            else if(state == State::BUSY)
+            {
+                std::this_thread::yield();
+                state = state_.load(std::memory_order_acquire);
+            }
+        }
+        while(state == State::BUSY || !state_.compare_exchange_weak(state, State::BUSY, std::memory_order_acquire));
 
-        resolveHandler_ = std::move(resolveHandler);
-        rejectHandler_ = std::move(rejectHandler);
+        resolveHandler_ = ResolveHandlerType(std::forward<ResolveFunctorType>(resolveHandler));
+        rejectHandler_ = RejectHandlerType(std::forward<RejectFunctorType>(rejectHandler));
+        state_.store(State::HANDLERS_SET, std::memory_order_release);
     }
 
-    void resolve()
+protected:
+    template<typename HandlerType, typename OtherHandlerType>
+    void complete(HandlerType& handler, OtherHandlerType& otherHandler)
     {
-        std::lock_guard<decltype(mutex_)> lock(mutex_);
+        if(!this->acquire(handler, otherHandler))
+        {
+            return;
+        }
 
-        if(resolveHandler_ != nullptr && this->isPending())
+        if(this->canDispatch())
         {
-            ioContextWrapper_.post([resolveHandler = std::move(resolveHandler_)]() mutable {
-                resolveHandler();
+            this->dispatch(handler);
+        }
+        else
+        {
+            this->post([self = this->shared_from_this(), &handler]() mutable {
+                handler();
+                handler.reset();
             });
         }
-
-        ioContextWrapper_.reset();
-        rejectHandler_ = RejectHandler();
     }
 
-    void reject(ErrorArgumentType error)
+    template<typename HandlerType, typename OtherHandlerType, typename ArgumentType>
+    void complete(HandlerType& handler, OtherHandlerType& otherHandler, ArgumentType&& argument)
     {
-        std::lock_guard<decltype(mutex_)> lock(mutex_);
+        if(!this->acquire(handler, otherHandler))
+        {
+            return;
+        }
 
-        if(rejectHandler_ != nullptr && this->isPending())
+        if(this->canDispatch())
+        {
+            this->dispatch(handler, std::forward<ArgumentType>(argument));
+        }
+        else
         {
-            ioContextWrapper_.post([error = std::move(error), rejectHandler = std::move(rejectHandler_)]() mutable {
-                rejectHandler(std::move(error));
+            this->post([self = this->shared_from_this(), &handler, argument = std::forward<ArgumentType>(argument)]() mutable {
+                handler(std::move(argument));
+                handler.reset();
             });
         }
-
-        ioContextWrapper_.reset();
-        resolveHandler_ = ResolveHandler();
     }
 
+    ResolveHandlerType resolveHandler_;
+    RejectHandlerType rejectHandler_;
+
 private:
-    bool isPending() const
+    enum class State
     {
-        return ioContextWrapper_.isActive();
-    }
-
-    ResolveHandler resolveHandler_;
-    RejectHandler rejectHandler_;
-    IOContextWrapper ioContextWrapper_;
-    std::mutex mutex_;
-};
-
-template<>
-class Promise<void, void>: boost::noncopyable
-{
-public:
-    typedef std::function<void()> ResolveHandler;
-    typedef std::function<void()> RejectHandler;
-    typedef std::shared_ptr<Promise> Pointer;
+        PENDING,
+        BUSY,
+        HANDLERS_SET,
+        COMPLETED
+    };
 
-    static Pointer defer(boost::asio::io_service& ioService)
+    template<typename HandlerType, typename OtherHandlerType>
+    bool acquire(HandlerType& handler, OtherHandlerType& otherHandler)
     {
-        return std::make_shared<Promise>(ioService);
-    }
+        auto state = state_.load(std::memory_order_acquire);
 
-    static Pointer defer(boost::asio::io_service::strand& strand)
-    {
-        return std::make_shared<Promise>(strand);
-    }
+        do
+        {
+            if(state == State::COMPLETED)
+            {
+                return false;
+            }
+            else if(state == State::BUSY)
+            {
+                std::this_thread::yield();
+                state = state_.load(std::memory_order_acquire);
+            }
+        }
+        while(state == State::BUSY || !state_.compare_exchange_weak(state, State::COMPLETED, std::memory_order_acquire));
 
-    Promise(boost::asio::io_service& ioService)
-        : ioContextWrapper_(ioService)
-    {
+        otherHandler.reset();
 
-    }
-
-    Promise(boost::asio::io_service::strand& strand)
-        : ioContextWrapper_(strand)
-    {
+        if(state != State::HANDLERS_SET || !handler)
+        {
+            handler.reset();
+            ioContextWrapper_.reset();
+            return false;
+        }
 
+        return true;
     }
 
-    void then(ResolveHandler resolveHandler, RejectHandler rejectHandler = RejectHandler())
+    bool canDispatch() const
     {
-        std::lock_guard<decltype(mutex_)> lock(mutex_);
-
-        resolveHandler_ = std::move(resolveHandler);
-        rejectHandler_ = std::move(rejectHandler);
+        return resolution_ == PromiseResolution::DISPATCH && !PromiseDispatchDepth::isExceeded() && ioContextWrapper_.isRunningInThisThread();
     }
 
-    void resolve()
+    template<typename HandlerType, typename... ArgumentsType>
+    void dispatch(HandlerType& handler, ArgumentsType&&... arguments)
     {
-        std::lock_guard<decltype(mutex_)> lock(mutex_);
-
-        if(resolveHandler_ != nullptr && this->isPending())
-        {
-            ioContextWrapper_.post([resolveHandler = std::move(resolveHandler_)]() mutable {
-                resolveHandler();
-            });
-        }
-
         ioContextWrapper_.reset();
-        rejectHandler_ = RejectHandler();
-    }
 
-    void reject()
-    {
-        std::lock_guard<decltype(mutex_)> lock(mutex_);
-
-        if(rejectHandler_ != nullptr && this->isPending())
-        {
-            ioContextWrapper_.post([rejectHandler = std::move(rejectHandler_)]() mutable {
-                rejectHandler();
-            });
-        }
-
-        ioContextWrapper_.reset();
-        resolveHandler_ = ResolveHandler();
+        PromiseDispatchDepth depth;
+        auto dispatchedHandler(std::move(handler));
+        dispatchedHandler(std::forward<ArgumentsType>(arguments)...);
     }
 
-private:
-    bool isPending() const
+    template<typename FunctorType>
+    void post(FunctorType&& functor)
     {
-        return ioContextWrapper_.isActive();
+        ioContextWrapper_.post(PromiseAllocatedHandler<typename std::decay<FunctorType>::type>(std::forward<FunctorType>(functor), allocationStorage_));
+        ioContextWrapper_.reset();
     }
 
-    ResolveHandler resolveHandler_;
-    RejectHandler rejectHandler_;
     IOContextWrapper ioContextWrapper_;
-    std::mutex mutex_;
+    PromiseResolution resolution_;
+    std::atomic<State> state_;
+    PromiseAllocationStorage allocationStorage_;
 };
 
-template<typename ResolveArgumentType>
-class Promise<ResolveArgumentType, void>: boost::noncopyable
+template<typename ResolveArgumentType, typename ErrorArgumentType = error::Error>
+class Promise: public PromiseBase<Promise<ResolveArgumentType, ErrorArgumentType>, PromiseHandler<void(ResolveArgumentType)>, PromiseHandler<void(ErrorArgumentType)>>
 {
 public:
     typedef ResolveArgumentType ValueType;
-    typedef std::function<void(ResolveArgumentType)> ResolveHandler;
-    typedef std::function<void(void)> RejectHandler;
-    typedef std::shared_ptr<Promise> Pointer;
+    typedef ErrorArgumentType ErrorType;
 
-    static Pointer defer(boost::asio::io_service& ioService)
-    {
-        return std::make_shared<Promise>(ioService);
-    }
+    using PromiseBase<Promise, PromiseHandler<void(ResolveArgumentType)>, PromiseHandler<void(ErrorArgumentType)>>::PromiseBase;
 
-    static Pointer defer(boost::asio::io_service::strand& strand)
+    void resolve(ResolveArgumentType argument)
     {
-        return std::make_shared<Promise>(strand);
+        this->complete(this->resolveHandler_, this->rejectHandler_, std::move(argument));
     }
 
-    Promise(boost::asio::io_service& ioService)
-        : ioContextWrapper_(ioService)
+    void reject(ErrorArgumentType error)
     {
-
+        this->complete(this->rejectHandler_, this->resolveHandler_, std::move(error));
     }
+};
 
-    Promise(boost::asio::io_service::strand& strand)
-        : ioContextWrapper_(strand)
-    {
+template<typename ErrorArgumentType>
+class Promise<void, ErrorArgumentType>: public PromiseBase<Promise<void, ErrorArgumentType>, PromiseHandler<void()>, PromiseHandler<void(ErrorArgumentType)>>
+{
+public:
+    typedef ErrorArgumentType ErrorType;
 
-    }
+    using PromiseBase<Promise, PromiseHandler<void()>, PromiseHandler<void(ErrorArgumentType)>>::PromiseBase;
 
-    void then(ResolveHandler resolveHandler, RejectHandler rejectHandler = RejectHandler())
+    void resolve()
     {
-        std::lock_guard<decltype(mutex_)> lock(mutex_);
-
-        resolveHandler_ = std::move(resolveHandler);
-        rejectHandler_ = std::move(rejectHandler);
+        this->complete(this->resolveHandler_, this->rejectHandler_);
     }
 
-    void resolve(ResolveArgumentType argument)
+    void reject(ErrorArgumentType error)
     {
-        std::lock_guard<decltype(mutex_)> lock(mutex_);
+        this->complete(this->rejectHandler_, this->resolveHandler_, std::move(error));
+    }
+};
 
-        if(resolveHandler_ != nullptr && this->isPending())
-        {
-            ioContextWrapper_.post([argument = std::move(argument), resolveHandler = std::move(resolveHandler_)]() mutable {
-                resolveHandler(std::move(argument));
-            });
-        }
+template<>
+class Promise<void, void>: public PromiseBase<Promise<void, void>, PromiseHandler<void()>, PromiseHandler<void()>>
+{
+public:
+    using PromiseBase<Promise, PromiseHandler<void()>, PromiseHandler<void()>>::PromiseBase;
 
-        ioContextWrapper_.reset();
-        rejectHandler_ = RejectHandler();
+    void resolve()
+    {
+        this->complete(this->resolveHandler_, this->rejectHandler_);
     }
 
     void reject()
     {
-        std::lock_guard<decltype(mutex_)> lock(mutex_);
+        this->complete(this->rejectHandler_, this->resolveHandler_);
+    }
+};
 
-        if(rejectHandler_ != nullptr && this->isPending())
-        {
-            ioContextWrapper_.post([rejectHandler = std::move(rejectHandler_)]() mutable {
-                rejectHandler();
-            });
-        }
+template<typename ResolveArgumentType>
+class Promise<ResolveArgumentType, void>: public PromiseBase<Promise<ResolveArgumentType, void>, PromiseHandler<void(ResolveArgumentType)>, PromiseHandler<void()>>
+{
+public:
+    typedef ResolveArgumentType ValueType;
 
-        ioContextWrapper_.reset();
-        resolveHandler_ = ResolveHandler();
-    }
+    using PromiseBase<Promise, PromiseHandler<void(ResolveArgumentType)>, PromiseHandler<void()>>::PromiseBase;
 
-private:
-    bool isPending() const
+    void resolve(ResolveArgumentType argument)
     {
-        return ioContextWrapper_.isActive();
+        this->complete(this->resolveHandler_, this->rejectHandler_, std::move(argument));
     }
 
-    ResolveHandler resolveHandler_;
-    RejectHandler rejectHandler_;
-    IOContextWrapper ioContextWrapper_;
-    std::mutex mutex_;
+    void reject()
+    {
+        this->complete(this->rejectHandler_, this->resolveHandler_);
+    }
 };
 
-
 }
 }
 }
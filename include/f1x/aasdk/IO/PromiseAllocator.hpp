@@ -0,0 +1,153 @@
+/*
+*  This file is part of aasdk library project.
+*  Copyright (C) 2018 f1x.studio (Michal Szwaj)
+*
+*  aasdk is free software: you can redistribute it and/or modify
+*  it under the terms of the GNU General Public License as published by
+*  the Free Software Foundation; either version 3 of the License, or
+*  (at your option) any later version.
+
+*  aasdk is distributed in the hope that it will be useful,
+*  but WITHOUT ANY WARRANTY; without even the implied warranty of
+*  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+*  GNU General Public License for more details.
+*
+*  You should have received a copy of the GNU General Public License
+*  along with aasdk. If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#pragma once
+
+#include <cstddef>
+#include <new>
+#include <type_traits>
+#include <utility>
+
+namespace f1x
+{
+namespace aasdk
+{
+namespace io
+{
+
+class PromiseAllocationStorage
+{
+public:
+    PromiseAllocationStorage() noexcept
+        : isUsed_(false)
+    {
+
+    }
+
+    PromiseAllocationStorage(const PromiseAllocationStorage&) = delete;
+    PromiseAllocationStorage& operator=(const PromiseAllocationStorage&) = delete;
+
+    void* allocate(size_t size)
+    {
+        if(!isUsed_ && size <= cSize)
+        {
+            isUsed_ = true;
+            return &buffer_;
+        }
+
+        return ::operator new(size);
+    }
+
+    void deallocate(void* pointer) noexcept
+    {
+        if(pointer == &buffer_)
+        {
+            isUsed_ = false;
+        }
+        else
+        {
+            ::operator delete(pointer);
+        }
+    }
+
+    static constexpr size_t cSize = 192;
+
+private:
+    typename std::aligned_storage<cSize, alignof(std::max_align_t)>::type buffer_;
+    bool isUsed_;
+};
+
+template<typename ValueType>
+class PromiseAllocator
+{
+public:
+    typedef ValueType value_type;
+
+    explicit PromiseAllocator(PromiseAllocationStorage& storage) noexcept
+        : storage_(&storage)
+    {
+
+    }
+
+    template<typename OtherValueType>
+    PromiseAllocator(const PromiseAllocator<OtherValueType>& other) noexcept
+        : storage_(other.storage_)
+    {
+
+    }
+
+    ValueType* allocate(size_t count)
+    {
+        return static_cast<ValueType*>(storage_->allocate(sizeof(ValueType) * count));
+    }
+
+    void deallocate(ValueType* pointer, size_t) noexcept
+    {
+        storage_->deallocate(pointer);
+    }
+
+    template<typename OtherValueType>
+    bool operator==(const PromiseAllocator<OtherValueType>& other) const noexcept
+    {
+        return storage_ == other.storage_;
+    }
+
+    template<typename OtherValueType>
+    bool operator!=(const PromiseAllocator<OtherValueType>& other) const noexcept
+    {
+        return storage_ != other.storage_;
+    }
+
+private:
+    template<typename OtherValueType>
+    friend class PromiseAllocator;
+
+    PromiseAllocationStorage* storage_;
+};
+
+template<typename HandlerType>
+class PromiseAllocatedHandler
+{
+public:
+    typedef PromiseAllocator<void> allocator_type;
+
+    PromiseAllocatedHandler(HandlerType handler, PromiseAllocationStorage& storage)
+        : handler_(std::move(handler))
+        , storage_(&storage)
+    {
+
+    }
+
+    void operator()()
+    {
+        handler_();
+    }
+
+    allocator_type get_allocator() const noexcept
+    {
+        return allocator_type(*storage_);
+    }
+
+private:
+    HandlerType handler_;
+    PromiseAllocationStorage* storage_;
+};
+
+}
+}
+}
@@ -0,0 +1,225 @@
+/*
+*  This file is part of aasdk library project.
+*  Copyright (C) 2018 f1x.studio (Michal Szwaj)
+*
+*  aasdk is free software: you can redistribute it and/or modify
+*  it under the terms of the GNU General Public License as published by
+*  the Free Software Foundation; either version 3 of the License, or
+*  (at your option) any later version.
+
+*  aasdk is distributed in the hope that it will be useful,
+*  but WITHOUT ANY WARRANTY; without even the implied warranty of
+*  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+*  GNU General Public License for more details.
+*
+*  You should have received a copy of the GNU General Public License
+*  along with aasdk. If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#pragma once
+
+#include <cstddef>
+#include <functional>
+#include <new>
+#include <type_traits>
+#include <utility>
+
+namespace f1x
+{
+namespace aasdk
+{
+namespace io
+{
+
+template<typename SignatureType>
+class PromiseHandler;
+
+template<typename... ArgumentsType>
+class PromiseHandler<void(ArgumentsType...)>
+{
+public:
+    typedef std::function<void(ArgumentsType...)> Function;
+
+    PromiseHandler() noexcept
+        : operations_(nullptr)
+    {
+
+    }
+
+    PromiseHandler(std::nullptr_t) noexcept
+        : operations_(nullptr)
+    {
+
+    }
+
+    template<typename FunctorType, typename = typename std::enable_if<!std::is_same<typename std::decay<FunctorType>::type, PromiseHandler>::value>::type>
+    PromiseHandler(FunctorType&& functor)
+        : operations_(nullptr)
+    {
+        typedef typename std::decay<FunctorType>::type StoredFunctorType;
+
+        if(!PromiseHandler::isEmpty(functor))
+        {
+            Operations<StoredFunctorType>::create(storage_, std::forward<FunctorType>(functor));
+            operations_ = &Operations<StoredFunctorType>::cTable;
+        }
+    }
+
+    PromiseHandler(PromiseHandler&& other) noexcept
+        : operations_(other.operations_)
+    {
+        if(operations_ != nullptr)
+        {
+            operations_->move(storage_, other.storage_);
+            other.operations_ = nullptr;
+        }
+    }
+
+    PromiseHandler& operator=(PromiseHandler&& other) noexcept
+    {
+        if(this != &other)
+        {
+            this->reset();
+
+            if(other.operations_ != nullptr)
+            {
+                other.operations_->move(storage_, other.storage_);
+                operations_ = other.operations_;
+                other.operations_ = nullptr;
+            }
+        }
+
+        return *this;
+    }
+
+    PromiseHandler(const PromiseHandler&) = delete;
+    PromiseHandler& operator=(const PromiseHandler&) = delete;
+
+    ~PromiseHandler()
+    {
+        this->reset();
+    }
+
+    void operator()(ArgumentsType... arguments)
+    {
+        operations_->invoke(storage_, std::forward<ArgumentsType>(arguments)...);
+    }
+
+    explicit operator bool() const noexcept
+    {
+        return operations_ != nullptr;
+    }
+
+    void reset() noexcept
+    {
+        if(operations_ != nullptr)
+        {
+            operations_->destroy(storage_);
+            operations_ = nullptr;
+        }
+    }
+
+    static constexpr size_t cInlineSize = 48;
+
+private:
+    typedef typename std::aligned_storage<cInlineSize, alignof(std::max_align_t)>::type Storage;
+
+    struct OperationsTable
+    {
+        void (*invoke)(Storage& storage, ArgumentsType&&... arguments);
+        void (*move)(Storage& destination, Storage& source) noexcept;
+        void (*destroy)(Storage& storage) noexcept;
+    };
+
+    template<typename FunctorType, bool IsInline = sizeof(FunctorType) <= cInlineSize && alignof(FunctorType) <= alignof(std::max_align_t)
+                                                   && std::is_nothrow_move_constructible<FunctorType>::value>
+    struct Operations
+    {
+        template<typename ArgumentType>
+        static void create(Storage& storage, ArgumentType&& functor)
+        {
+            new(&storage) FunctorType(std::forward<ArgumentType>(functor));
+        }
+
+        static void invoke(Storage& storage, ArgumentsType&&... arguments)
+        {
+            (*reinterpret_cast<FunctorType*>(&storage))(std::forward<ArgumentsType>(arguments)...);
+        }
+
+        static void move(Storage& destination, Storage& source) noexcept
+        {
+            new(&destination) FunctorType(std::move(*reinterpret_cast<FunctorType*>(&source)));
+            reinterpret_cast<FunctorType*>(&source)->~FunctorType();
+        }
+
+        static void destroy(Storage& storage) noexcept
+        {
+            reinterpret_cast<FunctorType*>(&storage)->~FunctorType();
+        }
+
+        static constexpr OperationsTable cTable{&invoke, &move, &destroy};
+    };
+
+    template<typename FunctorType>
+    struct Operations<FunctorType, false>
+    {
+        template<typename ArgumentType>
+        static void create(Storage& storage, ArgumentType&& functor)
+        {
+            *reinterpret_cast<FunctorType**>(&storage) = new FunctorType(std::forward<ArgumentType>(functor));
+        }
+
+        static void invoke(Storage& storage, ArgumentsType&&... arguments)
+        {
+            (**reinterpret_cast<FunctorType**>(&storage))(std::forward<ArgumentsType>(arguments)...);
+        }
+
+        static void move(Storage& destination, Storage& source) noexcept
+        {
+            *reinterpret_cast<FunctorType**>(&destination) = *reinterpret_cast<FunctorType**>(&source);
+        }
+
+        static void destroy(Storage& storage) noexcept
+        {
+            delete *reinterpret_cast<FunctorType**>(&storage);
+        }
+
+        static constexpr OperationsTable cTable{&invoke, &move, &destroy};
+    };
+
+    template<typename SignatureType>
+    static bool isEmpty(const std::function<SignatureType>& functor)
+    {
+        return !functor;
+    }
+
+    template<typename ResultType, typename... FunctionArgumentsType>
+    static bool isEmpty(ResultType (*functor)(FunctionArgumentsType...))
+    {
+        return functor == nullptr;
+    }
+
+    template<typename FunctorType>
+    static bool isEmpty(const FunctorType&)
+    {
+        return false;
+    }
+
+    Storage storage_;
+    const OperationsTable* operations_;
+};
+
+template<typename... ArgumentsType>
+constexpr size_t PromiseHandler<void(ArgumentsType...)>::cInlineSize;
+
+template<typename... ArgumentsType>
+template<typename FunctorType, bool IsInline>
+constexpr typename PromiseHandler<void(ArgumentsType...)>::OperationsTable PromiseHandler<void(ArgumentsType...)>::Operations<FunctorType, IsInline>::cTable;
+
+template<typename... ArgumentsType>
+template<typename FunctorType>
+constexpr typename PromiseHandler<void(ArgumentsType...)>::OperationsTable PromiseHandler<void(ArgumentsType...)>::Operations<FunctorType, false>::cTable;
+
+}
+}
+}
@@ -18,7 +18,6 @@
 
 #pragma once
 
-#include <memory>
 #include <functional>
 #include <f1x/aasdk/Error/Error.hpp>
 #include <f1x/aasdk/IO/Promise.hpp>
@@ -31,100 +30,46 @@ namespace io
 {
 
 template<typename SourceResolveArgumentType = void, typename DestinationResolveArgumentType = void>
-class PromiseLink: public std::enable_shared_from_this<PromiseLink<SourceResolveArgumentType, DestinationResolveArgumentType>>
+class PromiseLink
 {
 public:
-    typedef std::shared_ptr<PromiseLink<SourceResolveArgumentType, DestinationResolveArgumentType>> Pointer;
     typedef std::function<DestinationResolveArgumentType(SourceResolveArgumentType)> TransformFunctor;
 
-    PromiseLink(typename Promise<DestinationResolveArgumentType>::Pointer promise, TransformFunctor transformFunctor)
-        : promise_(std::move(promise))
-        , transformFunctor_(std::make_shared<TransformFunctor>(std::move(transformFunctor)))
+    static void forward(Promise<SourceResolveArgumentType>& source, typename Promise<DestinationResolveArgumentType>::Pointer destination)
     {
-
+        source.then([destination](SourceResolveArgumentType argument) {
+                destination->resolve(std::move(argument));
+            },
+            [destination](const error::Error& e) {
+                destination->reject(e);
+            });
     }
 
     static void forward(Promise<SourceResolveArgumentType>& source, typename Promise<DestinationResolveArgumentType>::Pointer destination,
-                        TransformFunctor transformFunctor = [](SourceResolveArgumentType&& argument) { return std::move(argument); })
-    {
-        auto link = std::make_shared<PromiseLink<SourceResolveArgumentType, DestinationResolveArgumentType>>(std::forward<typename Promise<DestinationResolveArgumentType>::Pointer>(destination),
-                                                                                                             std::forward<TransformFunctor>(transformFunctor));
-        source.then(link->getResolveHandler(), link->getRejectHandler());
-    }
-
-private:
-    using std::enable_shared_from_this<PromiseLink<SourceResolveArgumentType, DestinationResolveArgumentType>>::shared_from_this;
-
-    void resolve(SourceResolveArgumentType argument)
+                        TransformFunctor transformFunctor)
     {
-        if(transformFunctor_ != nullptr)
-        {
-            promise_->resolve((*transformFunctor_)(std::move(argument)));
-            transformFunctor_.reset();
-        }
+        source.then([destination, transformFunctor = std::move(transformFunctor)](SourceResolveArgumentType argument) {
+                destination->resolve(transformFunctor(std::move(argument)));
+            },
+            [destination](const error::Error& e) {
+                destination->reject(e);
+            });
     }
-
-    void reject(const error::Error& e)
-    {
-        promise_->reject(e);
-    }
-
-    typename Promise<SourceResolveArgumentType>::ResolveHandler getResolveHandler()
-    {
-        return std::bind(&PromiseLink::resolve, this->shared_from_this(), std::placeholders::_1);
-    }
-
-    typename Promise<SourceResolveArgumentType>::RejectHandler getRejectHandler()
-    {
-        return std::bind(&PromiseLink::reject, this->shared_from_this(), std::placeholders::_1);
-    }
-
-    typename Promise<DestinationResolveArgumentType>::Pointer promise_;
-    std::shared_ptr<TransformFunctor> transformFunctor_;
 };
 
 template<>
-class PromiseLink<void, void>: public std::enable_shared_from_this<PromiseLink<void, void>>
+class PromiseLink<void, void>
 {
 public:
-    typedef std::shared_ptr<PromiseLink<void, void>> Pointer;
-
-    PromiseLink(typename Promise<void>::Pointer promise)
-        : promise_(std::move(promise))
-    {
-
-    }
-
     static void forward(Promise<void>& source, typename Promise<void>::Pointer destination)
     {
-        auto link = std::make_shared<PromiseLink<void, void>>(std::forward<typename Promise<void>::Pointer>(destination));
-        source.then(link->getResolveHandler(), link->getRejectHandler());
+        source.then([destination]() {
+                destination->resolve();
+            },
+            [destination](const error::Error& e) {
+                destination->reject(e);
+            });
     }
-
-private:
-    using std::enable_shared_from_this<PromiseLink<void, void>>::shared_from_this;
-
-    void resolve()
-    {
-        promise_->resolve();
-    }
-
-    void reject(const error::Error& e)
-    {
-        promise_->reject(e);
-    }
-
-    Promise<void>::ResolveHandler getResolveHandler()
-    {
-        return std::bind(&PromiseLink::resolve, this->shared_from_this());
-    }
-
-    Promise<void>::RejectHandler getRejectHandler()
-    {
-        return std::bind(&PromiseLink::reject, this->shared_from_this(), std::placeholders::_1);
-    }
-
-    typename Promise<void>::Pointer promise_;
 };
 
 }
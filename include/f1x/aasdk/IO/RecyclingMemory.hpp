@@ -0,0 +1,97 @@
+/*
+*  This file is part of aasdk library project.
+*  Copyright (C) 2018 f1x.studio (Michal Szwaj)
+*
+*  aasdk is free software: you can redistribute it and/or modify
+*  it under the terms of the GNU General Public License as published by
+*  the Free Software Foundation; either version 3 of the License, or
+*  (at your option) any later version.
+
+*  aasdk is distributed in the hope that it will be useful,
+*  but WITHOUT ANY WARRANTY; without even the implied warranty of
+*  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+*  GNU General Public License for more details.
+*
+*  You should have received a copy of the GNU General Public License
+*  along with aasdk. If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#pragma once
+
+#include <cstddef>
+
+namespace f1x
+{
+namespace aasdk
+{
+namespace io
+{
+
+class RecyclingMemory
+{
+public:
+    static void* allocate(size_t size);
+    static void deallocate(void* pointer, size_t size) noexcept;
+
+private:
+    static constexpr size_t cGranularity = 64;
+    static constexpr size_t cSizeClassesCount = 16;
+    static constexpr size_t cMaxCachedBlocksCount = 16;
+
+    struct Cache
+    {
+        void* blocks[cSizeClassesCount][cMaxCachedBlocksCount];
+        size_t counts[cSizeClassesCount];
+        bool isClosed;
+    };
+
+    class CacheCleaner
+    {
+    public:
+        ~CacheCleaner();
+    };
+
+    static Cache& getCache() noexcept;
+    static size_t getSizeClass(size_t size) noexcept;
+};
+
+template<typename ValueType>
+class RecyclingAllocator
+{
+public:
+    typedef ValueType value_type;
+
+    RecyclingAllocator() noexcept = default;
+
+    template<typename OtherValueType>
+    RecyclingAllocator(const RecyclingAllocator<OtherValueType>&) noexcept
+    {
+
+    }
+
+    ValueType* allocate(size_t count)
+    {
+        return static_cast<ValueType*>(RecyclingMemory::allocate(sizeof(ValueType) * count));
+    }
+
+    void deallocate(ValueType* pointer, size_t count) noexcept
+    {
+        RecyclingMemory::deallocate(pointer, sizeof(ValueType) * count);
+    }
+
+    template<typename OtherValueType>
+    bool operator==(const RecyclingAllocator<OtherValueType>&) const noexcept
+    {
+        return true;
+    }
+
+    template<typename OtherValueType>
+    bool operator!=(const RecyclingAllocator<OtherValueType>&) const noexcept
+    {
+        return false;
+    }
+};
+
+}
+}
+}
@@ -0,0 +1,67 @@
+/*
+*  This file is part of aasdk library project.
+*  Copyright (C) 2018 f1x.studio (Michal Szwaj)
+*
+*  aasdk is free software: you can redistribute it and/or modify
+*  it under the terms of the GNU General Public License as published by
+*  the Free Software Foundation; either version 3 of the License, or
+*  (at your option) any later version.
+
+*  aasdk is distributed in the hope that it will be useful,
+*  but WITHOUT ANY WARRANTY; without even the implied warranty of
+*  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+*  GNU General Public License for more details.
+*
+*  You should have received a copy of the GNU General Public License
+*  along with aasdk. If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#pragma once
+
+#include <atomic>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+#include <boost/asio.hpp>
+#include <boost/noncopyable.hpp>
+#include <f1x/aasdk/IO/ThreadConfiguration.hpp>
+
+namespace f1x
+{
+namespace aasdk
+{
+namespace io
+{
+
+class Runtime: boost::noncopyable
+{
+public:
+    Runtime(size_t ioThreadsCount = 1, ThreadConfiguration ioThreadConfiguration = ThreadConfiguration("aasdk-io"),
+            size_t applicationThreadsCount = 1, ThreadConfiguration applicationThreadConfiguration = ThreadConfiguration("aasdk-app"));
+    ~Runtime();
+
+    boost::asio::io_service& getIOService();
+    boost::asio::io_service& getApplicationService();
+    void addIOThread(std::function<void()> eventLoop, std::function<void()> interrupt = nullptr);
+    void stop();
+
+private:
+    void startThread(const ThreadConfiguration& configuration, size_t index, std::function<void()> body);
+
+    boost::asio::io_service ioService_;
+    boost::asio::io_service applicationService_;
+    std::unique_ptr<boost::asio::io_service::work> ioWork_;
+    std::unique_ptr<boost::asio::io_service::work> applicationWork_;
+    ThreadConfiguration ioThreadConfiguration_;
+    size_t ioThreadsCount_;
+    std::vector<std::thread> threads_;
+    std::vector<std::function<void()>> interrupts_;
+    std::atomic<bool> isStopped_;
+    std::mutex mutex_;
+};
+
+}
+}
+}
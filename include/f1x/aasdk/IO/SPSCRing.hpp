@@ -0,0 +1,125 @@
+/*
+*  This file is part of aasdk library project.
+*  Copyright (C) 2018 f1x.studio (Michal Szwaj)
+*
+*  aasdk is free software: you can redistribute it and/or modify
+*  it under the terms of the GNU General Public License as published by
+*  the Free Software Foundation; either version 3 of the License, or
+*  (at your option) any later version.
+
+*  aasdk is distributed in the hope that it will be useful,
+*  but WITHOUT ANY WARRANTY; without even the implied warranty of
+*  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+*  GNU General Public License for more details.
+*
+*  You should have received a copy of the GNU General Public License
+*  along with aasdk. If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <vector>
+#include <boost/noncopyable.hpp>
+
+namespace f1x
+{
+namespace aasdk
+{
+namespace io
+{
+
+// Bounded lock-free queue for exactly one producer thread and one consumer thread.
+template<typename ValueType>
+class SPSCRing: boost::noncopyable
+{
+public:
+    explicit SPSCRing(size_t capacity)
+        : mask_(getCapacity(capacity) - 1)
+        , slots_(mask_ + 1)
+        , tail_(0)
+        , cachedHead_(0)
+        , head_(0)
+        , cachedTail_(0)
+    {
+
+    }
+
+    bool push(ValueType& value)
+    {
+        const auto tail = tail_.load(std::memory_order_relaxed);
+
+        if(tail - cachedHead_ > mask_)
+        {
+            cachedHead_ = head_.load(std::memory_order_acquire);
+
+            if(tail - cachedHead_ > mask_)
+            {
+                return false;
+            }
+        }
+
+        slots_[tail & mask_] = std::move(value);
+        tail_.store(tail + 1, std::memory_order_release);
+        return true;
+    }
+
+    bool pop(ValueType& value)
+    {
+        const auto head = head_.load(std::memory_order_relaxed);
+
+        if(head == cachedTail_)
+        {
+            cachedTail_ = tail_.load(std::memory_order_acquire);
+
+            if(head == cachedTail_)
+            {
+                return false;
+            }
+        }
+
+        value = std::move(slots_[head & mask_]);
+        slots_[head & mask_] = ValueType();
+        head_.store(head + 1, std::memory_order_release);
+        return true;
+    }
+
+    bool empty() const
+    {
+        return head_.load(std::memory_order_acquire) == tail_.load(std::memory_order_acquire);
+    }
+
+    size_t capacity() const
+    {
+        return mask_ + 1;
+    }
+
+private:
+    static size_t getCapacity(size_t capacity)
+    {
+        size_t result = 2;
+
+        while(result < capacity)
+        {
+            result <<= 1;
+        }
+
+        return result;
+    }
+
+    static constexpr size_t cCacheLineSize = 64;
+
+    const size_t mask_;
+    std::vector<ValueType> slots_;
+
+    alignas(cCacheLineSize) std::atomic<size_t> tail_;
+    size_t cachedHead_;
+
+    alignas(cCacheLineSize) std::atomic<size_t> head_;
+    size_t cachedTail_;
+};
+
+}
+}
+}
@@ -0,0 +1,48 @@
+/*
+*  This file is part of aasdk library project.
+*  Copyright (C) 2018 f1x.studio (Michal Szwaj)
+*
+*  aasdk is free software: you can redistribute it and/or modify
+*  it under the terms of the GNU General Public License as published by
+*  the Free Software Foundation; either version 3 of the License, or
+*  (at your option) any later version.
+
+*  aasdk is distributed in the hope that it will be useful,
+*  but WITHOUT ANY WARRANTY; without even the implied warranty of
+*  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+*  GNU General Public License for more details.
+*
+*  You should have received a copy of the GNU General Public License
+*  along with aasdk. If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#pragma once
+
+#include <sched.h>
+#include <cstddef>
+#include <string>
+#include <vector>
+
+namespace f1x
+{
+namespace aasdk
+{
+namespace io
+{
+
+struct ThreadConfiguration
+{
+    ThreadConfiguration(std::string _name = std::string(), std::vector<size_t> _cpus = std::vector<size_t>(),
+                        int _policy = SCHED_OTHER, int _priority = 0);
+
+    void apply(size_t index = 0) const;
+
+    std::string name;
+    std::vector<size_t> cpus;
+    int policy;
+    int priority;
+};
+
+}
+}
+}
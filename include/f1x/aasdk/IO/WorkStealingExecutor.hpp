@@ -0,0 +1,105 @@
+/*
+*  This file is part of aasdk library project.
+*  Copyright (C) 2018 f1x.studio (Michal Szwaj)
+*
+*  aasdk is free software: you can redistribute it and/or modify
+*  it under the terms of the GNU General Public License as published by
+*  the Free Software Foundation; either version 3 of the License, or
+*  (at your option) any later version.
+
+*  aasdk is distributed in the hope that it will be useful,
+*  but WITHOUT ANY WARRANTY; without even the implied warranty of
+*  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+*  GNU General Public License for more details.
+*
+*  You should have received a copy of the GNU General Public License
+*  along with aasdk. If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#pragma once
+
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+#include <boost/noncopyable.hpp>
+#include <f1x/aasdk/IO/PromiseHandler.hpp>
+#include <f1x/aasdk/IO/ThreadConfiguration.hpp>
+
+namespace f1x
+{
+namespace aasdk
+{
+namespace io
+{
+
+class WorkStealingExecutor: boost::noncopyable
+{
+public:
+    typedef std::shared_ptr<WorkStealingExecutor> Pointer;
+    typedef PromiseHandler<void()> Task;
+
+    class Strand: public std::enable_shared_from_this<Strand>, boost::noncopyable
+    {
+    public:
+        typedef std::shared_ptr<Strand> Pointer;
+
+        Strand(WorkStealingExecutor& executor);
+
+        void post(Task task);
+        bool isRunningInThisThread() const;
+
+    private:
+        void run();
+
+        WorkStealingExecutor& executor_;
+        std::mutex mutex_;
+        std::deque<Task> tasks_;
+        bool isScheduled_;
+        std::atomic<std::thread::id> runningThreadId_;
+
+        static constexpr size_t cMaxBatchSize = 16;
+    };
+
+    explicit WorkStealingExecutor(size_t threadsCount = std::thread::hardware_concurrency(),
+                                  ThreadConfiguration threadConfiguration = ThreadConfiguration("aasdk-exec"));
+    ~WorkStealingExecutor();
+
+    void post(Task task);
+    Strand::Pointer createStrand();
+    size_t getThreadsCount() const;
+    size_t getStolenCount() const;
+
+private:
+    struct Worker
+    {
+        std::mutex mutex;
+        std::deque<Task> tasks;
+    };
+
+    void run(size_t index);
+    bool pop(size_t index, Task& task);
+    bool steal(size_t index, Task& task);
+    void wait();
+    static void execute(Task& task);
+
+    std::vector<std::unique_ptr<Worker>> workers_;
+    std::vector<std::thread> threads_;
+    std::atomic<size_t> nextWorker_;
+    std::atomic<size_t> pendingCount_;
+    std::atomic<size_t> sleepingCount_;
+    std::atomic<size_t> stolenCount_;
+    std::atomic<bool> isStopped_;
+    std::mutex idleMutex_;
+    std::condition_variable idleCondition_;
+
+    static thread_local WorkStealingExecutor* currentExecutor_;
+    static thread_local size_t currentWorker_;
+};
+
+}
+}
+}
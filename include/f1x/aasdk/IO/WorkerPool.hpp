@@ -0,0 +1,58 @@
+/*
+*  This file is part of aasdk library project.
+*  Copyright (C) 2018 f1x.studio (Michal Szwaj)
+*
+*  aasdk is free software: you can redistribute it and/or modify
+*  it under the terms of the GNU General Public License as published by
+*  the Free Software Foundation; either version 3 of the License, or
+*  (at your option) any later version.
+
+*  aasdk is distributed in the hope that it will be useful,
+*  but WITHOUT ANY WARRANTY; without even the implied warranty of
+*  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+*  GNU General Public License for more details.
+*
+*  You should have received a copy of the GNU General Public License
+*  along with aasdk. If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#pragma once
+
+#include <boost/asio.hpp>
+#include <boost/noncopyable.hpp>
+#include <memory>
+#include <thread>
+#include <vector>
+
+namespace f1x
+{
+namespace aasdk
+{
+namespace io
+{
+
+class WorkerPool: boost::noncopyable
+{
+public:
+    typedef std::shared_ptr<WorkerPool> Pointer;
+
+    explicit WorkerPool(size_t threadsCount = std::thread::hardware_concurrency());
+    ~WorkerPool();
+
+    template<typename CompletionHandlerType>
+    void post(CompletionHandlerType&& handler)
+    {
+        ioService_.post(std::forward<CompletionHandlerType>(handler));
+    }
+
+    size_t getThreadsCount() const;
+
+private:
+    boost::asio::io_service ioService_;
+    std::unique_ptr<boost::asio::io_service::work> work_;
+    std::vector<std::thread> threads_;
+};
+
+}
+}
+}
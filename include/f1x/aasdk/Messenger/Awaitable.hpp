@@ -0,0 +1,51 @@
+/*
+*  This file is part of aasdk library project.
+*  Copyright (C) 2018 f1x.studio (Michal Szwaj)
+*
+*  aasdk is free software: you can redistribute it and/or modify
+*  it under the terms of the GNU General Public License as published by
+*  the Free Software Foundation; either version 3 of the License, or
+*  (at your option) any later version.
+
+*  aasdk is distributed in the hope that it will be useful,
+*  but WITHOUT ANY WARRANTY; without even the implied warranty of
+*  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+*  GNU General Public License for more details.
+*
+*  You should have received a copy of the GNU General Public License
+*  along with aasdk. If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#pragma once
+
+#if defined(__cpp_impl_coroutine)
+
+#include <f1x/aasdk/IO/Awaitable.hpp>
+#include <f1x/aasdk/Messenger/IMessenger.hpp>
+
+namespace f1x
+{
+namespace aasdk
+{
+namespace messenger
+{
+
+inline auto asyncReceive(IMessenger::Pointer messenger, ChannelId channelId, boost::asio::io_service::strand& strand)
+{
+    return io::async<Message::Pointer>(strand, [messenger = std::move(messenger), channelId](ReceivePromise::Pointer promise) {
+        messenger->enqueueReceive(channelId, std::move(promise));
+    });
+}
+
+inline auto asyncSend(IMessenger::Pointer messenger, Message::Pointer message, boost::asio::io_service::strand& strand)
+{
+    return io::async<void>(strand, [messenger = std::move(messenger), message = std::move(message)](SendPromise::Pointer promise) mutable {
+        messenger->enqueueSend(std::move(message), std::move(promise));
+    });
+}
+
+}
+}
+}
+
+#endif
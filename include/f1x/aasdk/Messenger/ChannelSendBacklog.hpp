@@ -0,0 +1,65 @@
+/*
+*  This file is part of aasdk library project.
+*  Copyright (C) 2018 f1x.studio (Michal Szwaj)
+*
+*  aasdk is free software: you can redistribute it and/or modify
+*  it under the terms of the GNU General Public License as published by
+*  the Free Software Foundation; either version 3 of the License, or
+*  (at your option) any later version.
+
+*  aasdk is distributed in the hope that it will be useful,
+*  but WITHOUT ANY WARRANTY; without even the implied warranty of
+*  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+*  GNU General Public License for more details.
+*
+*  You should have received a copy of the GNU General Public License
+*  along with aasdk. If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#pragma once
+
+#include <queue>
+#include <unordered_map>
+#include <f1x/aasdk/Messenger/ChannelId.hpp>
+#include <f1x/aasdk/Messenger/Promise.hpp>
+#include <f1x/aasdk/Messenger/SendWatermarks.hpp>
+
+namespace f1x
+{
+namespace aasdk
+{
+namespace messenger
+{
+
+class ChannelSendBacklog
+{
+public:
+    void setWatermarks(ChannelId channelId, const SendWatermarks& watermarks);
+    void push(ChannelId channelId, size_t size);
+    void pop(ChannelId channelId, size_t size);
+    bool isWritable(ChannelId channelId) const;
+    size_t getQueuedBytes(ChannelId channelId) const;
+    size_t getQueuedMessages(ChannelId channelId) const;
+    void enqueueWritable(ChannelId channelId, SendPromise::Pointer promise);
+    void reject(const error::Error& e);
+
+private:
+    struct ChannelState
+    {
+        ChannelState();
+
+        SendWatermarks watermarks;
+        size_t queuedBytes;
+        size_t queuedMessages;
+        bool writable;
+        std::queue<SendPromise::Pointer> writablePromises;
+    };
+
+    void update(ChannelState& state);
+
+    std::unordered_map<ChannelId, ChannelState> channels_;
+};
+
+}
+}
+}
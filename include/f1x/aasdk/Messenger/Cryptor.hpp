@@ -18,9 +18,14 @@
 
 #pragma once
 
+#include <atomic>
+#include <memory>
 #include <mutex>
 #include <f1x/aasdk/Transport/ISSLWrapper.hpp>
 #include <f1x/aasdk/Messenger/ICryptor.hpp>
+#include <f1x/aasdk/Messenger/CryptorContext.hpp>
+#include <f1x/aasdk/Messenger/CryptorOptions.hpp>
+#include <f1x/aasdk/Messenger/RecordLayer.hpp>
 
 namespace f1x
 {
@@ -32,34 +37,62 @@ namespace messenger
 class Cryptor: public ICryptor
 {
 public:
-    Cryptor(transport::ISSLWrapper::Pointer sslWrapper);
+    Cryptor(transport::ISSLWrapper::Pointer sslWrapper, CryptorOptions options = CryptorOptions());
 
     void init() override;
     void deinit() override;
     bool doHandshake() override;
     size_t encrypt(common::Data& output, const common::DataConstBuffer& buffer) override;
+    size_t encrypt(common::Data& output, const common::DataConstBuffer& buffer, error::Error& e) noexcept override;
+    void encryptBatch(std::vector<common::Data>& outputs, const std::vector<common::DataConstBuffer>& buffers) override;
+    void encryptBatch(std::vector<common::Data>& outputs, const std::vector<common::DataConstBuffer>& buffers, error::Error& e) noexcept override;
     size_t decrypt(common::Data& output, const common::DataConstBuffer& buffer) override;
+    size_t decrypt(common::Data& output, const common::DataConstBuffer& buffer, error::Error& e) noexcept override;
+    DecryptTask prepareDecrypt(const common::DataConstBuffer& buffer, size_t& plaintextSize) override;
 
     common::Data readHandshakeBuffer() override;
     void writeHandshakeBuffer(const common::DataConstBuffer& buffer) override;
     bool isActive() const override;
+    void setSessionKey(const std::string& sessionKey) override;
+    HandshakeMetrics getHandshakeMetrics() const override;
+    bool hasRecordLayer() const;
+
+    static CryptorContext::Pointer getSharedContext(transport::ISSLWrapper::Pointer sslWrapper);
 
 private:
     size_t read(common::Data& output);
-    void write(const common::DataConstBuffer& buffer);
+    size_t read(common::Data& output, error::Error& e);
+    size_t writeRecords(common::Data& output, const common::DataConstBuffer& buffer, error::Error& e);
+    void write(const common::DataConstBuffer& buffer, error::Error& e) noexcept;
+    void createRecordLayer();
+    void storeSession();
+    const std::string& getFastestCipherList() const;
 
     transport::ISSLWrapper::Pointer sslWrapper_;
     size_t maxBufferSize_;
-    X509* certificate_;
-    EVP_PKEY* privateKey_;
-    SSL_CTX* context_;
+    CryptorContext::Pointer cryptorContext_;
     SSL* ssl_;
     transport::ISSLWrapper::BIOs bIOs_;
-    bool isActive_;
+    std::atomic<bool> isActive_;
+    CryptorOptions options_;
+    std::shared_ptr<RecordLayer> recordLayer_;
+    bool hasPendingOutput_;
+    std::string sessionKey_;
+    HandshakeMetrics handshakeMetrics_;
 
     const static std::string cCertificate;
     const static std::string cPrivateKey;
+    const static std::string cAESCipherList;
+    const static std::string cChaChaCipherList;
+    static constexpr size_t cRecordHeaderSize = 5;
+    static constexpr size_t cMaxRecordSize = 16384;
+    static constexpr size_t cMaxRecordIVSize = 16;
+    static constexpr size_t cMaxRecordPaddingAndMACSize = 48;
+    static constexpr size_t cMaxRecordTagSize = 16;
+    static constexpr size_t cMaxRecordOverhead = cRecordHeaderSize + cMaxRecordIVSize + cMaxRecordPaddingAndMACSize + cMaxRecordTagSize;
     mutable std::mutex mutex_;
+    mutable std::mutex encryptMutex_;
+    mutable std::mutex decryptMutex_;
 };
 
 }
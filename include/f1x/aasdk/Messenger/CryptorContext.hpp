@@ -0,0 +1,67 @@
+/*
+*  This file is part of aasdk library project.
+*  Copyright (C) 2018 f1x.studio (Michal Szwaj)
+*
+*  aasdk is free software: you can redistribute it and/or modify
+*  it under the terms of the GNU General Public License as published by
+*  the Free Software Foundation; either version 3 of the License, or
+*  (at your option) any later version.
+
+*  aasdk is distributed in the hope that it will be useful,
+*  but WITHOUT ANY WARRANTY; without even the implied warranty of
+*  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+*  GNU General Public License for more details.
+*
+*  You should have received a copy of the GNU General Public License
+*  along with aasdk. If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#pragma once
+
+#include <list>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <boost/noncopyable.hpp>
+#include <f1x/aasdk/Transport/ISSLWrapper.hpp>
+
+namespace f1x
+{
+namespace aasdk
+{
+namespace messenger
+{
+
+class CryptorContext: boost::noncopyable
+{
+public:
+    typedef std::shared_ptr<CryptorContext> Pointer;
+
+    CryptorContext(transport::ISSLWrapper::Pointer sslWrapper, const std::string& certificate, const std::string& privateKey);
+    ~CryptorContext();
+
+    SSL_CTX* getContext() const;
+    void storeSession(const std::string& sessionKey, SSL* ssl);
+    bool resumeSession(const std::string& sessionKey, SSL* ssl);
+
+    static Pointer getShared(transport::ISSLWrapper::Pointer sslWrapper, const std::string& certificate, const std::string& privateKey);
+
+private:
+    typedef std::list<std::pair<std::string, SSL_SESSION*>> Sessions;
+
+    void release();
+    Sessions::iterator findSession(const std::string& sessionKey);
+
+    transport::ISSLWrapper::Pointer sslWrapper_;
+    X509* certificate_;
+    EVP_PKEY* privateKey_;
+    SSL_CTX* context_;
+    Sessions sessions_;
+    std::mutex sessionsMutex_;
+
+    static constexpr size_t cMaxSessionsCount = 16;
+};
+
+}
+}
+}
@@ -37,9 +37,12 @@ public:
 
     common::Data getData() const;
     size_t getSize() const;
+    size_t getTotalSize() const;
 
     static size_t getSizeOf(FrameSizeType type);
 
+    static constexpr size_t cMaxFramePayloadSize = 0x4000;
+
 private:
     FrameSizeType frameSizeType_;
     size_t frameSize_;
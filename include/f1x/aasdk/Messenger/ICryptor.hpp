@@ -18,8 +18,13 @@
 
 #pragma once
 
+#include <functional>
 #include <memory>
+#include <string>
+#include <vector>
 #include <f1x/aasdk/Common/Data.hpp>
+#include <f1x/aasdk/Error/Error.hpp>
+#include <f1x/aasdk/Messenger/HandshakeMetrics.hpp>
 
 namespace f1x
 {
@@ -32,6 +37,7 @@ class ICryptor
 {
 public:
     typedef std::shared_ptr<ICryptor> Pointer;
+    typedef std::function<void(const common::DataConstBuffer& buffer, uint8_t* output, error::Error& e)> DecryptTask;
 
     ICryptor() = default;
     virtual ~ICryptor() = default;
@@ -40,10 +46,17 @@ public:
     virtual void deinit() = 0;
     virtual bool doHandshake() = 0;
     virtual size_t encrypt(common::Data& output, const common::DataConstBuffer& buffer) = 0;
+    virtual size_t encrypt(common::Data& output, const common::DataConstBuffer& buffer, error::Error& e) noexcept = 0;
+    virtual void encryptBatch(std::vector<common::Data>& outputs, const std::vector<common::DataConstBuffer>& buffers) = 0;
+    virtual void encryptBatch(std::vector<common::Data>& outputs, const std::vector<common::DataConstBuffer>& buffers, error::Error& e) noexcept = 0;
     virtual size_t decrypt(common::Data& output, const common::DataConstBuffer& buffer) = 0;
+    virtual size_t decrypt(common::Data& output, const common::DataConstBuffer& buffer, error::Error& e) noexcept = 0;
+    virtual DecryptTask prepareDecrypt(const common::DataConstBuffer& buffer, size_t& plaintextSize) = 0;
     virtual common::Data readHandshakeBuffer() = 0;
     virtual void writeHandshakeBuffer(const common::DataConstBuffer& buffer) = 0;
     virtual bool isActive() const = 0;
+    virtual void setSessionKey(const std::string& sessionKey) = 0;
+    virtual HandshakeMetrics getHandshakeMetrics() const = 0;
 };
 
 }
@@ -18,6 +18,7 @@
 
 #pragma once
 
+#include <functional>
 #include <memory>
 #include <f1x/aasdk/Messenger/Promise.hpp>
 
@@ -32,11 +33,15 @@ class IMessageInStream
 {
 public:
     typedef std::shared_ptr<IMessageInStream> Pointer;
+    typedef std::function<void(Message::Pointer)> MessageHandler;
+    typedef std::function<void(const error::Error&)> ErrorHandler;
 
     IMessageInStream() = default;
     virtual ~IMessageInStream() = default;
 
     virtual void startReceive(ReceivePromise::Pointer promise) = 0;
+    virtual void startReceiveLoop(MessageHandler messageHandler, ErrorHandler errorHandler) = 0;
+    virtual void stopReceiveLoop() = 0;
 };
 
 }
@@ -23,6 +23,9 @@
 #include <f1x/aasdk/Messenger/ICryptor.hpp>
 #include <f1x/aasdk/Messenger/Message.hpp>
 #include <f1x/aasdk/Messenger/Promise.hpp>
+#include <f1x/aasdk/Messenger/IReceiveSubscription.hpp>
+#include <f1x/aasdk/Messenger/SendDeadline.hpp>
+#include <f1x/aasdk/Messenger/SendWatermarks.hpp>
 
 namespace f1x
 {
@@ -40,7 +43,14 @@ public:
     typedef std::shared_ptr<IMessenger> Pointer;
 
     virtual void enqueueReceive(ChannelId channelId, ReceivePromise::Pointer promise) = 0;
+    virtual void subscribe(ChannelId channelId, IReceiveSubscription::Pointer subscription) = 0;
+    virtual void unsubscribe(ChannelId channelId) = 0;
     virtual void enqueueSend(Message::Pointer message, SendPromise::Pointer promise) = 0;
+    virtual void enqueueSend(Message::Pointer message, SendPromise::Pointer promise, SendDeadline deadline) = 0;
+    virtual void enqueueWritable(ChannelId channelId, SendPromise::Pointer promise) = 0;
+    virtual void setSendWatermarks(ChannelId channelId, SendWatermarks watermarks) = 0;
+    virtual size_t getExpiredSendCount() const = 0;
+    virtual Message::Pointer createMessage(ChannelId channelId, EncryptionType encryptionType, MessageType type, size_t payloadSize) = 0;
     virtual void stop() = 0;
 };
 
@@ -0,0 +1,48 @@
+/*
+*  This file is part of aasdk library project.
+*  Copyright (C) 2018 f1x.studio (Michal Szwaj)
+*
+*  aasdk is free software: you can redistribute it and/or modify
+*  it under the terms of the GNU General Public License as published by
+*  the Free Software Foundation; either version 3 of the License, or
+*  (at your option) any later version.
+
+*  aasdk is distributed in the hope that it will be useful,
+*  but WITHOUT ANY WARRANTY; without even the implied warranty of
+*  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+*  GNU General Public License for more details.
+*
+*  You should have received a copy of the GNU General Public License
+*  along with aasdk. If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#pragma once
+
+#include <memory>
+#include <f1x/aasdk/Error/Error.hpp>
+#include <f1x/aasdk/Messenger/Message.hpp>
+
+namespace f1x
+{
+namespace aasdk
+{
+namespace messenger
+{
+
+class IReceiveSubscription
+{
+public:
+    typedef std::shared_ptr<IReceiveSubscription> Pointer;
+
+    IReceiveSubscription() = default;
+    virtual ~IReceiveSubscription() = default;
+
+    virtual void deliver(Message::Pointer message) = 0;
+    virtual void fail(const error::Error& e) = 0;
+    virtual void cancel() = 0;
+    virtual bool isCancelled() const = 0;
+};
+
+}
+}
+}
@@ -22,6 +22,7 @@
 #include <memory>
 #include <google/protobuf/message.h>
 #include <f1x/aasdk/Common/Data.hpp>
+#include <f1x/aasdk/Common/DataChain.hpp>
 #include <f1x/aasdk/Messenger/ChannelId.hpp>
 #include <f1x/aasdk/Messenger/EncryptionType.hpp>
 #include <f1x/aasdk/Messenger/MessageType.hpp>
@@ -47,18 +48,32 @@ public:
     EncryptionType getEncryptionType() const;
     MessageType getType() const;
 
+    // Joins the segments into one buffer; a payload spanning several frames is copied here.
     common::Data& getPayload();
-    const common::Data& getPayload() const;
+    size_t getPayloadSize() const;
+    std::vector<common::DataConstBuffer> getPayloadBuffers() const;
     void insertPayload(const common::Data& payload);
     void insertPayload(const google::protobuf::Message& message);
     void insertPayload(const common::DataConstBuffer& buffer);
     void insertPayload(common::DataBuffer& buffer);
+    void insertPayload(common::DataSegment segment);
+
+    void reserveHeadroom(size_t size);
+    size_t getHeadroom() const;
+    common::Data releaseFrame(const common::Data& header);
 
 private:
+    friend class MessagePool;
+
+    void materializePayload();
+    void materializeSegments();
+
     ChannelId channelId_;
     EncryptionType encryptionType_;
     MessageType type_;
     common::Data payload_;
+    common::DataChain segments_;
+    size_t headroom_;
 };
 
 }
@@ -18,9 +18,13 @@
 
 #pragma once
 
+#include <functional>
+#include <map>
+#include <f1x/aasdk/IO/WorkerPool.hpp>
 #include <f1x/aasdk/Transport/ITransport.hpp>
 #include <f1x/aasdk/Messenger/IMessageInStream.hpp>
 #include <f1x/aasdk/Messenger/ICryptor.hpp>
+#include <f1x/aasdk/Messenger/MessagePool.hpp>
 #include <f1x/aasdk/Messenger/FrameHeader.hpp>
 #include <f1x/aasdk/Messenger/FrameSize.hpp>
 #include <f1x/aasdk/Messenger/FrameType.hpp>
@@ -34,25 +38,55 @@ namespace messenger
 class MessageInStream: public IMessageInStream, public std::enable_shared_from_this<MessageInStream>, boost::noncopyable
 {
 public:
-    MessageInStream(boost::asio::io_service& ioService, transport::ITransport::Pointer transport, ICryptor::Pointer cryptor);
+    MessageInStream(boost::asio::io_service& ioService, transport::ITransport::Pointer transport, ICryptor::Pointer cryptor,
+                    MessagePool::Pointer messagePool = std::make_shared<MessagePool>(), io::WorkerPool::Pointer decryptionPool = nullptr);
 
     void startReceive(ReceivePromise::Pointer promise) override;
+    void startReceiveLoop(MessageHandler messageHandler, ErrorHandler errorHandler) override;
+    void stopReceiveLoop() override;
 
 private:
     using std::enable_shared_from_this<MessageInStream>::shared_from_this;
 
     void receiveFrameHeaderHandler(const common::DataConstBuffer& buffer);
     void receiveFrameSizeHandler(const common::DataConstBuffer& buffer);
-    void receiveFramePayloadHandler(const common::DataConstBuffer& buffer);
+    void receiveFramePayloadHandler(common::Data data);
+    bool decryptInParallel(common::Data& data);
+    void dispatchDecryption(std::shared_ptr<common::Data> frame, ICryptor::DecryptTask decryptTask, size_t plaintextSize);
+    void decryptionHandler(Message::Pointer message, const error::Error& e);
+    void completeMessage();
+    void resumeReceive();
+    void receiveNextFrame();
+    void resolveMessage(Message::Pointer message);
+    void rejectMessage(const error::Error& e);
+    bool isReceiving() const;
+
+    struct PendingDecryption
+    {
+        PendingDecryption();
+
+        size_t tasksCount;
+        error::Error error;
+    };
 
     boost::asio::io_service::strand strand_;
     transport::ITransport::Pointer transport_;
     ICryptor::Pointer cryptor_;
+    MessagePool::Pointer messagePool_;
+    io::WorkerPool::Pointer decryptionPool_;
     FrameType recentFrameType_;
     ReceivePromise::Pointer promise_;
+    MessageHandler loopMessageHandler_;
+    ErrorHandler loopErrorHandler_;
     Message::Pointer message_;
+    Message::Pointer unclaimedMessage_;
+    error::Error unclaimedError_;
 
     std::map<messenger::ChannelId, Message::Pointer> channel_assembly_buffers;
+    std::map<Message::Pointer, PendingDecryption> pendingDecryptions_;
+    std::function<void()> deferredDecryption_;
+    bool awaitingDecryption_;
+    bool isReceivingFrames_;
 };
 
 }
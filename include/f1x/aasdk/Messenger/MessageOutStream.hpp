@@ -43,7 +43,10 @@ private:
     using std::enable_shared_from_this<MessageOutStream>::shared_from_this;
 
     void streamSplittedMessage();
-    common::Data compoundFrame(FrameType frameType, const common::DataConstBuffer& payloadBuffer);
+    common::Data compoundFrame(FrameType frameType, const common::DataConstBuffer& payloadBuffer, error::Error& e);
+    void compoundEncryptedFrames(error::Error& e);
+    common::Data compoundFrameHeader(FrameType frameType);
+    common::Data releasePlainFrame();
     void streamEncryptedFrame(FrameType frameType, const common::DataConstBuffer& payloadBuffer);
     void streamPlainFrame(FrameType frameType, const common::DataConstBuffer& payloadBuffer);
     void setFrameSize(common::Data& data, FrameType frameType, size_t payloadSize, size_t totalSize);
@@ -55,9 +58,8 @@ private:
     Message::Pointer message_;
     size_t offset_;
     size_t remainingSize_;
+    std::vector<common::Data> encryptedFrames_;
     SendPromise::Pointer promise_;
-
-        static constexpr size_t cMaxFramePayloadSize = 0x4000;
 };
 
 }
@@ -0,0 +1,58 @@
+/*
+*  This file is part of aasdk library project.
+*  Copyright (C) 2018 f1x.studio (Michal Szwaj)
+*
+*  aasdk is free software: you can redistribute it and/or modify
+*  it under the terms of the GNU General Public License as published by
+*  the Free Software Foundation; either version 3 of the License, or
+*  (at your option) any later version.
+
+*  aasdk is distributed in the hope that it will be useful,
+*  but WITHOUT ANY WARRANTY; without even the implied warranty of
+*  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+*  GNU General Public License for more details.
+*
+*  You should have received a copy of the GNU General Public License
+*  along with aasdk. If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#pragma once
+
+#include <memory>
+#include <boost/noncopyable.hpp>
+#include <f1x/aasdk/Messenger/Message.hpp>
+#include <f1x/aasdk/Messenger/MessagePoolStatistics.hpp>
+
+namespace f1x
+{
+namespace aasdk
+{
+namespace messenger
+{
+
+class MessagePool: boost::noncopyable
+{
+public:
+    typedef std::shared_ptr<MessagePool> Pointer;
+
+    MessagePool();
+
+    Message::Pointer acquire(ChannelId channelId, EncryptionType encryptionType, MessageType type, size_t payloadSize = 0);
+    void reservePayload(Message& message, size_t payloadSize);
+    std::shared_ptr<common::Data> adopt(common::Data data);
+    MessagePoolStatistics getStatistics() const;
+
+    static constexpr size_t cMaxPooledPayloadSize = 1048576;
+
+private:
+    class Storage;
+    class Recycler;
+    class DataRecycler;
+    template<typename BlockType> class BlockAllocator;
+
+    std::shared_ptr<Storage> storage_;
+};
+
+}
+}
+}
@@ -19,12 +19,17 @@
 #pragma once
 
 #include <boost/asio.hpp>
+#include <atomic>
 #include <list>
+#include <mutex>
+#include <unordered_map>
 #include <f1x/aasdk/Messenger/IMessenger.hpp>
 #include <f1x/aasdk/Messenger/IMessageInStream.hpp>
 #include <f1x/aasdk/Messenger/IMessageOutStream.hpp>
 #include <f1x/aasdk/Messenger/ChannelReceiveMessageQueue.hpp>
 #include <f1x/aasdk/Messenger/ChannelReceivePromiseQueue.hpp>
+#include <f1x/aasdk/Messenger/ChannelSendBacklog.hpp>
+#include <f1x/aasdk/Messenger/MessagePool.hpp>
 
 namespace f1x
 {
@@ -36,16 +41,47 @@ namespace messenger
 class Messenger: public IMessenger, public std::enable_shared_from_this<Messenger>, boost::noncopyable
 {
 public:
-    Messenger(boost::asio::io_service& ioService, IMessageInStream::Pointer messageInStream, IMessageOutStream::Pointer messageOutStream);
+    Messenger(boost::asio::io_service& ioService, IMessageInStream::Pointer messageInStream, IMessageOutStream::Pointer messageOutStream,
+              MessagePool::Pointer messagePool = std::make_shared<MessagePool>());
     void enqueueReceive(ChannelId channelId, ReceivePromise::Pointer promise) override;
+    void subscribe(ChannelId channelId, IReceiveSubscription::Pointer subscription) override;
+    void unsubscribe(ChannelId channelId) override;
     void enqueueSend(Message::Pointer message, SendPromise::Pointer promise) override;
+    void enqueueSend(Message::Pointer message, SendPromise::Pointer promise, SendDeadline deadline) override;
+    void enqueueWritable(ChannelId channelId, SendPromise::Pointer promise) override;
+    void setSendWatermarks(ChannelId channelId, SendWatermarks watermarks) override;
+    size_t getExpiredSendCount() const override;
+    Message::Pointer createMessage(ChannelId channelId, EncryptionType encryptionType, MessageType type, size_t payloadSize) override;
     void stop() override;
 
 private:
     using std::enable_shared_from_this<Messenger>::shared_from_this;
-    typedef std::list<std::pair<Message::Pointer, SendPromise::Pointer>> ChannelSendQueue;
+
+    struct ChannelSendQueueElement
+    {
+        ChannelSendQueueElement(Message::Pointer _message, SendPromise::Pointer _promise, SendDeadline _deadline);
+
+        Message::Pointer message;
+        SendPromise::Pointer promise;
+        ChannelId channelId;
+        size_t size;
+        SendDeadline deadline;
+    };
+
+    typedef std::list<ChannelSendQueueElement> ChannelSendQueue;
+    typedef std::unordered_map<ChannelId, IReceiveSubscription::Pointer> ChannelReceiveSubscriptions;
+    typedef std::unordered_map<ChannelId, size_t> ChannelPendingReceives;
+
+    void startReceive();
+    void stopIdleReceiveLoop();
+    bool deliverToSubscription(Message::Pointer& message);
+    void queueMessage(Message::Pointer message);
     void doSend();
+    void dropExpiredSends(ChannelSendQueue::iterator queueElement);
     void inStreamMessageHandler(Message::Pointer message);
+    void inStreamLoopMessageHandler(Message::Pointer message);
+    void pendingReceiveHandler(Message::Pointer message);
+    void inStreamLoopErrorHandler(const error::Error& e);
     void outStreamMessageHandler(ChannelSendQueue::iterator queueElement);
     void rejectReceivePromiseQueue(const error::Error& e);
     void rejectSendPromiseQueue(const error::Error& e);
@@ -55,10 +91,18 @@ private:
     boost::asio::io_service::strand sendStrand_;
     IMessageInStream::Pointer messageInStream_;
     IMessageOutStream::Pointer messageOutStream_;
+    MessagePool::Pointer messagePool_;
 
     ChannelReceivePromiseQueue channelReceivePromiseQueue_;
     ChannelReceiveMessageQueue channelReceiveMessageQueue_;
+    std::mutex receiveMutex_;
+    ChannelReceiveSubscriptions channelReceiveSubscriptions_;
+    ChannelPendingReceives channelPendingReceives_;
+    bool isReceiving_;
+    bool isReceivingLoop_;
     ChannelSendQueue channelSendPromiseQueue_;
+    ChannelSendBacklog channelSendBacklog_;
+    std::atomic<size_t> expiredSendCount_;
 };
 
 }
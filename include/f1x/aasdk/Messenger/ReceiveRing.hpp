@@ -0,0 +1,71 @@
+/*
+*  This file is part of aasdk library project.
+*  Copyright (C) 2018 f1x.studio (Michal Szwaj)
+*
+*  aasdk is free software: you can redistribute it and/or modify
+*  it under the terms of the GNU General Public License as published by
+*  the Free Software Foundation; either version 3 of the License, or
+*  (at your option) any later version.
+
+*  aasdk is distributed in the hope that it will be useful,
+*  but WITHOUT ANY WARRANTY; without even the implied warranty of
+*  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+*  GNU General Public License for more details.
+*
+*  You should have received a copy of the GNU General Public License
+*  along with aasdk. If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <deque>
+#include <mutex>
+#include <boost/noncopyable.hpp>
+#include <f1x/aasdk/IO/SPSCRing.hpp>
+#include <f1x/aasdk/Messenger/IReceiveSubscription.hpp>
+
+namespace f1x
+{
+namespace aasdk
+{
+namespace messenger
+{
+
+class ReceiveRing: public IReceiveSubscription, boost::noncopyable
+{
+public:
+    typedef std::shared_ptr<ReceiveRing> Pointer;
+
+    explicit ReceiveRing(size_t capacity = 256);
+
+    void deliver(Message::Pointer message) override;
+    void fail(const error::Error& e) override;
+    void cancel() override;
+    bool isCancelled() const override;
+
+    bool pop(Message::Pointer& message);
+    bool pop(Message::Pointer& message, std::chrono::milliseconds timeout);
+    error::Error getError() const;
+    size_t getOverflowCount() const;
+
+private:
+    bool popOverflow(Message::Pointer& message);
+    void notify();
+
+    io::SPSCRing<Message::Pointer> ring_;
+    std::atomic<bool> hasOverflow_;
+    std::atomic<size_t> overflowCount_;
+    std::atomic<bool> isCancelled_;
+    std::atomic<bool> isWaiting_;
+    std::deque<Message::Pointer> overflow_;
+    error::Error error_;
+    mutable std::mutex mutex_;
+    std::condition_variable condition_;
+};
+
+}
+}
+}
@@ -0,0 +1,69 @@
+/*
+*  This file is part of aasdk library project.
+*  Copyright (C) 2018 f1x.studio (Michal Szwaj)
+*
+*  aasdk is free software: you can redistribute it and/or modify
+*  it under the terms of the GNU General Public License as published by
+*  the Free Software Foundation; either version 3 of the License, or
+*  (at your option) any later version.
+
+*  aasdk is distributed in the hope that it will be useful,
+*  but WITHOUT ANY WARRANTY; without even the implied warranty of
+*  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+*  GNU General Public License for more details.
+*
+*  You should have received a copy of the GNU General Public License
+*  along with aasdk. If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#pragma once
+
+#include <atomic>
+#include <functional>
+#include <memory>
+#include <boost/asio.hpp>
+#include <f1x/aasdk/IO/WorkStealingExecutor.hpp>
+#include <f1x/aasdk/Messenger/IReceiveSubscription.hpp>
+
+namespace f1x
+{
+namespace aasdk
+{
+namespace messenger
+{
+
+template<typename StrandType>
+class BasicReceiveSubscription: public IReceiveSubscription, public std::enable_shared_from_this<BasicReceiveSubscription<StrandType>>, boost::noncopyable
+{
+public:
+    typedef std::shared_ptr<BasicReceiveSubscription> Pointer;
+    typedef std::function<void(Message::Pointer)> MessageHandler;
+    typedef std::function<void(const error::Error&)> ErrorHandler;
+
+    BasicReceiveSubscription(StrandType strand, MessageHandler messageHandler, ErrorHandler errorHandler);
+
+    void deliver(Message::Pointer message) override;
+    void fail(const error::Error& e) override;
+    void cancel() override;
+    bool isCancelled() const override;
+
+private:
+    using std::enable_shared_from_this<BasicReceiveSubscription<StrandType>>::shared_from_this;
+
+    template<typename HandlerType>
+    static void post(boost::asio::io_service::strand& strand, HandlerType&& handler);
+    template<typename HandlerType>
+    static void post(const io::WorkStealingExecutor::Strand::Pointer& strand, HandlerType&& handler);
+
+    StrandType strand_;
+    MessageHandler messageHandler_;
+    ErrorHandler errorHandler_;
+    std::atomic<bool> isCancelled_;
+};
+
+typedef BasicReceiveSubscription<boost::asio::io_service::strand&> ReceiveSubscription;
+typedef BasicReceiveSubscription<io::WorkStealingExecutor::Strand::Pointer> ExecutorReceiveSubscription;
+
+}
+}
+}
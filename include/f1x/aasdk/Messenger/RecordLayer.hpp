@@ -0,0 +1,81 @@
+/*
+*  This file is part of aasdk library project.
+*  Copyright (C) 2018 f1x.studio (Michal Szwaj)
+*
+*  aasdk is free software: you can redistribute it and/or modify
+*  it under the terms of the GNU General Public License as published by
+*  the Free Software Foundation; either version 3 of the License, or
+*  (at your option) any later version.
+
+*  aasdk is distributed in the hope that it will be useful,
+*  but WITHOUT ANY WARRANTY; without even the implied warranty of
+*  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+*  GNU General Public License for more details.
+*
+*  You should have received a copy of the GNU General Public License
+*  along with aasdk. If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#pragma once
+
+#include <mutex>
+#include <vector>
+#include <boost/noncopyable.hpp>
+#include <openssl/evp.h>
+#include <f1x/aasdk/Common/Data.hpp>
+#include <f1x/aasdk/Error/Error.hpp>
+#include <f1x/aasdk/Transport/SSLTrafficKeys.hpp>
+
+namespace f1x
+{
+namespace aasdk
+{
+namespace messenger
+{
+
+class RecordLayer: boost::noncopyable
+{
+public:
+    RecordLayer(const transport::SSLTrafficKeys& trafficKeys, uint64_t writeSequenceNumber = 1, uint64_t readSequenceNumber = 1);
+    ~RecordLayer();
+
+    size_t encrypt(common::Data& output, const common::DataConstBuffer& buffer, error::Error& e) noexcept;
+    size_t decrypt(common::Data& output, const common::DataConstBuffer& buffer, error::Error& e) noexcept;
+    size_t reserveDecrypt(const common::DataConstBuffer& buffer, uint64_t& sequenceNumber, error::Error& e) noexcept;
+    void decrypt(uint8_t* output, const common::DataConstBuffer& buffer, uint64_t sequenceNumber, error::Error& e) const noexcept;
+
+private:
+    bool encryptRecord(uint8_t* record, const common::DataConstBuffer& buffer) noexcept;
+    bool decryptRecords(EVP_CIPHER_CTX* context, uint8_t* output, const common::DataConstBuffer& buffer, uint64_t sequenceNumber) const noexcept;
+    bool decryptRecord(EVP_CIPHER_CTX* context, uint8_t* output, const common::DataConstBuffer& record, uint64_t sequenceNumber) const noexcept;
+    EVP_CIPHER_CTX* acquireDecryptContext() const noexcept;
+    void releaseDecryptContext(EVP_CIPHER_CTX* context) const noexcept;
+    size_t getRecordSize(const common::DataConstBuffer& buffer, size_t offset) const noexcept;
+    void setNonce(uint8_t* nonce, const common::Data& fixedIV, const uint8_t* explicitNonce) const;
+    void setAdditionalData(uint8_t* additionalData, uint64_t sequenceNumber, uint8_t contentType, size_t size) const;
+
+    EVP_CIPHER_CTX* encryptContext_;
+    EVP_CIPHER_CTX* decryptContext_;
+    const EVP_CIPHER* cipher_;
+    mutable std::mutex decryptContextsMutex_;
+    mutable std::vector<EVP_CIPHER_CTX*> decryptContexts_;
+    common::Data readKey_;
+    common::Data writeIV_;
+    common::Data readIV_;
+    uint16_t version_;
+    uint64_t writeSequenceNumber_;
+    uint64_t readSequenceNumber_;
+
+    static constexpr uint8_t cApplicationDataContentType = 23;
+    static constexpr size_t cHeaderSize = 5;
+    static constexpr size_t cExplicitNonceSize = 8;
+    static constexpr size_t cTagSize = 16;
+    static constexpr size_t cNonceSize = 12;
+    static constexpr size_t cAdditionalDataSize = 13;
+    static constexpr size_t cMaxPlaintextSize = 16384;
+    static constexpr size_t cOverheadSize = cHeaderSize + cExplicitNonceSize + cTagSize;
+};
+
+}
+}
+}
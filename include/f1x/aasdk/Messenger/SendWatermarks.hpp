@@ -0,0 +1,44 @@
+/*
+*  This file is part of aasdk library project.
+*  Copyright (C) 2018 f1x.studio (Michal Szwaj)
+*
+*  aasdk is free software: you can redistribute it and/or modify
+*  it under the terms of the GNU General Public License as published by
+*  the Free Software Foundation; either version 3 of the License, or
+*  (at your option) any later version.
+
+*  aasdk is distributed in the hope that it will be useful,
+*  but WITHOUT ANY WARRANTY; without even the implied warranty of
+*  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+*  GNU General Public License for more details.
+*
+*  You should have received a copy of the GNU General Public License
+*  along with aasdk. If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#pragma once
+
+#include <cstddef>
+#include <limits>
+
+namespace f1x
+{
+namespace aasdk
+{
+namespace messenger
+{
+
+struct SendWatermarks
+{
+    SendWatermarks(size_t _highBytes = std::numeric_limits<size_t>::max(), size_t _lowBytes = 0,
+                   size_t _highMessages = std::numeric_limits<size_t>::max(), size_t _lowMessages = 0);
+
+    size_t highBytes;
+    size_t lowBytes;
+    size_t highMessages;
+    size_t lowMessages;
+};
+
+}
+}
+}
@@ -21,6 +21,7 @@
 #include <limits>
 #include <boost/circular_buffer.hpp>
 #include <f1x/aasdk/Common/Data.hpp>
+#include <f1x/aasdk/Error/Error.hpp>
 
 
 namespace f1x
@@ -37,9 +38,11 @@ public:
 
     common::DataBuffer fill();
     void commit(common::Data::size_type size);
+    void commit(common::Data::size_type size, error::Error& e) noexcept;
 
     common::Data::size_type getAvailableSize();
     common::Data consume(common::Data::size_type size);
+    common::Data consume(common::Data::size_type size, error::Error& e);
 
 private:
     boost::circular_buffer<common::Data::value_type> data_;
@@ -19,7 +19,9 @@
 #pragma once
 
 #include <memory>
+#include <string>
 #include <openssl/ssl.h>
+#include <f1x/aasdk/Transport/SSLTrafficKeys.hpp>
 
 namespace f1x
 {
@@ -47,13 +49,16 @@ public:
     virtual bool checkPrivateKey(SSL* ssl) = 0;
     virtual std::pair<BIO*, BIO*> createBIOs() = 0;
     virtual void setBIOs(SSL* ssl, const BIOs& bIOs, size_t maxBufferSize) = 0;
+    virtual void setBIOOutput(BIO* bio, common::Data* output) = 0;
     virtual void setConnectState(SSL* ssl) = 0;
+    virtual bool setCipherList(SSL* ssl, const std::string& cipherList) = 0;
     virtual int doHandshake(SSL* ssl) = 0;
     virtual void free(SSL* ssl) = 0;
     virtual void free(SSL_CTX* context) = 0;
     virtual void free(BIO* bio) = 0;
     virtual void free(X509* certificate) = 0;
     virtual void free(EVP_PKEY* privateKey) = 0;
+    virtual void free(SSL_SESSION* session) = 0;
 
     virtual size_t bioCtrlPending(BIO* b) = 0;
     virtual int bioRead(BIO *b, void *data, int len) = 0;
@@ -63,6 +68,12 @@ public:
     virtual int sslRead(SSL *ssl, void *buf, int num) = 0;
     virtual int sslWrite(SSL *ssl, const void *buf, int num) = 0;
     virtual int getError(SSL* ssl, int returnCode) = 0;
+    virtual bool getTrafficKeys(SSL* ssl, SSLTrafficKeys& trafficKeys) = 0;
+    virtual SSL_SESSION* getSession(SSL* ssl) = 0;
+    virtual bool setSession(SSL* ssl, SSL_SESSION* session) = 0;
+    virtual bool isSessionReused(SSL* ssl) = 0;
+    virtual std::string getCipherName(const SSL* ssl) = 0;
+    virtual bool hasAESAcceleration() = 0;
 };
 
 }
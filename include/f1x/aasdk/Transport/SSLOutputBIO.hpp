@@ -0,0 +1,55 @@
+/*
+*  This file is part of aasdk library project.
+*  Copyright (C) 2018 f1x.studio (Michal Szwaj)
+*
+*  aasdk is free software: you can redistribute it and/or modify
+*  it under the terms of the GNU General Public License as published by
+*  the Free Software Foundation; either version 3 of the License, or
+*  (at your option) any later version.
+
+*  aasdk is distributed in the hope that it will be useful,
+*  but WITHOUT ANY WARRANTY; without even the implied warranty of
+*  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+*  GNU General Public License for more details.
+*
+*  You should have received a copy of the GNU General Public License
+*  along with aasdk. If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#pragma once
+
+#include <boost/noncopyable.hpp>
+#include <openssl/bio.h>
+#include <f1x/aasdk/Common/Data.hpp>
+
+namespace f1x
+{
+namespace aasdk
+{
+namespace transport
+{
+
+class SSLOutputBIO: boost::noncopyable
+{
+public:
+    static BIO* create();
+    static void setOutput(BIO* bio, common::Data* output);
+
+private:
+    SSLOutputBIO();
+
+    static BIO_METHOD* getMethod();
+    static int onCreate(BIO* bio);
+    static int onDestroy(BIO* bio);
+    static int onWrite(BIO* bio, const char* data, int size);
+    static int onRead(BIO* bio, char* data, int size);
+    static long onCtrl(BIO* bio, int command, long number, void* pointer);
+
+    common::Data pending_;
+    size_t pendingOffset_;
+    common::Data* output_;
+};
+
+}
+}
+}
@@ -43,15 +43,24 @@ public:
     bool checkPrivateKey(SSL* ssl) override;
     BIOs createBIOs() override;
     void setBIOs(SSL* ssl, const BIOs& bIOs, size_t maxBufferSize) override;
+    void setBIOOutput(BIO* bio, common::Data* output) override;
     void setConnectState(SSL* ssl) override;
+    bool setCipherList(SSL* ssl, const std::string& cipherList) override;
     int doHandshake(SSL* ssl) override;
     int getError(SSL* ssl, int returnCode) override;
+    bool getTrafficKeys(SSL* ssl, SSLTrafficKeys& trafficKeys) override;
+    SSL_SESSION* getSession(SSL* ssl) override;
+    bool setSession(SSL* ssl, SSL_SESSION* session) override;
+    bool isSessionReused(SSL* ssl) override;
+    std::string getCipherName(const SSL* ssl) override;
+    bool hasAESAcceleration() override;
 
     void free(SSL* ssl) override;
     void free(SSL_CTX* context) override;
     void free(BIO* bio) override;
     void free(X509* certificate) override;
     void free(EVP_PKEY* privateKey) override;
+    void free(SSL_SESSION* session) override;
 
     size_t bioCtrlPending(BIO* b) override;
     int bioRead(BIO *b, void *data, int len) override;
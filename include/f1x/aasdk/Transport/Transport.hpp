@@ -45,7 +45,7 @@ protected:
 
     using std::enable_shared_from_this<Transport>::shared_from_this;
     void receiveHandler(size_t bytesTransferred);
-    void distributeReceivedData();
+    void distributeReceivedData(error::Error& e);
     void rejectReceivePromises(const error::Error& e);
 
     virtual void enqueueReceive(common::DataBuffer buffer) = 0;
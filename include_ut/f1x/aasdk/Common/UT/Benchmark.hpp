@@ -0,0 +1,63 @@
+/*
+*  This file is part of aasdk library project.
+*  Copyright (C) 2018 f1x.studio (Michal Szwaj)
+*
+*  aasdk is free software: you can redistribute it and/or modify
+*  it under the terms of the GNU General Public License as published by
+*  the Free Software Foundation; either version 3 of the License, or
+*  (at your option) any later version.
+
+*  aasdk is distributed in the hope that it will be useful,
+*  but WITHOUT ANY WARRANTY; without even the implied warranty of
+*  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+*  GNU General Public License for more details.
+*
+*  You should have received a copy of the GNU General Public License
+*  along with aasdk. If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#pragma once
+
+#include <chrono>
+#include <iomanip>
+#include <iostream>
+#include <string>
+
+namespace f1x
+{
+namespace aasdk
+{
+namespace common
+{
+namespace ut
+{
+
+template<typename FunctionType>
+double runBenchmark(const std::string& name, size_t iterations, size_t bytesPerIteration, FunctionType&& function)
+{
+    const auto begin = std::chrono::steady_clock::now();
+
+    for(size_t i = 0; i < iterations; ++i)
+    {
+        function();
+    }
+
+    const std::chrono::duration<double, std::nano> elapsed = std::chrono::steady_clock::now() - begin;
+    const auto nanosecondsPerIteration = elapsed.count() / iterations;
+
+    std::cout << std::left << std::setw(48) << name
+              << std::right << std::setw(12) << std::fixed << std::setprecision(1) << nanosecondsPerIteration << " ns/op";
+
+    if(bytesPerIteration > 0)
+    {
+        std::cout << std::setw(12) << std::setprecision(1) << (bytesPerIteration * 1000.0 / nanosecondsPerIteration) << " MB/s";
+    }
+
+    std::cout << std::endl;
+    return nanosecondsPerIteration;
+}
+
+}
+}
+}
+}
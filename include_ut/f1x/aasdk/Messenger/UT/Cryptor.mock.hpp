@@ -37,10 +37,44 @@ public:
     MOCK_METHOD0(deinit, void());
     MOCK_METHOD0(doHandshake, bool());
     MOCK_METHOD2(encrypt, size_t(common::Data& output, const common::DataConstBuffer& buffer));
+    MOCK_METHOD2(encryptBatch, void(std::vector<common::Data>& outputs, const std::vector<common::DataConstBuffer>& buffers));
     MOCK_METHOD2(decrypt, size_t(common::Data& output, const common::DataConstBuffer& buffer));
+    MOCK_METHOD2(prepareDecrypt, DecryptTask(const common::DataConstBuffer& buffer, size_t& plaintextSize));
     MOCK_METHOD0(readHandshakeBuffer, common::Data());
     MOCK_METHOD1(writeHandshakeBuffer, void(const common::DataConstBuffer& buffer));
     MOCK_CONST_METHOD0(isActive, bool());
+    MOCK_METHOD1(setSessionKey, void(const std::string& sessionKey));
+    MOCK_CONST_METHOD0(getHandshakeMetrics, HandshakeMetrics());
+
+    size_t encrypt(common::Data& output, const common::DataConstBuffer& buffer, error::Error& e) noexcept override
+    {
+        return this->invoke([&]() { return this->encrypt(output, buffer); }, e);
+    }
+
+    void encryptBatch(std::vector<common::Data>& outputs, const std::vector<common::DataConstBuffer>& buffers, error::Error& e) noexcept override
+    {
+        this->invoke([&]() { this->encryptBatch(outputs, buffers); return size_t(0); }, e);
+    }
+
+    size_t decrypt(common::Data& output, const common::DataConstBuffer& buffer, error::Error& e) noexcept override
+    {
+        return this->invoke([&]() { return this->decrypt(output, buffer); }, e);
+    }
+
+private:
+    template<typename FunctorType>
+    size_t invoke(FunctorType functor, error::Error& e) noexcept
+    {
+        try
+        {
+            return functor();
+        }
+        catch(const error::Error& error)
+        {
+            e = error;
+            return 0;
+        }
+    }
 };
 
 }
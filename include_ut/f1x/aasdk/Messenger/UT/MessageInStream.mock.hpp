@@ -34,6 +34,8 @@ class MessageInStreamMock: public IMessageInStream
 {
 public:
     MOCK_METHOD1(startReceive, void(ReceivePromise::Pointer promise));
+    MOCK_METHOD2(startReceiveLoop, void(MessageHandler messageHandler, ErrorHandler errorHandler));
+    MOCK_METHOD0(stopReceiveLoop, void());
 };
 
 }
@@ -0,0 +1,208 @@
+/*
+*  This file is part of aasdk library project.
+*  Copyright (C) 2018 f1x.studio (Michal Szwaj)
+*
+*  aasdk is free software: you can redistribute it and/or modify
+*  it under the terms of the GNU General Public License as published by
+*  the Free Software Foundation; either version 3 of the License, or
+*  (at your option) any later version.
+
+*  aasdk is distributed in the hope that it will be useful,
+*  but WITHOUT ANY WARRANTY; without even the implied warranty of
+*  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+*  GNU General Public License for more details.
+*
+*  You should have received a copy of the GNU General Public License
+*  along with aasdk. If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#pragma once
+
+#include <boost/noncopyable.hpp>
+#include <openssl/ssl.h>
+#include <openssl/x509.h>
+#include <openssl/rsa.h>
+#include <openssl/pem.h>
+#include <f1x/aasdk/Common/Data.hpp>
+#include <f1x/aasdk/Messenger/ICryptor.hpp>
+
+namespace f1x
+{
+namespace aasdk
+{
+namespace messenger
+{
+namespace ut
+{
+
+class SSLServer: boost::noncopyable
+{
+public:
+    SSLServer(int maxProtocolVersion = TLS1_2_VERSION, const std::string& cipherList = std::string())
+        : privateKey_(createPrivateKey())
+        , certificate_(createCertificate(privateKey_))
+        , context_(SSL_CTX_new(TLS_server_method()))
+        , ssl_(nullptr)
+    {
+        SSL_CTX_set_max_proto_version(context_, maxProtocolVersion);
+        SSL_CTX_use_certificate(context_, certificate_);
+        SSL_CTX_use_PrivateKey(context_, privateKey_);
+
+        if(!cipherList.empty())
+        {
+            SSL_CTX_set_cipher_list(context_, cipherList.c_str());
+        }
+
+        this->reset();
+    }
+
+    ~SSLServer()
+    {
+        SSL_free(ssl_);
+        SSL_CTX_free(context_);
+        X509_free(certificate_);
+        EVP_PKEY_free(privateKey_);
+    }
+
+    void reset()
+    {
+        if(ssl_ != nullptr)
+        {
+            SSL_free(ssl_);
+        }
+
+        ssl_ = SSL_new(context_);
+        readBIO_ = BIO_new(BIO_s_mem());
+        writeBIO_ = BIO_new(BIO_s_mem());
+        SSL_set_bio(ssl_, readBIO_, writeBIO_);
+        SSL_set_accept_state(ssl_);
+    }
+
+    void connect(ICryptor& cryptor)
+    {
+        while(!cryptor.doHandshake())
+        {
+            this->write(cryptor.readHandshakeBuffer());
+            SSL_do_handshake(ssl_);
+            cryptor.writeHandshakeBuffer(common::DataConstBuffer(this->read()));
+        }
+
+        this->write(cryptor.readHandshakeBuffer());
+        SSL_do_handshake(ssl_);
+    }
+
+    common::Data encrypt(const common::DataConstBuffer& buffer)
+    {
+        SSL_write(ssl_, buffer.cdata, buffer.size);
+        return this->read();
+    }
+
+    common::Data decrypt(const common::DataConstBuffer& buffer)
+    {
+        this->write(common::Data(buffer.cdata, buffer.cdata + buffer.size));
+
+        common::Data output;
+        common::Data chunk(cMaxRecordSize);
+        int readSize = 0;
+
+        while((readSize = SSL_read(ssl_, chunk.data(), chunk.size())) > 0)
+        {
+            output.insert(output.end(), chunk.begin(), chunk.begin() + readSize);
+        }
+
+        return output;
+    }
+
+    SSL* getSSL() const
+    {
+        return ssl_;
+    }
+
+    std::string getCertificate() const
+    {
+        auto bio = BIO_new(BIO_s_mem());
+        PEM_write_bio_X509(bio, certificate_);
+        return toString(bio);
+    }
+
+    std::string getPrivateKey() const
+    {
+        auto bio = BIO_new(BIO_s_mem());
+        PEM_write_bio_PrivateKey(bio, privateKey_, nullptr, nullptr, 0, nullptr, nullptr);
+        return toString(bio);
+    }
+
+private:
+    void write(const common::Data& data)
+    {
+        if(!data.empty())
+        {
+            BIO_write(readBIO_, data.data(), data.size());
+        }
+    }
+
+    common::Data read()
+    {
+        common::Data data(BIO_ctrl_pending(writeBIO_));
+
+        if(!data.empty())
+        {
+            BIO_read(writeBIO_, data.data(), data.size());
+        }
+
+        return data;
+    }
+
+    static std::string toString(BIO* bio)
+    {
+        char* data = nullptr;
+        const auto size = BIO_get_mem_data(bio, &data);
+        std::string result(data, size);
+        BIO_free(bio);
+
+        return result;
+    }
+
+    static EVP_PKEY* createPrivateKey()
+    {
+        EVP_PKEY* privateKey = nullptr;
+        auto keyContext = EVP_PKEY_CTX_new_id(EVP_PKEY_RSA, nullptr);
+        EVP_PKEY_keygen_init(keyContext);
+        EVP_PKEY_CTX_set_rsa_keygen_bits(keyContext, 2048);
+        EVP_PKEY_keygen(keyContext, &privateKey);
+        EVP_PKEY_CTX_free(keyContext);
+
+        return privateKey;
+    }
+
+    static X509* createCertificate(EVP_PKEY* privateKey)
+    {
+        auto certificate = X509_new();
+        X509_set_version(certificate, 2);
+        ASN1_INTEGER_set(X509_get_serialNumber(certificate), 1);
+        X509_gmtime_adj(X509_getm_notBefore(certificate), 0);
+        X509_gmtime_adj(X509_getm_notAfter(certificate), 60 * 60);
+        X509_set_pubkey(certificate, privateKey);
+
+        auto name = X509_get_subject_name(certificate);
+        X509_NAME_add_entry_by_txt(name, "CN", MBSTRING_ASC, reinterpret_cast<const unsigned char*>("aasdk"), -1, -1, 0);
+        X509_set_issuer_name(certificate, name);
+        X509_sign(certificate, privateKey, EVP_sha256());
+
+        return certificate;
+    }
+
+    EVP_PKEY* privateKey_;
+    X509* certificate_;
+    SSL_CTX* context_;
+    SSL* ssl_;
+    BIO* readBIO_;
+    BIO* writeBIO_;
+
+    static constexpr size_t cMaxRecordSize = 16384;
+};
+
+}
+}
+}
+}
@@ -0,0 +1,102 @@
+/*
+*  This file is part of aasdk library project.
+*  Copyright (C) 2018 f1x.studio (Michal Szwaj)
+*
+*  aasdk is free software: you can redistribute it and/or modify
+*  it under the terms of the GNU General Public License as published by
+*  the Free Software Foundation; either version 3 of the License, or
+*  (at your option) any later version.
+
+*  aasdk is distributed in the hope that it will be useful,
+*  but WITHOUT ANY WARRANTY; without even the implied warranty of
+*  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+*  GNU General Public License for more details.
+*
+*  You should have received a copy of the GNU General Public License
+*  along with aasdk. If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#pragma once
+
+#include <algorithm>
+#include <cstring>
+#include <f1x/aasdk/Transport/Transport.hpp>
+
+namespace f1x
+{
+namespace aasdk
+{
+namespace transport
+{
+namespace ut
+{
+
+class LoopbackTransport: public Transport
+{
+public:
+    LoopbackTransport(boost::asio::io_service& ioService)
+        : Transport(ioService)
+        , pendingOffset_(0)
+    {
+
+    }
+
+    void stop() override
+    {
+
+    }
+
+protected:
+    void enqueueReceive(common::DataBuffer buffer) override
+    {
+        receiveBuffer_ = buffer;
+        this->flush();
+    }
+
+    void enqueueSend(SendQueue::iterator queueElement) override
+    {
+        receiveStrand_.dispatch([this, self = this->shared_from_this(), data = queueElement->first]() mutable {
+            pendingData_.insert(pendingData_.end(), data.begin(), data.end());
+            this->flush();
+        });
+
+        queueElement->second->resolve();
+        sendQueue_.erase(queueElement);
+
+        if(!sendQueue_.empty())
+        {
+            this->enqueueSend(sendQueue_.begin());
+        }
+    }
+
+private:
+    void flush()
+    {
+        if(receiveBuffer_.data == nullptr || pendingOffset_ == pendingData_.size())
+        {
+            return;
+        }
+
+        const auto size = std::min(receiveBuffer_.size, pendingData_.size() - pendingOffset_);
+        memcpy(receiveBuffer_.data, pendingData_.data() + pendingOffset_, size);
+        pendingOffset_ += size;
+
+        if(pendingOffset_ * 2 >= pendingData_.size())
+        {
+            pendingData_.erase(pendingData_.begin(), pendingData_.begin() + pendingOffset_);
+            pendingOffset_ = 0;
+        }
+
+        receiveBuffer_ = common::DataBuffer();
+        this->receiveHandler(size);
+    }
+
+    common::DataBuffer receiveBuffer_;
+    common::Data pendingData_;
+    size_t pendingOffset_;
+};
+
+}
+}
+}
+}
@@ -40,6 +40,11 @@ AVInputServiceChannel::AVInputServiceChannel(boost::asio::io_service::strand& st
 
 void AVInputServiceChannel::receive(IAVInputServiceChannelEventHandler::Pointer eventHandler)
 {
+    if(this->isSubscribed())
+    {
+        return;
+    }
+
     auto receivePromise = messenger::ReceivePromise::defer(strand_);
     receivePromise->then(std::bind(&AVInputServiceChannel::messageHandler, this->shared_from_this(), std::placeholders::_1, eventHandler),
                         std::bind(&IAVInputServiceChannelEventHandler::onChannelError, eventHandler, std::placeholders::_1));
@@ -47,9 +52,20 @@ void AVInputServiceChannel::receive(IAVInputServiceChannelEventHandler::Pointer
     messenger_->enqueueReceive(channelId_, std::move(receivePromise));
 }
 
+void AVInputServiceChannel::subscribe(IAVInputServiceChannelEventHandler::Pointer eventHandler)
+{
+    this->startSubscription(std::bind(&AVInputServiceChannel::messageHandler, this->shared_from_this(), std::placeholders::_1, eventHandler),
+                            std::bind(&IAVInputServiceChannelEventHandler::onChannelError, eventHandler, std::placeholders::_1));
+}
+
+void AVInputServiceChannel::unsubscribe()
+{
+    this->stopSubscription();
+}
+
 void AVInputServiceChannel::sendChannelOpenResponse(const proto::messages::ChannelOpenResponse& response, SendPromise::Pointer promise)
 {
-    auto message(std::make_shared<messenger::Message>(channelId_, messenger::EncryptionType::ENCRYPTED, messenger::MessageType::CONTROL));
+    auto message(this->createMessage(messenger::EncryptionType::ENCRYPTED, messenger::MessageType::CONTROL));
     message->insertPayload(messenger::MessageId(proto::ids::ControlMessage::CHANNEL_OPEN_RESPONSE).getData());
     message->insertPayload(response);
 
@@ -58,7 +74,7 @@ void AVInputServiceChannel::sendChannelOpenResponse(const proto::messages::Chann
 
 void AVInputServiceChannel::sendAVChannelSetupResponse(const proto::messages::AVChannelSetupResponse& response, SendPromise::Pointer promise)
 {
-    auto message(std::make_shared<messenger::Message>(channelId_, messenger::EncryptionType::ENCRYPTED, messenger::MessageType::SPECIFIC));
+    auto message(this->createMessage(messenger::EncryptionType::ENCRYPTED, messenger::MessageType::SPECIFIC));
     message->insertPayload(messenger::MessageId(proto::ids::AVChannelMessage::SETUP_RESPONSE).getData());
     message->insertPayload(response);
 
@@ -98,7 +114,7 @@ void AVInputServiceChannel::messageHandler(messenger::Message::Pointer message,
 
 void AVInputServiceChannel::sendAVInputOpenResponse(const proto::messages::AVInputOpenResponse& response, SendPromise::Pointer promise)
 {
-    auto message(std::make_shared<messenger::Message>(channelId_, messenger::EncryptionType::ENCRYPTED, messenger::MessageType::SPECIFIC));
+    auto message(this->createMessage(messenger::EncryptionType::ENCRYPTED, messenger::MessageType::SPECIFIC));
     message->insertPayload(messenger::MessageId(proto::ids::AVChannelMessage::AV_INPUT_OPEN_RESPONSE).getData());
     message->insertPayload(response);
 
@@ -107,7 +123,8 @@ void AVInputServiceChannel::sendAVInputOpenResponse(const proto::messages::AVInp
 
 void AVInputServiceChannel::sendAVMediaWithTimestampIndication(messenger::Timestamp::ValueType timestamp, const common::Data& data, SendPromise::Pointer promise)
 {
-    auto message(std::make_shared<messenger::Message>(channelId_, messenger::EncryptionType::ENCRYPTED, messenger::MessageType::SPECIFIC));
+    const auto payloadSize = messenger::MessageId::getSizeOf() + sizeof(messenger::Timestamp::ValueType) + data.size();
+    auto message(this->createMessage(messenger::EncryptionType::ENCRYPTED, messenger::MessageType::SPECIFIC, payloadSize));
     message->insertPayload(messenger::MessageId(proto::ids::AVChannelMessage::AV_MEDIA_WITH_TIMESTAMP_INDICATION).getData());
 
     auto timestampData = messenger::Timestamp(timestamp).getData();
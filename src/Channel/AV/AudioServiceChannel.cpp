@@ -39,6 +39,11 @@ AudioServiceChannel::AudioServiceChannel(boost::asio::io_service::strand& strand
 
 void AudioServiceChannel::receive(IAudioServiceChannelEventHandler::Pointer eventHandler)
 {
+    if(this->isSubscribed())
+    {
+        return;
+    }
+
     auto receivePromise = messenger::ReceivePromise::defer(strand_);
     receivePromise->then(std::bind(&AudioServiceChannel::messageHandler, this->shared_from_this(), std::placeholders::_1, eventHandler),
                         std::bind(&IAudioServiceChannelEventHandler::onChannelError, eventHandler, std::placeholders::_1));
@@ -46,6 +51,27 @@ void AudioServiceChannel::receive(IAudioServiceChannelEventHandler::Pointer even
     messenger_->enqueueReceive(channelId_, std::move(receivePromise));
 }
 
+void AudioServiceChannel::subscribe(IAudioServiceChannelEventHandler::Pointer eventHandler)
+{
+    this->startSubscription(std::bind(&AudioServiceChannel::messageHandler, this->shared_from_this(), std::placeholders::_1, eventHandler),
+                            std::bind(&IAudioServiceChannelEventHandler::onChannelError, eventHandler, std::placeholders::_1));
+}
+
+void AudioServiceChannel::subscribe(messenger::ReceiveRing::Pointer ring)
+{
+    this->startSubscription(std::move(ring));
+}
+
+void AudioServiceChannel::unsubscribe()
+{
+    this->stopSubscription();
+}
+
+void AudioServiceChannel::handleMessage(messenger::Message::Pointer message, IAudioServiceChannelEventHandler::Pointer eventHandler)
+{
+    this->messageHandler(std::move(message), std::move(eventHandler));
+}
+
 messenger::ChannelId AudioServiceChannel::getId() const
 {
     return channelId_;
@@ -53,7 +79,7 @@ messenger::ChannelId AudioServiceChannel::getId() const
 
 void AudioServiceChannel::sendChannelOpenResponse(const proto::messages::ChannelOpenResponse& response, SendPromise::Pointer promise)
 {
-    auto message(std::make_shared<messenger::Message>(channelId_, messenger::EncryptionType::ENCRYPTED, messenger::MessageType::CONTROL));
+    auto message(this->createMessage(messenger::EncryptionType::ENCRYPTED, messenger::MessageType::CONTROL));
     message->insertPayload(messenger::MessageId(proto::ids::ControlMessage::CHANNEL_OPEN_RESPONSE).getData());
     message->insertPayload(response);
 
@@ -62,7 +88,7 @@ void AudioServiceChannel::sendChannelOpenResponse(const proto::messages::Channel
 
 void AudioServiceChannel::sendAVChannelSetupResponse(const proto::messages::AVChannelSetupResponse& response, SendPromise::Pointer promise)
 {
-    auto message(std::make_shared<messenger::Message>(channelId_, messenger::EncryptionType::ENCRYPTED, messenger::MessageType::SPECIFIC));
+    auto message(this->createMessage(messenger::EncryptionType::ENCRYPTED, messenger::MessageType::SPECIFIC));
     message->insertPayload(messenger::MessageId(proto::ids::AVChannelMessage::SETUP_RESPONSE).getData());
     message->insertPayload(response);
 
@@ -71,7 +97,7 @@ void AudioServiceChannel::sendAVChannelSetupResponse(const proto::messages::AVCh
 
 void AudioServiceChannel::sendAVMediaAckIndication(const proto::messages::AVMediaAckIndication& indication, SendPromise::Pointer promise)
 {
-    auto message(std::make_shared<messenger::Message>(channelId_, messenger::EncryptionType::ENCRYPTED, messenger::MessageType::SPECIFIC));
+    auto message(this->createMessage(messenger::EncryptionType::ENCRYPTED, messenger::MessageType::SPECIFIC));
     message->insertPayload(messenger::MessageId(proto::ids::AVChannelMessage::AV_MEDIA_ACK_INDICATION).getData());
     message->insertPayload(indication);
 
@@ -40,6 +40,11 @@ VideoServiceChannel::VideoServiceChannel(boost::asio::io_service::strand& strand
 
 void VideoServiceChannel::receive(IVideoServiceChannelEventHandler::Pointer eventHandler)
 {
+    if(this->isSubscribed())
+    {
+        return;
+    }
+
     auto receivePromise = messenger::ReceivePromise::defer(strand_);
     receivePromise->then(std::bind(&VideoServiceChannel::messageHandler, this->shared_from_this(), std::placeholders::_1, eventHandler),
                         std::bind(&IVideoServiceChannelEventHandler::onChannelError, eventHandler, std::placeholders::_1));
@@ -47,6 +52,27 @@ void VideoServiceChannel::receive(IVideoServiceChannelEventHandler::Pointer even
     messenger_->enqueueReceive(channelId_, std::move(receivePromise));
 }
 
+void VideoServiceChannel::subscribe(IVideoServiceChannelEventHandler::Pointer eventHandler)
+{
+    this->startSubscription(std::bind(&VideoServiceChannel::messageHandler, this->shared_from_this(), std::placeholders::_1, eventHandler),
+                            std::bind(&IVideoServiceChannelEventHandler::onChannelError, eventHandler, std::placeholders::_1));
+}
+
+void VideoServiceChannel::subscribe(messenger::ReceiveRing::Pointer ring)
+{
+    this->startSubscription(std::move(ring));
+}
+
+void VideoServiceChannel::unsubscribe()
+{
+    this->stopSubscription();
+}
+
+void VideoServiceChannel::handleMessage(messenger::Message::Pointer message, IVideoServiceChannelEventHandler::Pointer eventHandler)
+{
+    this->messageHandler(std::move(message), std::move(eventHandler));
+}
+
 messenger::ChannelId VideoServiceChannel::getId() const
 {
     return channelId_;
@@ -54,7 +80,7 @@ messenger::ChannelId VideoServiceChannel::getId() const
 
 void VideoServiceChannel::sendChannelOpenResponse(const proto::messages::ChannelOpenResponse& response, SendPromise::Pointer promise)
 {
-    auto message(std::make_shared<messenger::Message>(channelId_, messenger::EncryptionType::ENCRYPTED, messenger::MessageType::CONTROL));
+    auto message(this->createMessage(messenger::EncryptionType::ENCRYPTED, messenger::MessageType::CONTROL));
     message->insertPayload(messenger::MessageId(proto::ids::ControlMessage::CHANNEL_OPEN_RESPONSE).getData());
     message->insertPayload(response);
 
@@ -63,7 +89,7 @@ void VideoServiceChannel::sendChannelOpenResponse(const proto::messages::Channel
 
 void VideoServiceChannel::sendAVChannelSetupResponse(const proto::messages::AVChannelSetupResponse& response, SendPromise::Pointer promise)
 {
-    auto message(std::make_shared<messenger::Message>(channelId_, messenger::EncryptionType::ENCRYPTED, messenger::MessageType::SPECIFIC));
+    auto message(this->createMessage(messenger::EncryptionType::ENCRYPTED, messenger::MessageType::SPECIFIC));
     message->insertPayload(messenger::MessageId(proto::ids::AVChannelMessage::SETUP_RESPONSE).getData());
     message->insertPayload(response);
 
@@ -72,7 +98,7 @@ void VideoServiceChannel::sendAVChannelSetupResponse(const proto::messages::AVCh
 
 void VideoServiceChannel::sendVideoFocusIndication(const proto::messages::VideoFocusIndication& indication, SendPromise::Pointer promise)
 {
-    auto message(std::make_shared<messenger::Message>(channelId_, messenger::EncryptionType::ENCRYPTED, messenger::MessageType::SPECIFIC));
+    auto message(this->createMessage(messenger::EncryptionType::ENCRYPTED, messenger::MessageType::SPECIFIC));
     message->insertPayload(messenger::MessageId(proto::ids::AVChannelMessage::VIDEO_FOCUS_INDICATION).getData());
     message->insertPayload(indication);
 
@@ -81,7 +107,7 @@ void VideoServiceChannel::sendVideoFocusIndication(const proto::messages::VideoF
 
 void VideoServiceChannel::sendAVMediaAckIndication(const proto::messages::AVMediaAckIndication& indication, SendPromise::Pointer promise)
 {
-    auto message(std::make_shared<messenger::Message>(channelId_, messenger::EncryptionType::ENCRYPTED, messenger::MessageType::SPECIFIC));
+    auto message(this->createMessage(messenger::EncryptionType::ENCRYPTED, messenger::MessageType::SPECIFIC));
     message->insertPayload(messenger::MessageId(proto::ids::AVChannelMessage::AV_MEDIA_ACK_INDICATION).getData());
     message->insertPayload(indication);
 
@@ -40,6 +40,11 @@ BluetoothServiceChannel::BluetoothServiceChannel(boost::asio::io_service::strand
 
 void BluetoothServiceChannel::receive(IBluetoothServiceChannelEventHandler::Pointer eventHandler)
 {
+    if(this->isSubscribed())
+    {
+        return;
+    }
+
     auto receivePromise = messenger::ReceivePromise::defer(strand_);
     receivePromise->then(std::bind(&BluetoothServiceChannel::messageHandler, this->shared_from_this(), std::placeholders::_1, eventHandler),
                         std::bind(&IBluetoothServiceChannelEventHandler::onChannelError, eventHandler,std::placeholders::_1));
@@ -47,6 +52,17 @@ void BluetoothServiceChannel::receive(IBluetoothServiceChannelEventHandler::Poin
     messenger_->enqueueReceive(channelId_, std::move(receivePromise));
 }
 
+void BluetoothServiceChannel::subscribe(IBluetoothServiceChannelEventHandler::Pointer eventHandler)
+{
+    this->startSubscription(std::bind(&BluetoothServiceChannel::messageHandler, this->shared_from_this(), std::placeholders::_1, eventHandler),
+                            std::bind(&IBluetoothServiceChannelEventHandler::onChannelError, eventHandler, std::placeholders::_1));
+}
+
+void BluetoothServiceChannel::unsubscribe()
+{
+    this->stopSubscription();
+}
+
 messenger::ChannelId BluetoothServiceChannel::getId() const
 {
     return channelId_;
@@ -54,7 +70,7 @@ messenger::ChannelId BluetoothServiceChannel::getId() const
 
 void BluetoothServiceChannel::sendChannelOpenResponse(const proto::messages::ChannelOpenResponse& response, SendPromise::Pointer promise)
 {
-    auto message(std::make_shared<messenger::Message>(channelId_, messenger::EncryptionType::ENCRYPTED, messenger::MessageType::CONTROL));
+    auto message(this->createMessage(messenger::EncryptionType::ENCRYPTED, messenger::MessageType::CONTROL));
     message->insertPayload(messenger::MessageId(proto::ids::ControlMessage::CHANNEL_OPEN_RESPONSE).getData());
     message->insertPayload(response);
 
@@ -63,7 +79,7 @@ void BluetoothServiceChannel::sendChannelOpenResponse(const proto::messages::Cha
 
 void BluetoothServiceChannel::sendBluetoothPairingResponse(const proto::messages::BluetoothPairingResponse& response, SendPromise::Pointer promise)
 {
-    auto message(std::make_shared<messenger::Message>(channelId_, messenger::EncryptionType::ENCRYPTED, messenger::MessageType::SPECIFIC));
+    auto message(this->createMessage(messenger::EncryptionType::ENCRYPTED, messenger::MessageType::SPECIFIC));
     message->insertPayload(messenger::MessageId(proto::ids::BluetoothChannelMessage::PAIRING_RESPONSE).getData());
     message->insertPayload(response);
 
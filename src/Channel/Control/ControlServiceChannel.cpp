@@ -41,7 +41,7 @@ ControlServiceChannel::ControlServiceChannel(boost::asio::io_service::strand& st
 
 void ControlServiceChannel::sendVersionRequest(SendPromise::Pointer promise)
 {
-    auto message(std::make_shared<messenger::Message>(channelId_, messenger::EncryptionType::PLAIN, messenger::MessageType::SPECIFIC));
+    auto message(this->createMessage(messenger::EncryptionType::PLAIN, messenger::MessageType::SPECIFIC));
     message->insertPayload(messenger::MessageId(proto::ids::ControlMessage::VERSION_REQUEST).getData());
 
     common::Data versionBuffer(4, 0);
@@ -54,7 +54,7 @@ void ControlServiceChannel::sendVersionRequest(SendPromise::Pointer promise)
 
 void ControlServiceChannel::sendHandshake(common::Data handshakeBuffer, SendPromise::Pointer promise)
 {
-    auto message(std::make_shared<messenger::Message>(channelId_, messenger::EncryptionType::PLAIN, messenger::MessageType::SPECIFIC));
+    auto message(this->createMessage(messenger::EncryptionType::PLAIN, messenger::MessageType::SPECIFIC));
     message->insertPayload(messenger::MessageId(proto::ids::ControlMessage::SSL_HANDSHAKE).getData());
     message->insertPayload(handshakeBuffer);
 
@@ -63,7 +63,7 @@ void ControlServiceChannel::sendHandshake(common::Data handshakeBuffer, SendProm
 
 void ControlServiceChannel::sendAuthComplete(const proto::messages::AuthCompleteIndication& response, SendPromise::Pointer promise)
 {
-    auto message(std::make_shared<messenger::Message>(channelId_, messenger::EncryptionType::PLAIN, messenger::MessageType::SPECIFIC));
+    auto message(this->createMessage(messenger::EncryptionType::PLAIN, messenger::MessageType::SPECIFIC));
     message->insertPayload(messenger::MessageId(proto::ids::ControlMessage::AUTH_COMPLETE).getData());
     message->insertPayload(response);
 
@@ -72,7 +72,7 @@ void ControlServiceChannel::sendAuthComplete(const proto::messages::AuthComplete
 
 void ControlServiceChannel::sendServiceDiscoveryResponse(const proto::messages::ServiceDiscoveryResponse& response, SendPromise::Pointer promise)
 {
-    auto message(std::make_shared<messenger::Message>(channelId_, messenger::EncryptionType::ENCRYPTED, messenger::MessageType::SPECIFIC));
+    auto message(this->createMessage(messenger::EncryptionType::ENCRYPTED, messenger::MessageType::SPECIFIC));
     message->insertPayload(messenger::MessageId(proto::ids::ControlMessage::SERVICE_DISCOVERY_RESPONSE).getData());
     message->insertPayload(response);
 
@@ -81,7 +81,7 @@ void ControlServiceChannel::sendServiceDiscoveryResponse(const proto::messages::
 
 void ControlServiceChannel::sendAudioFocusResponse(const proto::messages::AudioFocusResponse& response, SendPromise::Pointer promise)
 {
-    auto message(std::make_shared<messenger::Message>(channelId_, messenger::EncryptionType::ENCRYPTED, messenger::MessageType::SPECIFIC));
+    auto message(this->createMessage(messenger::EncryptionType::ENCRYPTED, messenger::MessageType::SPECIFIC));
     message->insertPayload(messenger::MessageId(proto::ids::ControlMessage::AUDIO_FOCUS_RESPONSE).getData());
     message->insertPayload(response);
 
@@ -90,7 +90,7 @@ void ControlServiceChannel::sendAudioFocusResponse(const proto::messages::AudioF
 
 void ControlServiceChannel::sendShutdownRequest(const proto::messages::ShutdownRequest& request, SendPromise::Pointer promise)
 {
-    auto message(std::make_shared<messenger::Message>(channelId_, messenger::EncryptionType::ENCRYPTED, messenger::MessageType::SPECIFIC));
+    auto message(this->createMessage(messenger::EncryptionType::ENCRYPTED, messenger::MessageType::SPECIFIC));
     message->insertPayload(messenger::MessageId(proto::ids::ControlMessage::SHUTDOWN_REQUEST).getData());
     message->insertPayload(request);
 
@@ -99,7 +99,7 @@ void ControlServiceChannel::sendShutdownRequest(const proto::messages::ShutdownR
 
 void ControlServiceChannel::sendShutdownResponse(const proto::messages::ShutdownResponse& response, SendPromise::Pointer promise)
 {
-    auto message(std::make_shared<messenger::Message>(channelId_, messenger::EncryptionType::ENCRYPTED, messenger::MessageType::SPECIFIC));
+    auto message(this->createMessage(messenger::EncryptionType::ENCRYPTED, messenger::MessageType::SPECIFIC));
     message->insertPayload(messenger::MessageId(proto::ids::ControlMessage::SHUTDOWN_RESPONSE).getData());
     message->insertPayload(response);
 
@@ -108,7 +108,7 @@ void ControlServiceChannel::sendShutdownResponse(const proto::messages::Shutdown
 
 void ControlServiceChannel::sendNavigationFocusResponse(const proto::messages::NavigationFocusResponse& response, SendPromise::Pointer promise)
 {
-    auto message(std::make_shared<messenger::Message>(channelId_, messenger::EncryptionType::ENCRYPTED, messenger::MessageType::SPECIFIC));
+    auto message(this->createMessage(messenger::EncryptionType::ENCRYPTED, messenger::MessageType::SPECIFIC));
     message->insertPayload(messenger::MessageId(proto::ids::ControlMessage::NAVIGATION_FOCUS_RESPONSE).getData());
     message->insertPayload(response);
 
@@ -117,7 +117,7 @@ void ControlServiceChannel::sendNavigationFocusResponse(const proto::messages::N
 
 void ControlServiceChannel::sendPingRequest(const proto::messages::PingRequest& request, SendPromise::Pointer promise)
 {
-    auto message(std::make_shared<messenger::Message>(channelId_, messenger::EncryptionType::PLAIN, messenger::MessageType::SPECIFIC));
+    auto message(this->createMessage(messenger::EncryptionType::PLAIN, messenger::MessageType::SPECIFIC));
     message->insertPayload(messenger::MessageId(proto::ids::ControlMessage::PING_REQUEST).getData());
     message->insertPayload(request);
 
@@ -126,6 +126,11 @@ void ControlServiceChannel::sendPingRequest(const proto::messages::PingRequest&
 
 void ControlServiceChannel::receive(IControlServiceChannelEventHandler::Pointer eventHandler)
 {
+    if(this->isSubscribed())
+    {
+        return;
+    }
+
     auto receivePromise  = messenger::ReceivePromise::defer(strand_);
     receivePromise->then(std::bind(&ControlServiceChannel::messageHandler, this->shared_from_this(), std::placeholders::_1, eventHandler),
                         std::bind(&IControlServiceChannelEventHandler::onChannelError, eventHandler, std::placeholders::_1));
@@ -133,6 +138,17 @@ void ControlServiceChannel::receive(IControlServiceChannelEventHandler::Pointer
     messenger_->enqueueReceive(channelId_, std::move(receivePromise));
 }
 
+void ControlServiceChannel::subscribe(IControlServiceChannelEventHandler::Pointer eventHandler)
+{
+    this->startSubscription(std::bind(&ControlServiceChannel::messageHandler, this->shared_from_this(), std::placeholders::_1, eventHandler),
+                            std::bind(&IControlServiceChannelEventHandler::onChannelError, eventHandler, std::placeholders::_1));
+}
+
+void ControlServiceChannel::unsubscribe()
+{
+    this->stopSubscription();
+}
+
 void ControlServiceChannel::messageHandler(messenger::Message::Pointer message, IControlServiceChannelEventHandler::Pointer eventHandler)
 {
     messenger::MessageId messageId(message->getPayload());
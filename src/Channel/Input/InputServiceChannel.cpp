@@ -40,6 +40,11 @@ InputServiceChannel::InputServiceChannel(boost::asio::io_service::strand& strand
 
 void InputServiceChannel::receive(IInputServiceChannelEventHandler::Pointer eventHandler)
 {
+    if(this->isSubscribed())
+    {
+        return;
+    }
+
     auto receivePromise = messenger::ReceivePromise::defer(strand_);
     receivePromise->then(std::bind(&InputServiceChannel::messageHandler, this->shared_from_this(), std::placeholders::_1, eventHandler),
                         std::bind(&IInputServiceChannelEventHandler::onChannelError, eventHandler, std::placeholders::_1));
@@ -47,6 +52,17 @@ void InputServiceChannel::receive(IInputServiceChannelEventHandler::Pointer even
     messenger_->enqueueReceive(channelId_, std::move(receivePromise));
 }
 
+void InputServiceChannel::subscribe(IInputServiceChannelEventHandler::Pointer eventHandler)
+{
+    this->startSubscription(std::bind(&InputServiceChannel::messageHandler, this->shared_from_this(), std::placeholders::_1, eventHandler),
+                            std::bind(&IInputServiceChannelEventHandler::onChannelError, eventHandler, std::placeholders::_1));
+}
+
+void InputServiceChannel::unsubscribe()
+{
+    this->stopSubscription();
+}
+
 messenger::ChannelId InputServiceChannel::getId() const
 {
     return channelId_;
@@ -54,7 +70,7 @@ messenger::ChannelId InputServiceChannel::getId() const
 
 void InputServiceChannel::sendInputEventIndication(const proto::messages::InputEventIndication& indication, SendPromise::Pointer promise)
 {
-    auto message(std::make_shared<messenger::Message>(channelId_, messenger::EncryptionType::ENCRYPTED, messenger::MessageType::SPECIFIC));
+    auto message(this->createMessage(messenger::EncryptionType::ENCRYPTED, messenger::MessageType::SPECIFIC));
     message->insertPayload(messenger::MessageId(proto::ids::InputChannelMessage::INPUT_EVENT_INDICATION).getData());
     message->insertPayload(indication);
 
@@ -63,7 +79,7 @@ void InputServiceChannel::sendInputEventIndication(const proto::messages::InputE
 
 void InputServiceChannel::sendBindingResponse(const proto::messages::BindingResponse& response, SendPromise::Pointer promise)
 {
-    auto message(std::make_shared<messenger::Message>(channelId_, messenger::EncryptionType::ENCRYPTED, messenger::MessageType::SPECIFIC));
+    auto message(this->createMessage(messenger::EncryptionType::ENCRYPTED, messenger::MessageType::SPECIFIC));
     message->insertPayload(messenger::MessageId(proto::ids::InputChannelMessage::BINDING_RESPONSE).getData());
     message->insertPayload(response);
 
@@ -72,7 +88,7 @@ void InputServiceChannel::sendBindingResponse(const proto::messages::BindingResp
 
 void InputServiceChannel::sendChannelOpenResponse(const proto::messages::ChannelOpenResponse& response, SendPromise::Pointer promise)
 {
-    auto message(std::make_shared<messenger::Message>(channelId_, messenger::EncryptionType::ENCRYPTED, messenger::MessageType::CONTROL));
+    auto message(this->createMessage(messenger::EncryptionType::ENCRYPTED, messenger::MessageType::CONTROL));
     message->insertPayload(messenger::MessageId(proto::ids::ControlMessage::CHANNEL_OPEN_RESPONSE).getData());
     message->insertPayload(response);
 
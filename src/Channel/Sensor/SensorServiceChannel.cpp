@@ -40,6 +40,11 @@ SensorServiceChannel::SensorServiceChannel(boost::asio::io_service::strand& stra
 
 void SensorServiceChannel::receive(ISensorServiceChannelEventHandler::Pointer eventHandler)
 {
+    if(this->isSubscribed())
+    {
+        return;
+    }
+
     auto receivePromise = messenger::ReceivePromise::defer(strand_);
     receivePromise->then(std::bind(&SensorServiceChannel::messageHandler, this->shared_from_this(), std::placeholders::_1, eventHandler),
                         std::bind(&ISensorServiceChannelEventHandler::onChannelError, eventHandler, std::placeholders::_1));
@@ -47,6 +52,17 @@ void SensorServiceChannel::receive(ISensorServiceChannelEventHandler::Pointer ev
     messenger_->enqueueReceive(channelId_, std::move(receivePromise));
 }
 
+void SensorServiceChannel::subscribe(ISensorServiceChannelEventHandler::Pointer eventHandler)
+{
+    this->startSubscription(std::bind(&SensorServiceChannel::messageHandler, this->shared_from_this(), std::placeholders::_1, eventHandler),
+                            std::bind(&ISensorServiceChannelEventHandler::onChannelError, eventHandler, std::placeholders::_1));
+}
+
+void SensorServiceChannel::unsubscribe()
+{
+    this->stopSubscription();
+}
+
 messenger::ChannelId SensorServiceChannel::getId() const
 {
     return channelId_;
@@ -54,7 +70,7 @@ messenger::ChannelId SensorServiceChannel::getId() const
 
 void SensorServiceChannel::sendChannelOpenResponse(const proto::messages::ChannelOpenResponse& response, SendPromise::Pointer promise)
 {
-    auto message(std::make_shared<messenger::Message>(channelId_, messenger::EncryptionType::ENCRYPTED, messenger::MessageType::CONTROL));
+    auto message(this->createMessage(messenger::EncryptionType::ENCRYPTED, messenger::MessageType::CONTROL));
     message->insertPayload(messenger::MessageId(proto::ids::ControlMessage::CHANNEL_OPEN_RESPONSE).getData());
     message->insertPayload(response);
 
@@ -83,7 +99,7 @@ void SensorServiceChannel::messageHandler(messenger::Message::Pointer message, I
 
 void SensorServiceChannel::sendSensorEventIndication(const proto::messages::SensorEventIndication& indication, SendPromise::Pointer promise)
 {
-    auto message(std::make_shared<messenger::Message>(channelId_, messenger::EncryptionType::ENCRYPTED, messenger::MessageType::SPECIFIC));
+    auto message(this->createMessage(messenger::EncryptionType::ENCRYPTED, messenger::MessageType::SPECIFIC));
     message->insertPayload(messenger::MessageId(proto::ids::SensorChannelMessage::SENSOR_EVENT_INDICATION).getData());
     message->insertPayload(indication);
 
@@ -92,7 +108,7 @@ void SensorServiceChannel::sendSensorEventIndication(const proto::messages::Sens
 
 void SensorServiceChannel::sendSensorStartResponse(const proto::messages::SensorStartResponseMessage& response, SendPromise::Pointer promise)
 {
-    auto message(std::make_shared<messenger::Message>(channelId_, messenger::EncryptionType::ENCRYPTED, messenger::MessageType::SPECIFIC));
+    auto message(this->createMessage(messenger::EncryptionType::ENCRYPTED, messenger::MessageType::SPECIFIC));
     message->insertPayload(messenger::MessageId(proto::ids::SensorChannelMessage::SENSOR_START_RESPONSE).getData());
     message->insertPayload(response);
 
@@ -36,13 +36,67 @@ ServiceChannel::ServiceChannel(boost::asio::io_service::strand& strand,
 
 }
 
+messenger::Message::Pointer ServiceChannel::createMessage(messenger::EncryptionType encryptionType, messenger::MessageType type, size_t payloadSize)
+{
+    return messenger_->createMessage(channelId_, encryptionType, type, payloadSize);
+}
+
 void ServiceChannel::send(messenger::Message::Pointer message, SendPromise::Pointer promise)
 {
-    auto sendPromise = messenger::SendPromise::defer(strand_.context());
+    auto sendPromise = messenger::SendPromise::defer(strand_.context(), io::PromiseResolution::DISPATCH);
     io::PromiseLink<>::forward(*sendPromise, std::move(promise));
     messenger_->enqueueSend(std::move(message), std::move(sendPromise));
 }
 
+void ServiceChannel::bindExecutor(io::WorkStealingExecutor::Strand::Pointer executorStrand)
+{
+    std::lock_guard<std::mutex> lock(subscriptionMutex_);
+    executorStrand_ = std::move(executorStrand);
+}
+
+void ServiceChannel::startSubscription(messenger::ReceiveSubscription::MessageHandler messageHandler, messenger::ReceiveSubscription::ErrorHandler errorHandler)
+{
+    io::WorkStealingExecutor::Strand::Pointer executorStrand;
+
+    {
+        std::lock_guard<std::mutex> lock(subscriptionMutex_);
+        executorStrand = executorStrand_;
+    }
+
+    if(executorStrand != nullptr)
+    {
+        this->startSubscription(std::make_shared<messenger::ExecutorReceiveSubscription>(std::move(executorStrand), std::move(messageHandler), std::move(errorHandler)));
+    }
+    else
+    {
+        this->startSubscription(std::make_shared<messenger::ReceiveSubscription>(strand_, std::move(messageHandler), std::move(errorHandler)));
+    }
+}
+
+void ServiceChannel::startSubscription(messenger::IReceiveSubscription::Pointer subscription)
+{
+    std::lock_guard<std::mutex> lock(subscriptionMutex_);
+    subscription_ = subscription;
+    messenger_->subscribe(channelId_, std::move(subscription));
+}
+
+void ServiceChannel::stopSubscription()
+{
+    std::lock_guard<std::mutex> lock(subscriptionMutex_);
+    if(subscription_ != nullptr)
+    {
+        subscription_->cancel();
+        subscription_.reset();
+        messenger_->unsubscribe(channelId_);
+    }
+}
+
+bool ServiceChannel::isSubscribed() const
+{
+    std::lock_guard<std::mutex> lock(subscriptionMutex_);
+    return subscription_ != nullptr && !subscription_->isCancelled();
+}
+
 }
 }
 }
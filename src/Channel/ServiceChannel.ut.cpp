@@ -0,0 +1,104 @@
+/*
+*  This file is part of aasdk library project.
+*  Copyright (C) 2018 f1x.studio (Michal Szwaj)
+*
+*  aasdk is free software: you can redistribute it and/or modify
+*  it under the terms of the GNU General Public License as published by
+*  the Free Software Foundation; either version 3 of the License, or
+*  (at your option) any later version.
+
+*  aasdk is distributed in the hope that it will be useful,
+*  but WITHOUT ANY WARRANTY; without even the implied warranty of
+*  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+*  GNU General Public License for more details.
+*
+*  You should have received a copy of the GNU General Public License
+*  along with aasdk. If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include <future>
+#include <vector>
+#include <boost/test/unit_test.hpp>
+#include <f1x/aasdk/Messenger/UT/MessageInStream.mock.hpp>
+#include <f1x/aasdk/Messenger/UT/MessageOutStream.mock.hpp>
+#include <f1x/aasdk/Channel/UT/LoopbackServiceChannel.hpp>
+#include <f1x/aasdk/IO/WorkStealingExecutor.hpp>
+#include <f1x/aasdk/Messenger/Messenger.hpp>
+
+namespace f1x
+{
+namespace aasdk
+{
+namespace channel
+{
+namespace ut
+{
+
+using ::testing::_;
+using ::testing::SaveArg;
+
+class ServiceChannelUnitTest
+{
+protected:
+    ServiceChannelUnitTest()
+        : strand_(ioService_)
+        , messageInStream_(&messageInStreamMock_, [](auto*) {})
+        , messageOutStream_(&messageOutStreamMock_, [](auto*) {})
+        , messenger_(std::make_shared<messenger::Messenger>(ioService_, messageInStream_, messageOutStream_))
+    {
+
+    }
+
+    boost::asio::io_service ioService_;
+    boost::asio::io_service::strand strand_;
+    messenger::ut::MessageInStreamMock messageInStreamMock_;
+    messenger::IMessageInStream::Pointer messageInStream_;
+    messenger::ut::MessageOutStreamMock messageOutStreamMock_;
+    messenger::IMessageOutStream::Pointer messageOutStream_;
+    messenger::Messenger::Pointer messenger_;
+};
+
+BOOST_FIXTURE_TEST_CASE(ServiceChannel_BoundExecutorDeliversInOrder, ServiceChannelUnitTest)
+{
+    const size_t cMessagesCount = 1000;
+
+    io::WorkStealingExecutor executor(4);
+    auto executorStrand = executor.createStrand();
+    LoopbackServiceChannel channel(strand_, messenger_);
+    channel.bindExecutor(executorStrand);
+
+    std::vector<messenger::Message::Pointer> receivedMessages;
+    std::promise<void> done;
+
+    channel.startSubscription([&](messenger::Message::Pointer message) {
+        BOOST_CHECK(executorStrand->isRunningInThisThread());
+        receivedMessages.push_back(std::move(message));
+
+        if(receivedMessages.size() == cMessagesCount)
+        {
+            done.set_value();
+        }
+    }, [](const error::Error&) {});
+
+    messenger::IMessageInStream::MessageHandler loopMessageHandler;
+    EXPECT_CALL(messageInStreamMock_, startReceiveLoop(_, _)).WillOnce(SaveArg<0>(&loopMessageHandler));
+    ioService_.run();
+    ioService_.reset();
+    BOOST_REQUIRE(loopMessageHandler != nullptr);
+
+    std::vector<messenger::Message::Pointer> sentMessages;
+
+    for(size_t i = 0; i < cMessagesCount; ++i)
+    {
+        sentMessages.push_back(std::make_shared<messenger::Message>(messenger::ChannelId::VIDEO, messenger::EncryptionType::ENCRYPTED, messenger::MessageType::SPECIFIC));
+        loopMessageHandler(sentMessages.back());
+    }
+
+    BOOST_REQUIRE(done.get_future().wait_for(std::chrono::seconds(5)) == std::future_status::ready);
+    BOOST_CHECK(receivedMessages == sentMessages);
+}
+
+}
+}
+}
+}
@@ -0,0 +1,62 @@
+/*
+*  This file is part of aasdk library project.
+*  Copyright (C) 2018 f1x.studio (Michal Szwaj)
+*
+*  aasdk is free software: you can redistribute it and/or modify
+*  it under the terms of the GNU General Public License as published by
+*  the Free Software Foundation; either version 3 of the License, or
+*  (at your option) any later version.
+
+*  aasdk is distributed in the hope that it will be useful,
+*  but WITHOUT ANY WARRANTY; without even the implied warranty of
+*  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+*  GNU General Public License for more details.
+*
+*  You should have received a copy of the GNU General Public License
+*  along with aasdk. If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include <algorithm>
+#include <f1x/aasdk/Common/DataChain.hpp>
+
+namespace f1x
+{
+namespace aasdk
+{
+namespace common
+{
+
+DataSegment::DataSegment(std::shared_ptr<Data> _storage)
+    : storage(std::move(_storage))
+    , buffer(*storage)
+{
+
+}
+
+DataSegment::DataSegment(std::shared_ptr<Data> _storage, Data::size_type offset, Data::size_type _size)
+    : storage(std::move(_storage))
+    , buffer(storage->empty() ? nullptr : &(*storage)[0], std::min(offset + _size, storage->size()), offset)
+{
+
+}
+
+bool DataSegment::isWhole() const
+{
+    return !storage->empty() && buffer.cdata == &(*storage)[0] && buffer.size == storage->size();
+}
+
+size_t getSize(const DataChain& chain)
+{
+    size_t size = 0;
+
+    for(const auto& segment : chain)
+    {
+        size += segment.buffer.size;
+    }
+
+    return size;
+}
+
+}
+}
+}
@@ -16,6 +16,7 @@
 *  along with aasdk. If not, see <http://www.gnu.org/licenses/>.
 */
 
+#include <cstdio>
 #include <f1x/aasdk/Error/Error.hpp>
 
 namespace f1x
@@ -25,52 +26,53 @@ namespace aasdk
 namespace error
 {
 
-Error::Error()
+Error::Error() noexcept
     : code_(ErrorCode::NONE)
     , nativeCode_(0)
+    , message_{}
 {
 
 }
 
-Error::Error(ErrorCode code, uint32_t nativeCode)
+Error::Error(ErrorCode code, uint32_t nativeCode) noexcept
     : code_(code)
     , nativeCode_(nativeCode)
+    , message_{}
 {
-    message_ = "AaSdk error code: " + std::to_string(static_cast<uint32_t>(code_))
-                + ", native code: " + std::to_string(nativeCode_);
+    snprintf(message_, sizeof(message_), "AaSdk error code: %u, native code: %u", static_cast<uint32_t>(code_), nativeCode_);
 }
 
-ErrorCode Error::getCode() const
+ErrorCode Error::getCode() const noexcept
 {
     return code_;
 }
 
-uint32_t Error::getNativeCode() const
+uint32_t Error::getNativeCode() const noexcept
 {
     return nativeCode_;
 }
 
 const char* Error::what() const noexcept
 {
-    return message_.c_str();
+    return message_;
 }
 
-bool Error::operator!() const
+bool Error::operator!() const noexcept
 {
     return code_ == ErrorCode::NONE;
 }
 
-bool Error::operator==(const Error& other) const
+bool Error::operator==(const Error& other) const noexcept
 {
     return code_ == other.code_ && nativeCode_ == other.nativeCode_;
 }
 
-bool Error::operator==(const ErrorCode& code) const
+bool Error::operator==(const ErrorCode& code) const noexcept
 {
     return code_ == code;
 }
 
-bool Error::operator!=(const ErrorCode& code) const
+bool Error::operator!=(const ErrorCode& code) const noexcept
 {
     return !operator==(code);
 }
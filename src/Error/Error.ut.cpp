@@ -0,0 +1,50 @@
+/*
+*  This file is part of aasdk library project.
+*  Copyright (C) 2018 f1x.studio (Michal Szwaj)
+*
+*  aasdk is free software: you can redistribute it and/or modify
+*  it under the terms of the GNU General Public License as published by
+*  the Free Software Foundation; either version 3 of the License, or
+*  (at your option) any later version.
+
+*  aasdk is distributed in the hope that it will be useful,
+*  but WITHOUT ANY WARRANTY; without even the implied warranty of
+*  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+*  GNU General Public License for more details.
+*
+*  You should have received a copy of the GNU General Public License
+*  along with aasdk. If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include <cstring>
+#include <boost/test/unit_test.hpp>
+#include <f1x/aasdk/Error/Error.hpp>
+
+namespace f1x
+{
+namespace aasdk
+{
+namespace error
+{
+namespace ut
+{
+
+BOOST_AUTO_TEST_CASE(Error_FormatMessage)
+{
+    const Error error(ErrorCode::SSL_READ, 5);
+    BOOST_CHECK_EQUAL(error.what(), "AaSdk error code: " + std::to_string(static_cast<uint32_t>(ErrorCode::SSL_READ)) + ", native code: 5");
+
+    const Error copy(error);
+    BOOST_CHECK_EQUAL(std::strcmp(copy.what(), error.what()), 0);
+}
+
+BOOST_AUTO_TEST_CASE(Error_FormatNoneMessage)
+{
+    BOOST_CHECK_EQUAL(Error(ErrorCode::NONE).what(), "AaSdk error code: 0, native code: 0");
+    BOOST_CHECK_EQUAL(Error().what(), "");
+}
+
+}
+}
+}
+}
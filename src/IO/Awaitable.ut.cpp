@@ -0,0 +1,116 @@
+/*
+*  This file is part of aasdk library project.
+*  Copyright (C) 2018 f1x.studio (Michal Szwaj)
+*
+*  aasdk is free software: you can redistribute it and/or modify
+*  it under the terms of the GNU General Public License as published by
+*  the Free Software Foundation; either version 3 of the License, or
+*  (at your option) any later version.
+
+*  aasdk is distributed in the hope that it will be useful,
+*  but WITHOUT ANY WARRANTY; without even the implied warranty of
+*  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+*  GNU General Public License for more details.
+*
+*  You should have received a copy of the GNU General Public License
+*  along with aasdk. If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#if defined(__cpp_impl_coroutine)
+
+#include <boost/test/unit_test.hpp>
+#include <f1x/aasdk/IO/Awaitable.hpp>
+#include <f1x/aasdk/Transport/Awaitable.hpp>
+#include <f1x/aasdk/Transport/UT/LoopbackTransport.hpp>
+
+namespace f1x
+{
+namespace aasdk
+{
+namespace io
+{
+namespace ut
+{
+
+class AwaitableUnitTest
+{
+protected:
+    AwaitableUnitTest()
+        : strand_(ioService_)
+    { }
+
+    void run()
+    {
+        ioService_.run();
+        ioService_.reset();
+    }
+
+    boost::asio::io_service ioService_;
+    boost::asio::io_service::strand strand_;
+};
+
+BOOST_FIXTURE_TEST_CASE(Awaitable_ResumeWithResolvedValue, AwaitableUnitTest)
+{
+    Promise<size_t>::Pointer pendingPromise;
+    size_t result = 0;
+
+    auto coroutine = [&]() -> Task {
+        result = co_await async<size_t>(strand_, [&](Promise<size_t>::Pointer promise) { pendingPromise = std::move(promise); });
+    };
+
+    strand_.dispatch([&]() { coroutine(); });
+    this->run();
+    BOOST_REQUIRE(pendingPromise != nullptr);
+    BOOST_CHECK_EQUAL(result, 0u);
+
+    pendingPromise->resolve(9);
+    this->run();
+    BOOST_CHECK_EQUAL(result, 9u);
+}
+
+BOOST_FIXTURE_TEST_CASE(Awaitable_ThrowRejectedError, AwaitableUnitTest)
+{
+    error::Error result;
+
+    auto coroutine = [&]() -> Task {
+        try
+        {
+            co_await async<void>(strand_, [](Promise<void>::Pointer promise) { promise->reject(error::Error(error::ErrorCode::OPERATION_ABORTED)); });
+        }
+        catch(const error::Error& e)
+        {
+            result = e;
+        }
+    };
+
+    strand_.dispatch([&]() { coroutine(); });
+    this->run();
+    BOOST_CHECK(result == error::ErrorCode::OPERATION_ABORTED);
+}
+
+BOOST_FIXTURE_TEST_CASE(Awaitable_TransportLoop, AwaitableUnitTest)
+{
+    auto transport(std::make_shared<transport::ut::LoopbackTransport>(ioService_));
+    const common::Data payload{0x01, 0x02, 0x03, 0x04};
+    common::Data received;
+
+    auto coroutine = [&]() -> Task {
+        for(const auto& value : payload)
+        {
+            co_await transport::asyncSend(transport, common::Data(1, value), strand_);
+            auto data = co_await transport::asyncReceive(transport, 1, strand_);
+            received.insert(received.end(), data.begin(), data.end());
+        }
+    };
+
+    strand_.dispatch([&]() { coroutine(); });
+    this->run();
+    BOOST_CHECK(received == payload);
+}
+
+}
+}
+}
+}
+
+#endif
@@ -57,6 +57,20 @@ bool IOContextWrapper::isActive() const
     return ioService_ != nullptr || strand_ != nullptr;
 }
 
+bool IOContextWrapper::isRunningInThisThread() const
+{
+    if(strand_ != nullptr)
+    {
+        return strand_->running_in_this_thread();
+    }
+
+#if BOOST_ASIO_VERSION >= 101100
+    return ioService_ != nullptr && ioService_->get_executor().running_in_this_thread();
+#else
+    return false;
+#endif
+}
+
 }
 }
 }
@@ -0,0 +1,131 @@
+/*
+*  This file is part of aasdk library project.
+*  Copyright (C) 2018 f1x.studio (Michal Szwaj)
+*
+*  aasdk is free software: you can redistribute it and/or modify
+*  it under the terms of the GNU General Public License as published by
+*  the Free Software Foundation; either version 3 of the License, or
+*  (at your option) any later version.
+
+*  aasdk is distributed in the hope that it will be useful,
+*  but WITHOUT ANY WARRANTY; without even the implied warranty of
+*  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+*  GNU General Public License for more details.
+*
+*  You should have received a copy of the GNU General Public License
+*  along with aasdk. If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include <iostream>
+#include <boost/test/unit_test.hpp>
+#include <f1x/aasdk/Common/Data.hpp>
+#include <f1x/aasdk/Common/UT/AllocationCounter.hpp>
+#include <f1x/aasdk/Common/UT/Benchmark.hpp>
+#include <f1x/aasdk/IO/Promise.hpp>
+#include <f1x/aasdk/IO/PromiseLink.hpp>
+#include <f1x/aasdk/IO/Awaitable.hpp>
+
+namespace f1x
+{
+namespace aasdk
+{
+namespace io
+{
+namespace ut
+{
+
+template<typename FunctionType>
+void benchmarkPromise(const std::string& name, FunctionType&& function)
+{
+    const size_t cIterations = 200000;
+
+    function();
+    common::ut::AllocationCounter allocationCounter;
+    common::ut::runBenchmark(name, cIterations, 0, function);
+    const auto allocationsCount = allocationCounter.getCount();
+
+    std::cout << std::left << std::setw(48) << (name + " allocations")
+              << std::right << std::setw(12) << std::fixed << std::setprecision(2)
+              << static_cast<double>(allocationsCount) / cIterations << " /op" << std::endl;
+}
+
+BOOST_AUTO_TEST_CASE(Promise_ResolveLatency)
+{
+    boost::asio::io_service ioService;
+    boost::asio::io_service::strand strand(ioService);
+    size_t resolvedCount = 0;
+
+    benchmarkPromise("Promise<void> resolve on io_service", [&]() {
+        auto promise = Promise<void>::defer(ioService);
+        promise->then([&resolvedCount]() { ++resolvedCount; }, [](const error::Error&) {});
+        promise->resolve();
+        ioService.poll();
+        ioService.reset();
+    });
+
+    benchmarkPromise("Promise<void> resolve on strand", [&]() {
+        auto promise = Promise<void>::defer(strand);
+        promise->then([&resolvedCount]() { ++resolvedCount; }, [](const error::Error&) {});
+        promise->resolve();
+        ioService.poll();
+        ioService.reset();
+    });
+
+    auto self = std::make_shared<size_t>(0);
+    common::Data data(64, 0x5A);
+
+    benchmarkPromise("Promise<Data> resolve with bound owner", [&]() {
+        auto promise = Promise<common::Data>::defer(strand);
+        promise->then([&resolvedCount, self](common::Data data) { resolvedCount += data.size(); },
+                      [self](const error::Error&) {});
+        promise->resolve(data);
+        ioService.poll();
+        ioService.reset();
+    });
+
+    benchmarkPromise("Promise<void> reject on strand", [&]() {
+        auto promise = Promise<void>::defer(strand);
+        promise->then([]() {}, [&resolvedCount](const error::Error&) { ++resolvedCount; });
+        promise->reject(error::Error(error::ErrorCode::OPERATION_ABORTED));
+        ioService.poll();
+        ioService.reset();
+    });
+
+    benchmarkPromise("PromiseLink<void> forward and resolve", [&]() {
+        auto source = Promise<void>::defer(strand);
+        auto destination = Promise<void>::defer(strand);
+        destination->then([&resolvedCount]() { ++resolvedCount; }, [](const error::Error&) {});
+        PromiseLink<>::forward(*source, std::move(destination));
+        source->resolve();
+        ioService.poll();
+        ioService.reset();
+    });
+
+    BOOST_CHECK_GT(resolvedCount, 0u);
+}
+
+#if defined(__cpp_impl_coroutine)
+BOOST_AUTO_TEST_CASE(Promise_AwaitLatency)
+{
+    boost::asio::io_service ioService;
+    boost::asio::io_service::strand strand(ioService);
+    size_t resolvedCount = 0;
+
+    auto coroutine = [&]() -> Task {
+        resolvedCount += co_await async<size_t>(strand, [](Promise<size_t>::Pointer promise) { promise->resolve(1); });
+    };
+
+    benchmarkPromise("co_await Promise<size_t> on strand", [&]() {
+        coroutine();
+        ioService.poll();
+        ioService.reset();
+    });
+
+    BOOST_CHECK_GT(resolvedCount, 0u);
+}
+#endif
+
+}
+}
+}
+}
@@ -0,0 +1,219 @@
+/*
+*  This file is part of aasdk library project.
+*  Copyright (C) 2018 f1x.studio (Michal Szwaj)
+*
+*  aasdk is free software: you can redistribute it and/or modify
+*  it under the terms of the GNU General Public License as published by
+*  the Free Software Foundation; either version 3 of the License, or
+*  (at your option) any later version.
+
+*  aasdk is distributed in the hope that it will be useful,
+*  but WITHOUT ANY WARRANTY; without even the implied warranty of
+*  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+*  GNU General Public License for more details.
+*
+*  You should have received a copy of the GNU General Public License
+*  along with aasdk. If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include <algorithm>
+#include <array>
+#include <thread>
+#include <vector>
+#include <boost/test/unit_test.hpp>
+#include <f1x/aasdk/Common/Data.hpp>
+#include <f1x/aasdk/IO/Promise.hpp>
+
+namespace f1x
+{
+namespace aasdk
+{
+namespace io
+{
+namespace ut
+{
+
+class PromiseUnitTest
+{
+protected:
+    PromiseUnitTest()
+        : strand_(ioService_)
+    { }
+
+    void run()
+    {
+        ioService_.run();
+        ioService_.reset();
+    }
+
+    boost::asio::io_service ioService_;
+    boost::asio::io_service::strand strand_;
+};
+
+BOOST_FIXTURE_TEST_CASE(Promise_ResolveOnStrand, PromiseUnitTest)
+{
+    auto promise = Promise<common::Data>::defer(strand_);
+    common::Data result;
+    bool isRejected = false;
+
+    promise->then([&](common::Data data) { result = std::move(data); }, [&](const error::Error&) { isRejected = true; });
+    promise->resolve(common::Data{0x01, 0x02, 0x03});
+    BOOST_CHECK(result.empty());
+
+    this->run();
+    BOOST_CHECK(result == common::Data({0x01, 0x02, 0x03}));
+    BOOST_CHECK(!isRejected);
+}
+
+BOOST_FIXTURE_TEST_CASE(Promise_AcceptCopyableAndMoveOnlyHandlers, PromiseUnitTest)
+{
+    size_t resolveCount = 0;
+    const Promise<void>::ResolveHandler resolveHandler = [&]() { ++resolveCount; };
+    const Promise<void>::RejectHandler rejectHandler = [](const error::Error&) { BOOST_FAIL("rejected"); };
+
+    auto promise = Promise<void>::defer(ioService_);
+    promise->then(resolveHandler, rejectHandler);
+    promise->resolve();
+
+    auto otherPromise = Promise<void>::defer(ioService_);
+    otherPromise->then(resolveHandler);
+    otherPromise->resolve();
+
+    auto value = std::make_unique<int>(5);
+    int result = 0;
+    auto movePromise = Promise<void>::defer(ioService_);
+    movePromise->then([&result, value = std::move(value)]() { result = *value; });
+    movePromise->resolve();
+
+    this->run();
+    BOOST_CHECK_EQUAL(resolveCount, 2u);
+    BOOST_CHECK_EQUAL(result, 5);
+}
+
+BOOST_FIXTURE_TEST_CASE(Promise_CompleteOnlyOnce, PromiseUnitTest)
+{
+    auto promise = Promise<void>::defer(ioService_);
+    size_t resolveCount = 0;
+    error::Error rejectError;
+
+    promise->then([&]() { ++resolveCount; }, [&](const error::Error& e) { rejectError = e; });
+    promise->reject(error::Error(error::ErrorCode::OPERATION_ABORTED));
+    promise->resolve();
+    promise->reject(error::Error(error::ErrorCode::OPERATION_IN_PROGRESS));
+
+    this->run();
+    BOOST_CHECK_EQUAL(resolveCount, 0u);
+    BOOST_CHECK(rejectError == error::ErrorCode::OPERATION_ABORTED);
+}
+
+BOOST_FIXTURE_TEST_CASE(Promise_IgnoreHandlersSetAfterCompletion, PromiseUnitTest)
+{
+    auto promise = Promise<void, void>::defer(strand_);
+    bool isResolved = false;
+
+    promise->resolve();
+    promise->then([&]() { isResolved = true; });
+
+    this->run();
+    BOOST_CHECK(!isResolved);
+}
+
+BOOST_FIXTURE_TEST_CASE(Promise_ReleaseHandlersAfterCompletion, PromiseUnitTest)
+{
+    auto promise = Promise<size_t>::defer(strand_);
+    auto owner = std::make_shared<int>(0);
+    std::array<uint8_t, 256> largeCapture{};
+    size_t result = 0;
+
+    promise->then([&result, owner, largeCapture](size_t value) { result = value + largeCapture[0]; },
+                  [owner](const error::Error&) {});
+    BOOST_CHECK_EQUAL(owner.use_count(), 3);
+
+    promise->resolve(7);
+    BOOST_CHECK_EQUAL(owner.use_count(), 2);
+
+    this->run();
+    BOOST_CHECK_EQUAL(result, 7u);
+    BOOST_CHECK_EQUAL(owner.use_count(), 1);
+}
+
+BOOST_FIXTURE_TEST_CASE(Promise_DispatchInsideStrand, PromiseUnitTest)
+{
+    auto promise = Promise<size_t>::defer(strand_, PromiseResolution::DISPATCH);
+    size_t result = 0;
+    promise->then([&result](size_t value) { result = value; });
+
+    promise->resolve(1);
+    BOOST_CHECK_EQUAL(result, 0u);
+    this->run();
+    BOOST_CHECK_EQUAL(result, 1u);
+
+    promise = Promise<size_t>::defer(strand_, PromiseResolution::DISPATCH);
+    promise->then([&result](size_t value) { result = value; });
+
+    strand_.post([&]() {
+        promise->resolve(2);
+        BOOST_CHECK_EQUAL(result, 2u);
+    });
+
+    this->run();
+    BOOST_CHECK_EQUAL(result, 2u);
+}
+
+BOOST_FIXTURE_TEST_CASE(Promise_DispatchDepthLimit, PromiseUnitTest)
+{
+    const size_t cChainLength = 100;
+    std::vector<Promise<void>::Pointer> promises;
+    size_t depth = 0;
+    size_t maxDepth = 0;
+    size_t resolveCount = 0;
+
+    for(size_t i = 0; i < cChainLength; ++i)
+    {
+        promises.push_back(Promise<void>::defer(ioService_, PromiseResolution::DISPATCH));
+    }
+
+    for(size_t i = 0; i < cChainLength; ++i)
+    {
+        promises[i]->then([&, i]() {
+            ++resolveCount;
+            maxDepth = std::max(maxDepth, ++depth);
+
+            if(i + 1 < cChainLength)
+            {
+                promises[i + 1]->resolve();
+            }
+
+            --depth;
+        });
+    }
+
+    ioService_.post([&]() { promises.front()->resolve(); });
+    this->run();
+
+    BOOST_CHECK_EQUAL(resolveCount, cChainLength);
+    BOOST_CHECK_GT(maxDepth, 1u);
+    BOOST_CHECK_LE(maxDepth, 17u);
+}
+
+BOOST_FIXTURE_TEST_CASE(Promise_ConcurrentThenAndResolve, PromiseUnitTest)
+{
+    const size_t cIterations = 1000;
+    size_t resolveCount = 0;
+
+    for(size_t i = 0; i < cIterations; ++i)
+    {
+        auto promise = Promise<void>::defer(ioService_);
+        std::thread resolver([promise]() { promise->resolve(); });
+        promise->then([&resolveCount]() { ++resolveCount; });
+        resolver.join();
+    }
+
+    this->run();
+    BOOST_CHECK_LE(resolveCount, cIterations);
+}
+
+}
+}
+}
+}
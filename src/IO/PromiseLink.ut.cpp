@@ -0,0 +1,99 @@
+/*
+*  This file is part of aasdk library project.
+*  Copyright (C) 2018 f1x.studio (Michal Szwaj)
+*
+*  aasdk is free software: you can redistribute it and/or modify
+*  it under the terms of the GNU General Public License as published by
+*  the Free Software Foundation; either version 3 of the License, or
+*  (at your option) any later version.
+
+*  aasdk is distributed in the hope that it will be useful,
+*  but WITHOUT ANY WARRANTY; without even the implied warranty of
+*  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+*  GNU General Public License for more details.
+*
+*  You should have received a copy of the GNU General Public License
+*  along with aasdk. If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include <boost/test/unit_test.hpp>
+#include <f1x/aasdk/IO/PromiseLink.hpp>
+
+namespace f1x
+{
+namespace aasdk
+{
+namespace io
+{
+namespace ut
+{
+
+class PromiseLinkUnitTest
+{
+protected:
+    PromiseLinkUnitTest()
+        : strand_(ioService_)
+    { }
+
+    void run()
+    {
+        ioService_.run();
+        ioService_.reset();
+    }
+
+    boost::asio::io_service ioService_;
+    boost::asio::io_service::strand strand_;
+};
+
+BOOST_FIXTURE_TEST_CASE(PromiseLink_ForwardResolve, PromiseLinkUnitTest)
+{
+    auto source = Promise<size_t>::defer(ioService_);
+    auto destination = Promise<size_t>::defer(strand_);
+    size_t result = 0;
+    destination->then([&result](size_t value) { result = value; });
+
+    PromiseLink<size_t, size_t>::forward(*source, destination);
+    BOOST_CHECK_EQUAL(destination.use_count(), 3);
+
+    source->resolve(5);
+    this->run();
+
+    BOOST_CHECK_EQUAL(result, 5u);
+    BOOST_CHECK_EQUAL(destination.use_count(), 1);
+}
+
+BOOST_FIXTURE_TEST_CASE(PromiseLink_ForwardTransformedResolve, PromiseLinkUnitTest)
+{
+    auto source = Promise<size_t>::defer(ioService_);
+    auto destination = Promise<std::string>::defer(strand_);
+    std::string result;
+    destination->then([&result](std::string value) { result = std::move(value); });
+
+    PromiseLink<size_t, std::string>::forward(*source, destination, [](size_t value) { return std::to_string(value); });
+    source->resolve(42);
+    this->run();
+
+    BOOST_CHECK_EQUAL(result, "42");
+}
+
+BOOST_FIXTURE_TEST_CASE(PromiseLink_ForwardReject, PromiseLinkUnitTest)
+{
+    auto source = Promise<void>::defer(ioService_);
+    auto destination = Promise<void>::defer(strand_);
+    bool isResolved = false;
+    error::Error result;
+    destination->then([&isResolved]() { isResolved = true; }, [&result](const error::Error& e) { result = e; });
+
+    PromiseLink<>::forward(*source, destination);
+    source->reject(error::Error(error::ErrorCode::OPERATION_ABORTED));
+    this->run();
+
+    BOOST_CHECK(!isResolved);
+    BOOST_CHECK(result == error::ErrorCode::OPERATION_ABORTED);
+    BOOST_CHECK_EQUAL(destination.use_count(), 1);
+}
+
+}
+}
+}
+}
@@ -0,0 +1,96 @@
+/*
+*  This file is part of aasdk library project.
+*  Copyright (C) 2018 f1x.studio (Michal Szwaj)
+*
+*  aasdk is free software: you can redistribute it and/or modify
+*  it under the terms of the GNU General Public License as published by
+*  the Free Software Foundation; either version 3 of the License, or
+*  (at your option) any later version.
+
+*  aasdk is distributed in the hope that it will be useful,
+*  but WITHOUT ANY WARRANTY; without even the implied warranty of
+*  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+*  GNU General Public License for more details.
+*
+*  You should have received a copy of the GNU General Public License
+*  along with aasdk. If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include <new>
+#include <f1x/aasdk/IO/RecyclingMemory.hpp>
+
+namespace f1x
+{
+namespace aasdk
+{
+namespace io
+{
+
+void* RecyclingMemory::allocate(size_t size)
+{
+    const auto sizeClass = RecyclingMemory::getSizeClass(size);
+
+    if(sizeClass < cSizeClassesCount)
+    {
+        auto& cache = RecyclingMemory::getCache();
+
+        if(cache.counts[sizeClass] > 0)
+        {
+            return cache.blocks[sizeClass][--cache.counts[sizeClass]];
+        }
+
+        return ::operator new((sizeClass + 1) * cGranularity);
+    }
+
+    return ::operator new(size);
+}
+
+void RecyclingMemory::deallocate(void* pointer, size_t size) noexcept
+{
+    const auto sizeClass = RecyclingMemory::getSizeClass(size);
+
+    if(sizeClass < cSizeClassesCount)
+    {
+        auto& cache = RecyclingMemory::getCache();
+
+        if(!cache.isClosed && cache.counts[sizeClass] < cMaxCachedBlocksCount)
+        {
+            cache.blocks[sizeClass][cache.counts[sizeClass]++] = pointer;
+            return;
+        }
+    }
+
+    ::operator delete(pointer);
+}
+
+RecyclingMemory::Cache& RecyclingMemory::getCache() noexcept
+{
+    static thread_local Cache cache{};
+    static thread_local CacheCleaner cacheCleaner;
+    (void)cacheCleaner;
+
+    return cache;
+}
+
+size_t RecyclingMemory::getSizeClass(size_t size) noexcept
+{
+    return size == 0 ? 0 : (size - 1) / cGranularity;
+}
+
+RecyclingMemory::CacheCleaner::~CacheCleaner()
+{
+    auto& cache = RecyclingMemory::getCache();
+    cache.isClosed = true;
+
+    for(size_t sizeClass = 0; sizeClass < cSizeClassesCount; ++sizeClass)
+    {
+        while(cache.counts[sizeClass] > 0)
+        {
+            ::operator delete(cache.blocks[sizeClass][--cache.counts[sizeClass]]);
+        }
+    }
+}
+
+}
+}
+}
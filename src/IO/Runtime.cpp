@@ -0,0 +1,146 @@
+/*
+*  This file is part of aasdk library project.
+*  Copyright (C) 2018 f1x.studio (Michal Szwaj)
+*
+*  aasdk is free software: you can redistribute it and/or modify
+*  it under the terms of the GNU General Public License as published by
+*  the Free Software Foundation; either version 3 of the License, or
+*  (at your option) any later version.
+
+*  aasdk is distributed in the hope that it will be useful,
+*  but WITHOUT ANY WARRANTY; without even the implied warranty of
+*  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+*  GNU General Public License for more details.
+*
+*  You should have received a copy of the GNU General Public License
+*  along with aasdk. If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include <algorithm>
+#include <f1x/aasdk/Error/Error.hpp>
+#include <f1x/aasdk/IO/Runtime.hpp>
+#include <f1x/aasdk/Common/Log.hpp>
+
+namespace f1x
+{
+namespace aasdk
+{
+namespace io
+{
+
+Runtime::Runtime(size_t ioThreadsCount, ThreadConfiguration ioThreadConfiguration,
+                 size_t applicationThreadsCount, ThreadConfiguration applicationThreadConfiguration)
+    : ioWork_(std::make_unique<boost::asio::io_service::work>(ioService_))
+    , applicationWork_(std::make_unique<boost::asio::io_service::work>(applicationService_))
+    , ioThreadConfiguration_(std::move(ioThreadConfiguration))
+    , ioThreadsCount_(std::max<size_t>(ioThreadsCount, 1))
+    , isStopped_(false)
+{
+    for(size_t i = 0; i < ioThreadsCount_; ++i)
+    {
+        this->startThread(ioThreadConfiguration_, i, [this]() { ioService_.run(); });
+    }
+
+    for(size_t i = 0; i < std::max<size_t>(applicationThreadsCount, 1); ++i)
+    {
+        this->startThread(applicationThreadConfiguration, i, [this]() { applicationService_.run(); });
+    }
+}
+
+Runtime::~Runtime()
+{
+    this->stop();
+}
+
+boost::asio::io_service& Runtime::getIOService()
+{
+    return ioService_;
+}
+
+boost::asio::io_service& Runtime::getApplicationService()
+{
+    return applicationService_;
+}
+
+void Runtime::addIOThread(std::function<void()> eventLoop, std::function<void()> interrupt)
+{
+    std::lock_guard<decltype(mutex_)> lock(mutex_);
+
+    if(isStopped_)
+    {
+        return;
+    }
+
+    if(interrupt != nullptr)
+    {
+        interrupts_.push_back(std::move(interrupt));
+    }
+
+    this->startThread(ioThreadConfiguration_, ioThreadsCount_++, [this, eventLoop = std::move(eventLoop)]() {
+        while(!isStopped_)
+        {
+            eventLoop();
+        }
+    });
+}
+
+void Runtime::stop()
+{
+    std::vector<std::thread> threads;
+    std::vector<std::function<void()>> interrupts;
+
+    {
+        std::lock_guard<decltype(mutex_)> lock(mutex_);
+
+        if(isStopped_.exchange(true))
+        {
+            return;
+        }
+
+        threads = std::move(threads_);
+        interrupts = std::move(interrupts_);
+    }
+
+    ioWork_.reset();
+    applicationWork_.reset();
+    ioService_.stop();
+    applicationService_.stop();
+
+    for(const auto& interrupt : interrupts)
+    {
+        interrupt();
+    }
+
+    for(auto& thread : threads)
+    {
+        // A Runtime thread stopping the runtime cannot join itself; it finishes once its handler returns.
+        if(thread.get_id() == std::this_thread::get_id())
+        {
+            thread.detach();
+        }
+        else
+        {
+            thread.join();
+        }
+    }
+}
+
+void Runtime::startThread(const ThreadConfiguration& configuration, size_t index, std::function<void()> body)
+{
+    threads_.emplace_back([configuration, index, body = std::move(body)]() {
+        try
+        {
+            configuration.apply(index);
+        }
+        catch(const error::Error& e)
+        {
+            AASDK_LOG(error) << "[Runtime] cannot configure thread " << configuration.name << index << ": " << e.what();
+        }
+
+        body();
+    });
+}
+
+}
+}
+}
@@ -0,0 +1,168 @@
+/*
+*  This file is part of aasdk library project.
+*  Copyright (C) 2018 f1x.studio (Michal Szwaj)
+*
+*  aasdk is free software: you can redistribute it and/or modify
+*  it under the terms of the GNU General Public License as published by
+*  the Free Software Foundation; either version 3 of the License, or
+*  (at your option) any later version.
+
+*  aasdk is distributed in the hope that it will be useful,
+*  but WITHOUT ANY WARRANTY; without even the implied warranty of
+*  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+*  GNU General Public License for more details.
+*
+*  You should have received a copy of the GNU General Public License
+*  along with aasdk. If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include <pthread.h>
+#include <condition_variable>
+#include <future>
+#include <mutex>
+#include <boost/test/unit_test.hpp>
+#include <f1x/aasdk/IO/Runtime.hpp>
+
+namespace f1x
+{
+namespace aasdk
+{
+namespace io
+{
+namespace ut
+{
+
+std::string getThreadName()
+{
+    char name[16] = {0};
+    pthread_getname_np(pthread_self(), name, sizeof(name));
+    return name;
+}
+
+template<typename ResultType, typename FunctionType>
+ResultType runOn(boost::asio::io_service& ioService, FunctionType function)
+{
+    std::promise<ResultType> result;
+    ioService.post([&]() { result.set_value(function()); });
+    return result.get_future().get();
+}
+
+BOOST_AUTO_TEST_CASE(Runtime_SeparateIOAndApplicationThreads)
+{
+    Runtime runtime(1, ThreadConfiguration("test-io"), 1, ThreadConfiguration("test-app"));
+
+    BOOST_CHECK_EQUAL(runOn<std::string>(runtime.getIOService(), &getThreadName), "test-io0");
+    BOOST_CHECK_EQUAL(runOn<std::string>(runtime.getApplicationService(), &getThreadName), "test-app0");
+    BOOST_CHECK(runOn<std::thread::id>(runtime.getIOService(), &std::this_thread::get_id)
+                != runOn<std::thread::id>(runtime.getApplicationService(), &std::this_thread::get_id));
+}
+
+BOOST_AUTO_TEST_CASE(Runtime_PinIOThreadToConfiguredCpu)
+{
+    Runtime runtime(1, ThreadConfiguration("test-io", {0}));
+
+    const auto cpuSet = runOn<cpu_set_t>(runtime.getIOService(), []() {
+        cpu_set_t cpuSet;
+        pthread_getaffinity_np(pthread_self(), sizeof(cpuSet), &cpuSet);
+        return cpuSet;
+    });
+
+    BOOST_CHECK_EQUAL(CPU_COUNT(&cpuSet), 1);
+    BOOST_CHECK(CPU_ISSET(0, &cpuSet));
+}
+
+BOOST_AUTO_TEST_CASE(Runtime_RunWhenSchedulingPolicyIsRejected)
+{
+    Runtime runtime(1, ThreadConfiguration("test-io", {}, SCHED_FIFO, 1000));
+
+    BOOST_CHECK(runOn<bool>(runtime.getIOService(), []() { return true; }));
+}
+
+BOOST_AUTO_TEST_CASE(Runtime_ApplySchedulingWhenAffinityIsRejected)
+{
+    Runtime runtime(1, ThreadConfiguration("test-io", {CPU_SETSIZE - 1}, SCHED_BATCH));
+
+    BOOST_CHECK_EQUAL(runOn<int>(runtime.getIOService(), []() { return sched_getscheduler(0); }), SCHED_BATCH);
+}
+
+BOOST_AUTO_TEST_CASE(Runtime_RejectOutOfRangeCpu)
+{
+    Runtime runtime(1, ThreadConfiguration("test-io", {CPU_SETSIZE}, SCHED_BATCH));
+
+    BOOST_CHECK_EQUAL(runOn<int>(runtime.getIOService(), []() { return sched_getscheduler(0); }), SCHED_BATCH);
+}
+
+BOOST_AUTO_TEST_CASE(Runtime_StopFromRuntimeThread)
+{
+    Runtime runtime;
+    std::promise<void> isStopped;
+
+    runtime.getApplicationService().post([&]() {
+        runtime.stop();
+        isStopped.set_value();
+    });
+
+    BOOST_CHECK(isStopped.get_future().wait_for(std::chrono::seconds(5)) == std::future_status::ready);
+
+    // Give the detached thread time to leave the io_service before it is destroyed.
+    std::this_thread::sleep_for(std::chrono::milliseconds(10));
+}
+
+BOOST_AUTO_TEST_CASE(Runtime_InterruptBlockedIOEventLoop)
+{
+    Runtime runtime;
+    std::mutex mutex;
+    std::condition_variable condition;
+    bool isInterrupted = false;
+    std::promise<void> isBlocked;
+
+    runtime.addIOThread([&]() {
+        std::unique_lock<std::mutex> lock(mutex);
+
+        if(!isInterrupted)
+        {
+            isBlocked.set_value();
+        }
+
+        condition.wait(lock, [&]() { return isInterrupted; });
+    },
+    [&]() {
+        std::lock_guard<std::mutex> lock(mutex);
+        isInterrupted = true;
+        condition.notify_all();
+    });
+
+    isBlocked.get_future().wait();
+    runtime.stop();
+
+    std::lock_guard<std::mutex> lock(mutex);
+    BOOST_CHECK(isInterrupted);
+}
+
+BOOST_AUTO_TEST_CASE(Runtime_RunIOEventLoopUntilStopped)
+{
+    Runtime runtime;
+    std::atomic<size_t> iterations(0);
+    std::promise<std::string> threadName;
+
+    runtime.addIOThread([&]() {
+        if(iterations++ == 0)
+        {
+            threadName.set_value(getThreadName());
+        }
+
+        std::this_thread::yield();
+    });
+
+    BOOST_CHECK_EQUAL(threadName.get_future().get(), "aasdk-io1");
+    runtime.stop();
+
+    const auto stoppedIterations = iterations.load();
+    std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    BOOST_CHECK_EQUAL(iterations.load(), stoppedIterations);
+}
+
+}
+}
+}
+}
@@ -0,0 +1,116 @@
+/*
+*  This file is part of aasdk library project.
+*  Copyright (C) 2018 f1x.studio (Michal Szwaj)
+*
+*  aasdk is free software: you can redistribute it and/or modify
+*  it under the terms of the GNU General Public License as published by
+*  the Free Software Foundation; either version 3 of the License, or
+*  (at your option) any later version.
+
+*  aasdk is distributed in the hope that it will be useful,
+*  but WITHOUT ANY WARRANTY; without even the implied warranty of
+*  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+*  GNU General Public License for more details.
+*
+*  You should have received a copy of the GNU General Public License
+*  along with aasdk. If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include <thread>
+#include <boost/test/unit_test.hpp>
+#include <f1x/aasdk/IO/SPSCRing.hpp>
+
+namespace f1x
+{
+namespace aasdk
+{
+namespace io
+{
+namespace ut
+{
+
+BOOST_AUTO_TEST_CASE(SPSCRing_RoundCapacityUpToPowerOfTwo)
+{
+    SPSCRing<int> ring(5);
+    BOOST_CHECK_EQUAL(ring.capacity(), 8u);
+}
+
+BOOST_AUTO_TEST_CASE(SPSCRing_RejectPushWhenFull)
+{
+    SPSCRing<int> ring(2);
+
+    for(int i = 0; i < 2; ++i)
+    {
+        BOOST_CHECK(ring.push(i));
+    }
+
+    int value = 5;
+    BOOST_CHECK(!ring.push(value));
+    BOOST_CHECK_EQUAL(value, 5);
+
+    BOOST_CHECK(ring.pop(value));
+    BOOST_CHECK_EQUAL(value, 0);
+    BOOST_CHECK(ring.pop(value));
+    BOOST_CHECK_EQUAL(value, 1);
+    BOOST_CHECK(!ring.pop(value));
+    BOOST_CHECK(ring.empty());
+}
+
+BOOST_AUTO_TEST_CASE(SPSCRing_ReleaseValueOnPop)
+{
+    SPSCRing<std::shared_ptr<int>> ring(2);
+    auto value = std::make_shared<int>(1);
+    auto pushedValue = value;
+
+    BOOST_CHECK(ring.push(pushedValue));
+    BOOST_CHECK(ring.pop(pushedValue));
+    pushedValue.reset();
+
+    BOOST_CHECK_EQUAL(value.use_count(), 1);
+}
+
+BOOST_AUTO_TEST_CASE(SPSCRing_PreserveOrderAcrossThreads)
+{
+    const size_t cValuesCount = 100000;
+    SPSCRing<size_t> ring(64);
+
+    std::thread producer([&]() {
+        for(size_t i = 0; i < cValuesCount; ++i)
+        {
+            auto value = i;
+
+            while(!ring.push(value))
+            {
+                std::this_thread::yield();
+            }
+        }
+    });
+
+    size_t expected = 0;
+    size_t value = 0;
+
+    while(expected < cValuesCount)
+    {
+        if(ring.pop(value))
+        {
+            if(value != expected)
+            {
+                break;
+            }
+
+            ++expected;
+        }
+        else
+        {
+            std::this_thread::yield();
+        }
+    }
+
+    producer.join();
+    BOOST_CHECK_EQUAL(expected, cValuesCount);
+}
+
+}
+}
+}
+}
@@ -0,0 +1,110 @@
+/*
+*  This file is part of aasdk library project.
+*  Copyright (C) 2018 f1x.studio (Michal Szwaj)
+*
+*  aasdk is free software: you can redistribute it and/or modify
+*  it under the terms of the GNU General Public License as published by
+*  the Free Software Foundation; either version 3 of the License, or
+*  (at your option) any later version.
+
+*  aasdk is distributed in the hope that it will be useful,
+*  but WITHOUT ANY WARRANTY; without even the implied warranty of
+*  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+*  GNU General Public License for more details.
+*
+*  You should have received a copy of the GNU General Public License
+*  along with aasdk. If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include <algorithm>
+#include <cerrno>
+#include <pthread.h>
+#include <f1x/aasdk/Error/Error.hpp>
+#include <f1x/aasdk/IO/ThreadConfiguration.hpp>
+#include <f1x/aasdk/Common/Log.hpp>
+
+namespace f1x
+{
+namespace aasdk
+{
+namespace io
+{
+
+ThreadConfiguration::ThreadConfiguration(std::string _name, std::vector<size_t> _cpus, int _policy, int _priority)
+    : name(std::move(_name))
+    , cpus(std::move(_cpus))
+    , policy(_policy)
+    , priority(_priority)
+{
+
+}
+
+void ThreadConfiguration::apply(size_t index) const
+{
+    const auto self = pthread_self();
+
+    if(!name.empty())
+    {
+        // Linux limits thread names to 15 characters.
+        pthread_setname_np(self, (name + std::to_string(index)).substr(0, 15).c_str());
+    }
+
+    // Affinity and scheduling are applied independently, so a rejected CPU set does not skip the scheduling policy.
+    error::Error affinityError;
+    error::Error schedulingError;
+
+    if(!cpus.empty())
+    {
+        // CPU_SET does not check its index, so CPUs outside cpu_set_t are rejected up front.
+        int result = EINVAL;
+
+        if(std::all_of(cpus.begin(), cpus.end(), [](size_t cpu) { return cpu < CPU_SETSIZE; }))
+        {
+            cpu_set_t cpuSet;
+            CPU_ZERO(&cpuSet);
+
+            for(const auto cpu : cpus)
+            {
+                CPU_SET(cpu, &cpuSet);
+            }
+
+            result = pthread_setaffinity_np(self, sizeof(cpuSet), &cpuSet);
+        }
+
+        if(result != 0)
+        {
+            affinityError = error::Error(error::ErrorCode::THREAD_AFFINITY, result);
+        }
+    }
+
+    if(policy != SCHED_OTHER || priority != 0)
+    {
+        sched_param parameters{};
+        parameters.sched_priority = priority;
+        const auto result = pthread_setschedparam(self, policy, &parameters);
+
+        if(result != 0)
+        {
+            schedulingError = error::Error(error::ErrorCode::THREAD_SCHEDULING, result);
+        }
+    }
+
+    if(affinityError != error::ErrorCode::NONE)
+    {
+        if(schedulingError != error::ErrorCode::NONE)
+        {
+            AASDK_LOG(error) << "[ThreadConfiguration] cannot set scheduling of thread " << name << index << ": " << schedulingError.what();
+        }
+
+        throw affinityError;
+    }
+
+    if(schedulingError != error::ErrorCode::NONE)
+    {
+        throw schedulingError;
+    }
+}
+
+}
+}
+}
@@ -0,0 +1,277 @@
+/*
+*  This file is part of aasdk library project.
+*  Copyright (C) 2018 f1x.studio (Michal Szwaj)
+*
+*  aasdk is free software: you can redistribute it and/or modify
+*  it under the terms of the GNU General Public License as published by
+*  the Free Software Foundation; either version 3 of the License, or
+*  (at your option) any later version.
+
+*  aasdk is distributed in the hope that it will be useful,
+*  but WITHOUT ANY WARRANTY; without even the implied warranty of
+*  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+*  GNU General Public License for more details.
+*
+*  You should have received a copy of the GNU General Public License
+*  along with aasdk. If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include <algorithm>
+#include <f1x/aasdk/Error/Error.hpp>
+#include <f1x/aasdk/IO/WorkStealingExecutor.hpp>
+#include <f1x/aasdk/Common/Log.hpp>
+
+namespace f1x
+{
+namespace aasdk
+{
+namespace io
+{
+
+thread_local WorkStealingExecutor* WorkStealingExecutor::currentExecutor_ = nullptr;
+thread_local size_t WorkStealingExecutor::currentWorker_ = 0;
+
+WorkStealingExecutor::WorkStealingExecutor(size_t threadsCount, ThreadConfiguration threadConfiguration)
+    : nextWorker_(0)
+    , pendingCount_(0)
+    , sleepingCount_(0)
+    , stolenCount_(0)
+    , isStopped_(false)
+{
+    threadsCount = std::max<size_t>(threadsCount, 1);
+
+    for(size_t i = 0; i < threadsCount; ++i)
+    {
+        workers_.emplace_back(std::make_unique<Worker>());
+    }
+
+    for(size_t i = 0; i < threadsCount; ++i)
+    {
+        threads_.emplace_back([this, threadConfiguration, i]() {
+            try
+            {
+                threadConfiguration.apply(i);
+            }
+            catch(const error::Error& e)
+            {
+                AASDK_LOG(error) << "[WorkStealingExecutor] cannot configure thread " << threadConfiguration.name << i << ": " << e.what();
+            }
+
+            this->run(i);
+        });
+    }
+}
+
+WorkStealingExecutor::~WorkStealingExecutor()
+{
+    {
+        std::lock_guard<decltype(idleMutex_)> lock(idleMutex_);
+        isStopped_ = true;
+        idleCondition_.notify_all();
+    }
+
+    for(auto& thread : threads_)
+    {
+        thread.join();
+    }
+}
+
+void WorkStealingExecutor::post(Task task)
+{
+    // Tasks posted by a worker stay on its own queue, others are spread round-robin.
+    const auto index = currentExecutor_ == this ? currentWorker_ : nextWorker_++ % workers_.size();
+
+    {
+        std::lock_guard<decltype(Worker::mutex)> lock(workers_[index]->mutex);
+        workers_[index]->tasks.push_back(std::move(task));
+    }
+
+    ++pendingCount_;
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+
+    if(sleepingCount_ > 0)
+    {
+        std::lock_guard<decltype(idleMutex_)> lock(idleMutex_);
+        idleCondition_.notify_one();
+    }
+}
+
+WorkStealingExecutor::Strand::Pointer WorkStealingExecutor::createStrand()
+{
+    return std::make_shared<Strand>(*this);
+}
+
+size_t WorkStealingExecutor::getThreadsCount() const
+{
+    return threads_.size();
+}
+
+size_t WorkStealingExecutor::getStolenCount() const
+{
+    return stolenCount_;
+}
+
+void WorkStealingExecutor::run(size_t index)
+{
+    currentExecutor_ = this;
+    currentWorker_ = index;
+
+    while(!isStopped_)
+    {
+        Task task;
+
+        if(this->pop(index, task) || this->steal(index, task))
+        {
+            --pendingCount_;
+            execute(task);
+        }
+        else
+        {
+            this->wait();
+        }
+    }
+}
+
+bool WorkStealingExecutor::pop(size_t index, Task& task)
+{
+    auto& worker = *workers_[index];
+    std::lock_guard<decltype(worker.mutex)> lock(worker.mutex);
+
+    if(worker.tasks.empty())
+    {
+        return false;
+    }
+
+    task = std::move(worker.tasks.front());
+    worker.tasks.pop_front();
+    return true;
+}
+
+bool WorkStealingExecutor::steal(size_t index, Task& task)
+{
+    // A busy victim is skipped on the first pass. If work is still pending afterwards the second pass
+    // waits for the locks, so a worker never goes to sleep while another queue holds a task.
+    for(const auto blocking : {false, true})
+    {
+        if(blocking && pendingCount_ == 0)
+        {
+            break;
+        }
+
+        for(size_t i = 1; i < workers_.size(); ++i)
+        {
+            auto& victim = *workers_[(index + i) % workers_.size()];
+            std::unique_lock<decltype(victim.mutex)> lock(victim.mutex, std::defer_lock);
+
+            if(blocking)
+            {
+                lock.lock();
+            }
+            else if(!lock.try_lock())
+            {
+                continue;
+            }
+
+            if(!victim.tasks.empty())
+            {
+                task = std::move(victim.tasks.back());
+                victim.tasks.pop_back();
+                ++stolenCount_;
+                return true;
+            }
+        }
+    }
+
+    return false;
+}
+
+void WorkStealingExecutor::wait()
+{
+    std::unique_lock<decltype(idleMutex_)> lock(idleMutex_);
+    ++sleepingCount_;
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+
+    idleCondition_.wait(lock, [this]() { return isStopped_ || pendingCount_ > 0; });
+    --sleepingCount_;
+}
+
+void WorkStealingExecutor::execute(Task& task)
+{
+    try
+    {
+        task();
+    }
+    catch(const std::exception& e)
+    {
+        AASDK_LOG(error) << "[WorkStealingExecutor] task failed: " << e.what();
+    }
+    catch(...)
+    {
+        AASDK_LOG(error) << "[WorkStealingExecutor] task failed with an unknown exception.";
+    }
+}
+
+WorkStealingExecutor::Strand::Strand(WorkStealingExecutor& executor)
+    : executor_(executor)
+    , isScheduled_(false)
+    , runningThreadId_(std::thread::id())
+{
+
+}
+
+void WorkStealingExecutor::Strand::post(Task task)
+{
+    {
+        std::lock_guard<decltype(mutex_)> lock(mutex_);
+        tasks_.push_back(std::move(task));
+
+        if(isScheduled_)
+        {
+            return;
+        }
+
+        isScheduled_ = true;
+    }
+
+    executor_.post([self = this->shared_from_this()]() { self->run(); });
+}
+
+bool WorkStealingExecutor::Strand::isRunningInThisThread() const
+{
+    return runningThreadId_ == std::this_thread::get_id();
+}
+
+void WorkStealingExecutor::Strand::run()
+{
+    runningThreadId_ = std::this_thread::get_id();
+
+    for(size_t i = 0; i < cMaxBatchSize; ++i)
+    {
+        Task task;
+
+        {
+            std::lock_guard<decltype(mutex_)> lock(mutex_);
+
+            if(tasks_.empty())
+            {
+                isScheduled_ = false;
+                runningThreadId_ = std::thread::id();
+                return;
+            }
+
+            task = std::move(tasks_.front());
+            tasks_.pop_front();
+        }
+
+        WorkStealingExecutor::execute(task);
+    }
+
+    runningThreadId_ = std::thread::id();
+
+    // Give other strands a turn; another worker may pick this strand up.
+    executor_.post([self = this->shared_from_this()]() { self->run(); });
+}
+
+}
+}
+}
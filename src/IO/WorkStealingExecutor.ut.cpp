@@ -0,0 +1,122 @@
+/*
+*  This file is part of aasdk library project.
+*  Copyright (C) 2018 f1x.studio (Michal Szwaj)
+*
+*  aasdk is free software: you can redistribute it and/or modify
+*  it under the terms of the GNU General Public License as published by
+*  the Free Software Foundation; either version 3 of the License, or
+*  (at your option) any later version.
+
+*  aasdk is distributed in the hope that it will be useful,
+*  but WITHOUT ANY WARRANTY; without even the implied warranty of
+*  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+*  GNU General Public License for more details.
+*
+*  You should have received a copy of the GNU General Public License
+*  along with aasdk. If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include <future>
+#include <stdexcept>
+#include <boost/test/unit_test.hpp>
+#include <f1x/aasdk/IO/WorkStealingExecutor.hpp>
+
+namespace f1x
+{
+namespace aasdk
+{
+namespace io
+{
+namespace ut
+{
+
+BOOST_AUTO_TEST_CASE(WorkStealingExecutor_StrandKeepsOrder)
+{
+    WorkStealingExecutor executor(4);
+    auto strand = executor.createStrand();
+
+    std::vector<int> order;
+    std::promise<void> done;
+
+    for(int i = 0; i < 1000; ++i)
+    {
+        strand->post([&, i]() {
+            BOOST_CHECK(strand->isRunningInThisThread());
+            order.push_back(i);
+
+            if(i == 999)
+            {
+                done.set_value();
+            }
+        });
+    }
+
+    BOOST_REQUIRE(done.get_future().wait_for(std::chrono::seconds(5)) == std::future_status::ready);
+    BOOST_REQUIRE_EQUAL(order.size(), 1000u);
+
+    for(int i = 0; i < 1000; ++i)
+    {
+        BOOST_CHECK_EQUAL(order[i], i);
+    }
+}
+
+BOOST_AUTO_TEST_CASE(WorkStealingExecutor_IndependentStrandsRunInParallel)
+{
+    WorkStealingExecutor executor(2);
+    auto firstStrand = executor.createStrand();
+    auto secondStrand = executor.createStrand();
+
+    std::promise<void> firstStarted;
+    std::promise<void> secondStarted;
+    auto firstFuture = firstStarted.get_future();
+    auto secondFuture = secondStarted.get_future();
+    std::promise<bool> firstResult;
+    std::promise<bool> secondResult;
+
+    // Each task waits for the other one, which succeeds only when both run at the same time.
+    firstStrand->post([&]() {
+        firstStarted.set_value();
+        firstResult.set_value(secondFuture.wait_for(std::chrono::seconds(5)) == std::future_status::ready);
+    });
+    secondStrand->post([&]() {
+        secondStarted.set_value();
+        secondResult.set_value(firstFuture.wait_for(std::chrono::seconds(5)) == std::future_status::ready);
+    });
+
+    BOOST_CHECK(firstResult.get_future().get());
+    BOOST_CHECK(secondResult.get_future().get());
+}
+
+BOOST_AUTO_TEST_CASE(WorkStealingExecutor_IdleWorkerStealsFromBusyWorker)
+{
+    WorkStealingExecutor executor(2);
+    std::promise<bool> result;
+
+    executor.post([&]() {
+        // Queued on this busy worker, so only the other worker can run it.
+        std::promise<void> nested;
+        auto nestedFuture = nested.get_future();
+        executor.post([&]() { nested.set_value(); });
+        result.set_value(nestedFuture.wait_for(std::chrono::seconds(5)) == std::future_status::ready);
+    });
+
+    BOOST_CHECK(result.get_future().get());
+    BOOST_CHECK_GE(executor.getStolenCount(), 1u);
+}
+
+BOOST_AUTO_TEST_CASE(WorkStealingExecutor_SurviveThrowingTask)
+{
+    WorkStealingExecutor executor(1);
+    auto strand = executor.createStrand();
+    std::promise<void> done;
+
+    strand->post([]() { throw std::runtime_error("task failure"); });
+    strand->post([&]() { done.set_value(); });
+
+    BOOST_CHECK(done.get_future().wait_for(std::chrono::seconds(5)) == std::future_status::ready);
+}
+
+}
+}
+}
+}
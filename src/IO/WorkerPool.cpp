@@ -0,0 +1,58 @@
+/*
+*  This file is part of aasdk library project.
+*  Copyright (C) 2018 f1x.studio (Michal Szwaj)
+*
+*  aasdk is free software: you can redistribute it and/or modify
+*  it under the terms of the GNU General Public License as published by
+*  the Free Software Foundation; either version 3 of the License, or
+*  (at your option) any later version.
+
+*  aasdk is distributed in the hope that it will be useful,
+*  but WITHOUT ANY WARRANTY; without even the implied warranty of
+*  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+*  GNU General Public License for more details.
+*
+*  You should have received a copy of the GNU General Public License
+*  along with aasdk. If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include <algorithm>
+#include <f1x/aasdk/IO/WorkerPool.hpp>
+
+namespace f1x
+{
+namespace aasdk
+{
+namespace io
+{
+
+WorkerPool::WorkerPool(size_t threadsCount)
+    : work_(std::make_unique<boost::asio::io_service::work>(ioService_))
+{
+    threadsCount = std::max<size_t>(threadsCount, 1);
+    threads_.reserve(threadsCount);
+
+    for(size_t i = 0; i < threadsCount; ++i)
+    {
+        threads_.emplace_back([this]() { ioService_.run(); });
+    }
+}
+
+WorkerPool::~WorkerPool()
+{
+    work_.reset();
+
+    for(auto& thread : threads_)
+    {
+        thread.join();
+    }
+}
+
+size_t WorkerPool::getThreadsCount() const
+{
+    return threads_.size();
+}
+
+}
+}
+}
@@ -0,0 +1,130 @@
+/*
+*  This file is part of aasdk library project.
+*  Copyright (C) 2018 f1x.studio (Michal Szwaj)
+*
+*  aasdk is free software: you can redistribute it and/or modify
+*  it under the terms of the GNU General Public License as published by
+*  the Free Software Foundation; either version 3 of the License, or
+*  (at your option) any later version.
+
+*  aasdk is distributed in the hope that it will be useful,
+*  but WITHOUT ANY WARRANTY; without even the implied warranty of
+*  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+*  GNU General Public License for more details.
+*
+*  You should have received a copy of the GNU General Public License
+*  along with aasdk. If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include <algorithm>
+#include <f1x/aasdk/Messenger/ChannelSendBacklog.hpp>
+
+namespace f1x
+{
+namespace aasdk
+{
+namespace messenger
+{
+
+ChannelSendBacklog::ChannelState::ChannelState()
+    : queuedBytes(0)
+    , queuedMessages(0)
+    , writable(true)
+{
+
+}
+
+void ChannelSendBacklog::setWatermarks(ChannelId channelId, const SendWatermarks& watermarks)
+{
+    auto& state = channels_[channelId];
+    state.watermarks = watermarks;
+
+    // A low watermark at or above the high one would flip the state on every push and pop.
+    state.watermarks.lowBytes = std::min(watermarks.lowBytes, watermarks.highBytes > 0 ? watermarks.highBytes - 1 : 0);
+    state.watermarks.lowMessages = std::min(watermarks.lowMessages, watermarks.highMessages > 0 ? watermarks.highMessages - 1 : 0);
+    this->update(state);
+}
+
+void ChannelSendBacklog::push(ChannelId channelId, size_t size)
+{
+    auto& state = channels_[channelId];
+    state.queuedBytes += size;
+    ++state.queuedMessages;
+    this->update(state);
+}
+
+void ChannelSendBacklog::pop(ChannelId channelId, size_t size)
+{
+    auto& state = channels_[channelId];
+    state.queuedBytes -= std::min(size, state.queuedBytes);
+    state.queuedMessages -= std::min<size_t>(1, state.queuedMessages);
+    this->update(state);
+}
+
+bool ChannelSendBacklog::isWritable(ChannelId channelId) const
+{
+    return channels_.count(channelId) == 0 || channels_.at(channelId).writable;
+}
+
+size_t ChannelSendBacklog::getQueuedBytes(ChannelId channelId) const
+{
+    return channels_.count(channelId) > 0 ? channels_.at(channelId).queuedBytes : 0;
+}
+
+size_t ChannelSendBacklog::getQueuedMessages(ChannelId channelId) const
+{
+    return channels_.count(channelId) > 0 ? channels_.at(channelId).queuedMessages : 0;
+}
+
+void ChannelSendBacklog::enqueueWritable(ChannelId channelId, SendPromise::Pointer promise)
+{
+    auto& state = channels_[channelId];
+
+    if(state.writable)
+    {
+        promise->resolve();
+    }
+    else
+    {
+        state.writablePromises.push(std::move(promise));
+    }
+}
+
+void ChannelSendBacklog::reject(const error::Error& e)
+{
+    for(auto& channel : channels_)
+    {
+        auto& state = channel.second;
+        state.queuedBytes = 0;
+        state.queuedMessages = 0;
+        state.writable = true;
+
+        while(!state.writablePromises.empty())
+        {
+            state.writablePromises.front()->reject(e);
+            state.writablePromises.pop();
+        }
+    }
+}
+
+void ChannelSendBacklog::update(ChannelState& state)
+{
+    if(state.writable)
+    {
+        state.writable = state.queuedBytes < state.watermarks.highBytes && state.queuedMessages < state.watermarks.highMessages;
+    }
+    else
+    {
+        state.writable = state.queuedBytes <= state.watermarks.lowBytes && state.queuedMessages <= state.watermarks.lowMessages;
+    }
+
+    while(state.writable && !state.writablePromises.empty())
+    {
+        state.writablePromises.front()->resolve();
+        state.writablePromises.pop();
+    }
+}
+
+}
+}
+}
@@ -0,0 +1,282 @@
+/*
+*  This file is part of aasdk library project.
+*  Copyright (C) 2018 f1x.studio (Michal Szwaj)
+*
+*  aasdk is free software: you can redistribute it and/or modify
+*  it under the terms of the GNU General Public License as published by
+*  the Free Software Foundation; either version 3 of the License, or
+*  (at your option) any later version.
+
+*  aasdk is distributed in the hope that it will be useful,
+*  but WITHOUT ANY WARRANTY; without even the implied warranty of
+*  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+*  GNU General Public License for more details.
+*
+*  You should have received a copy of the GNU General Public License
+*  along with aasdk. If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include <atomic>
+#include <iostream>
+#include <thread>
+#include <boost/test/unit_test.hpp>
+#include <f1x/aasdk/IO/WorkerPool.hpp>
+#include <f1x/aasdk/Common/UT/Benchmark.hpp>
+#include <f1x/aasdk/Messenger/UT/SSLServer.hpp>
+#include <f1x/aasdk/Transport/SSLWrapper.hpp>
+#include <f1x/aasdk/Messenger/Cryptor.hpp>
+#include <f1x/aasdk/Messenger/CryptorContext.hpp>
+
+namespace f1x
+{
+namespace aasdk
+{
+namespace messenger
+{
+namespace ut
+{
+
+void benchmarkCryptor(const std::string& name, bool useRecordLayer)
+{
+    const size_t cFrameSize = 16384;
+    const size_t cFramesCount = 2000;
+
+    CryptorOptions options;
+    options.useRecordLayer = useRecordLayer;
+
+    auto cryptor(std::make_shared<Cryptor>(std::make_shared<transport::SSLWrapper>(), options));
+    cryptor->init();
+
+    SSLServer server;
+    server.connect(*cryptor);
+    BOOST_CHECK_EQUAL(cryptor->hasRecordLayer(), useRecordLayer);
+
+    const common::Data frame(cFrameSize, 0x5A);
+    std::vector<common::Data> encryptedFrames;
+    encryptedFrames.reserve(cFramesCount);
+
+    for(size_t i = 0; i < cFramesCount; ++i)
+    {
+        encryptedFrames.push_back(server.encrypt(common::DataConstBuffer(frame)));
+    }
+
+    common::Data output;
+    output.reserve(cFrameSize * 2);
+    size_t frameIndex = 0;
+
+    common::ut::runBenchmark(name + " decrypt 16KB frame", cFramesCount, cFrameSize, [&]() {
+        output.clear();
+        cryptor->decrypt(output, common::DataConstBuffer(encryptedFrames[frameIndex++]));
+    });
+
+    BOOST_CHECK(output == frame);
+
+    common::ut::runBenchmark(name + " encrypt 16KB frame", cFramesCount, cFrameSize, [&]() {
+        output.clear();
+        cryptor->encrypt(output, common::DataConstBuffer(frame));
+    });
+
+    BOOST_CHECK_GT(output.size(), frame.size());
+    cryptor->deinit();
+}
+
+void benchmarkCipherSuite(const std::string& cipherList, size_t frameSize)
+{
+    const size_t cFramesCount = 2000;
+
+    auto cryptor(std::make_shared<Cryptor>(std::make_shared<transport::SSLWrapper>()));
+    cryptor->init();
+
+    SSLServer server(TLS1_2_VERSION, cipherList);
+    server.connect(*cryptor);
+
+    const auto cipherName = cryptor->getHandshakeMetrics().cipherName;
+    BOOST_CHECK_EQUAL(cipherName, cipherList);
+
+    const common::Data frame(frameSize, 0x5A);
+    std::vector<common::Data> encryptedFrames;
+    encryptedFrames.reserve(cFramesCount);
+
+    for(size_t i = 0; i < cFramesCount; ++i)
+    {
+        encryptedFrames.push_back(server.encrypt(common::DataConstBuffer(frame)));
+    }
+
+    common::Data output;
+    output.reserve(frameSize * 2);
+    size_t frameIndex = 0;
+    const auto sizeName = std::to_string(frameSize / 1024) + "KB";
+
+    common::ut::runBenchmark(cipherName + " decrypt " + sizeName, cFramesCount, frameSize, [&]() {
+        output.clear();
+        cryptor->decrypt(output, common::DataConstBuffer(encryptedFrames[frameIndex++]));
+    });
+
+    BOOST_CHECK(output == frame);
+
+    common::ut::runBenchmark(cipherName + " encrypt " + sizeName, cFramesCount, frameSize, [&]() {
+        output.clear();
+        cryptor->encrypt(output, common::DataConstBuffer(frame));
+    });
+
+    cryptor->deinit();
+}
+
+BOOST_AUTO_TEST_CASE(Cryptor_CipherSuites)
+{
+    std::cout << OpenSSL_version(OPENSSL_VERSION) << ", AES acceleration: "
+              << (transport::SSLWrapper().hasAESAcceleration() ? "yes" : "no") << std::endl;
+
+    for(const auto& cipherList : {"ECDHE-RSA-AES128-GCM-SHA256", "ECDHE-RSA-AES256-GCM-SHA384", "ECDHE-RSA-CHACHA20-POLY1305", "ECDHE-RSA-AES128-SHA256"})
+    {
+        for(size_t frameSize : {1024, 4096, 16384})
+        {
+            benchmarkCipherSuite(cipherList, frameSize);
+        }
+    }
+}
+
+BOOST_AUTO_TEST_CASE(Cryptor_VideoFrames)
+{
+    benchmarkCryptor("Cryptor", false);
+}
+
+BOOST_AUTO_TEST_CASE(Cryptor_RecordLayerVideoFrames)
+{
+    benchmarkCryptor("Cryptor with RecordLayer", true);
+}
+
+void benchmarkCryptorBatch(const std::string& name, bool useRecordLayer)
+{
+    const size_t cFrameSize = 1024;
+    const size_t cBatchSize = 8;
+    const size_t cBatchesCount = 1000;
+
+    CryptorOptions options;
+    options.useRecordLayer = useRecordLayer;
+
+    auto cryptor(std::make_shared<Cryptor>(std::make_shared<transport::SSLWrapper>(), options));
+    cryptor->init();
+
+    SSLServer server;
+    server.connect(*cryptor);
+
+    const common::Data frame(cFrameSize, 0x5A);
+    const std::vector<common::DataConstBuffer> buffers(cBatchSize, common::DataConstBuffer(frame));
+    std::vector<common::Data> outputs(cBatchSize);
+
+    common::ut::runBenchmark(name + " encrypt 8 x 1KB frames", cBatchesCount, cFrameSize * cBatchSize, [&]() {
+        for(size_t i = 0; i < cBatchSize; ++i)
+        {
+            outputs[i].clear();
+            cryptor->encrypt(outputs[i], buffers[i]);
+        }
+    });
+
+    common::ut::runBenchmark(name + " encrypt 8 x 1KB frames batched", cBatchesCount, cFrameSize * cBatchSize, [&]() {
+        for(auto& output : outputs)
+        {
+            output.clear();
+        }
+
+        cryptor->encryptBatch(outputs, buffers);
+    });
+
+    BOOST_CHECK_GT(outputs.back().size(), cFrameSize);
+    cryptor->deinit();
+}
+
+BOOST_AUTO_TEST_CASE(Cryptor_BatchFrames)
+{
+    benchmarkCryptorBatch("Cryptor", false);
+    benchmarkCryptorBatch("Cryptor with RecordLayer", true);
+}
+
+BOOST_AUTO_TEST_CASE(Cryptor_RecordLayerParallelVideoFrames)
+{
+    const size_t cFrameSize = 16384;
+    const size_t cFramesCount = 2000;
+
+    CryptorOptions options;
+    options.useRecordLayer = true;
+
+    auto cryptor(std::make_shared<Cryptor>(std::make_shared<transport::SSLWrapper>(), options));
+    cryptor->init();
+
+    SSLServer server;
+    server.connect(*cryptor);
+
+    const common::Data frame(cFrameSize, 0x5A);
+    std::vector<common::Data> encryptedFrames;
+    encryptedFrames.reserve(cFramesCount);
+
+    for(size_t i = 0; i < cFramesCount; ++i)
+    {
+        encryptedFrames.push_back(server.encrypt(common::DataConstBuffer(frame)));
+    }
+
+    common::Data output(cFrameSize * cFramesCount);
+    io::WorkerPool workerPool;
+
+    common::ut::runBenchmark("Cryptor with RecordLayer decrypt 16KB frames on " + std::to_string(workerPool.getThreadsCount()) + " threads",
+                             1, cFrameSize * cFramesCount, [&]() {
+        std::atomic<size_t> pendingTasksCount(cFramesCount);
+
+        for(size_t i = 0; i < cFramesCount; ++i)
+        {
+            size_t plaintextSize = 0;
+            auto decryptTask = cryptor->prepareDecrypt(common::DataConstBuffer(encryptedFrames[i]), plaintextSize);
+
+            workerPool.post([&, i, decryptTask = std::move(decryptTask)]() {
+                error::Error e;
+                decryptTask(common::DataConstBuffer(encryptedFrames[i]), &output[i * cFrameSize], e);
+                --pendingTasksCount;
+            });
+        }
+
+        while(pendingTasksCount > 0)
+        {
+            std::this_thread::yield();
+        }
+    });
+
+    BOOST_CHECK(common::Data(output.end() - cFrameSize, output.end()) == frame);
+    cryptor->deinit();
+}
+
+BOOST_AUTO_TEST_CASE(Cryptor_Reconnect)
+{
+    const size_t cReconnectsCount = 100;
+
+    auto sslWrapper(std::make_shared<transport::SSLWrapper>());
+    SSLServer server;
+
+    common::ut::runBenchmark("CryptorContext creation", cReconnectsCount, 0, [&]() {
+        CryptorContext cryptorContext(sslWrapper, server.getCertificate(), server.getPrivateKey());
+    });
+
+    // Shared contexts live only while referenced, so keep one across the reconnects.
+    auto cryptorContext = Cryptor::getSharedContext(sslWrapper);
+
+    common::ut::runBenchmark("Cryptor reconnect with shared context", cReconnectsCount, 0, [&]() {
+        Cryptor cryptor(sslWrapper);
+        cryptor.init();
+        server.reset();
+        server.connect(cryptor);
+        cryptor.deinit();
+    });
+
+    common::ut::runBenchmark("Cryptor reconnect with resumed session", cReconnectsCount, 0, [&]() {
+        Cryptor cryptor(sslWrapper);
+        cryptor.setSessionKey("Cryptor_Reconnect");
+        cryptor.init();
+        server.reset();
+        server.connect(cryptor);
+        cryptor.deinit();
+    });
+}
+
+}
+}
+}
+}
@@ -17,9 +17,12 @@
 */
 
 #include <algorithm>
+#include <chrono>
 #include <functional>
+#include <new>
 #include <f1x/aasdk/Messenger/Cryptor.hpp>
 #include <f1x/aasdk/Error/Error.hpp>
+#include <f1x/aasdk/Common/Log.hpp>
 
 namespace f1x
 {
@@ -28,14 +31,13 @@ namespace aasdk
 namespace messenger
 {
 
-Cryptor::Cryptor(transport::ISSLWrapper::Pointer sslWrapper)
+Cryptor::Cryptor(transport::ISSLWrapper::Pointer sslWrapper, CryptorOptions options)
     : sslWrapper_(std::move(sslWrapper))
     , maxBufferSize_(1024 * 20)
-    , certificate_(nullptr)
-    , privateKey_(nullptr)
-    , context_(nullptr)
     , ssl_(nullptr)
     , isActive_(false)
+    , options_(std::move(options))
+    , hasPendingOutput_(false)
 {
 
 }
@@ -44,49 +46,17 @@ void Cryptor::init()
 {
     std::lock_guard<decltype(mutex_)> lock(mutex_);
 
-    certificate_ = sslWrapper_->readCertificate(cCertificate);
+    cryptorContext_ = getSharedContext(sslWrapper_);
+    ssl_ = sslWrapper_->createInstance(cryptorContext_->getContext());
 
-    if(certificate_ == nullptr)
-    {
-        throw error::Error(error::ErrorCode::SSL_READ_CERTIFICATE);
-    }
-
-    privateKey_ = sslWrapper_->readPrivateKey(cPrivateKey);
-
-    if(privateKey_ == nullptr)
-    {
-        throw error::Error(error::ErrorCode::SSL_READ_PRIVATE_KEY);
-    }
-
-    auto method = sslWrapper_->getMethod();
-
-    if(method == nullptr)
-    {
-        throw error::Error(error::ErrorCode::SSL_METHOD);
-    }
-
-    context_ = sslWrapper_->createContext(method);
-
-    if(context_ == nullptr)
-    {
-        throw error::Error(error::ErrorCode::SSL_CONTEXT_CREATION);
-    }
-
-    if(!sslWrapper_->useCertificate(context_, certificate_))
-    {
-        throw error::Error(error::ErrorCode::SSL_USE_CERTIFICATE);
-    }
-
-    if(!sslWrapper_->usePrivateKey(context_, privateKey_))
+    if(ssl_ == nullptr)
     {
-        throw error::Error(error::ErrorCode::SSL_USE_PRIVATE_KEY);
+        throw error::Error(error::ErrorCode::SSL_HANDLER_CREATION);
     }
 
-    ssl_ = sslWrapper_->createInstance(context_);
-
-    if(ssl_ == nullptr)
+    if(options_.useFastestCipher && !sslWrapper_->setCipherList(ssl_, this->getFastestCipherList()))
     {
-        throw error::Error(error::ErrorCode::SSL_HANDLER_CREATION);
+        throw error::Error(error::ErrorCode::SSL_CIPHER_LIST);
     }
 
     bIOs_ = sslWrapper_->createBIOs();
@@ -104,51 +74,67 @@ void Cryptor::init()
     sslWrapper_->setBIOs(ssl_, bIOs_, maxBufferSize_);
 
     sslWrapper_->setConnectState(ssl_);
+
+    handshakeMetrics_ = HandshakeMetrics();
+
+    if(!sessionKey_.empty())
+    {
+        cryptorContext_->resumeSession(sessionKey_, ssl_);
+    }
 }
 
 void Cryptor::deinit()
 {
-    std::lock_guard<decltype(mutex_)> lock(mutex_);
+    std::lock(encryptMutex_, decryptMutex_, mutex_);
+    std::lock_guard<decltype(encryptMutex_)> encryptLock(encryptMutex_, std::adopt_lock);
+    std::lock_guard<decltype(decryptMutex_)> decryptLock(decryptMutex_, std::adopt_lock);
+    std::lock_guard<decltype(mutex_)> lock(mutex_, std::adopt_lock);
+
+    recordLayer_.reset();
 
     if(ssl_ != nullptr)
     {
+        if(isActive_)
+        {
+            this->storeSession();
+        }
+
         sslWrapper_->free(ssl_);
         ssl_ = nullptr;
     }
 
     bIOs_ = std::make_pair(nullptr, nullptr);
-
-    if(context_ != nullptr)
-    {
-        sslWrapper_->free(context_);
-        context_ = nullptr;
-    }
-
-    if(certificate_ != nullptr)
-    {
-        sslWrapper_->free(certificate_);
-        certificate_ = nullptr;
-    }
-
-    if(privateKey_ != nullptr)
-    {
-        sslWrapper_->free(privateKey_);
-        privateKey_ = nullptr;
-    }
+    cryptorContext_.reset();
 }
 
 bool Cryptor::doHandshake()
 {
-    std::lock_guard<decltype(mutex_)> lock(mutex_);
+    std::lock(encryptMutex_, decryptMutex_, mutex_);
+    std::lock_guard<decltype(encryptMutex_)> encryptLock(encryptMutex_, std::adopt_lock);
+    std::lock_guard<decltype(decryptMutex_)> decryptLock(decryptMutex_, std::adopt_lock);
+    std::lock_guard<decltype(mutex_)> lock(mutex_, std::adopt_lock);
 
+    const auto startTime = std::chrono::steady_clock::now();
     auto result = sslWrapper_->doHandshake(ssl_);
+    handshakeMetrics_.processingTime += std::chrono::steady_clock::now() - startTime;
+
     if(result == SSL_ERROR_WANT_READ)
     {
+        ++handshakeMetrics_.roundTrips;
         return false;
     }
     else if(result == SSL_ERROR_NONE)
     {
         isActive_ = true;
+        handshakeMetrics_.sessionReused = sslWrapper_->isSessionReused(ssl_);
+        handshakeMetrics_.cipherName = sslWrapper_->getCipherName(ssl_);
+        this->storeSession();
+
+        if(options_.useRecordLayer)
+        {
+            this->createRecordLayer();
+        }
+
         return true;
     }
     else
@@ -159,55 +145,216 @@ bool Cryptor::doHandshake()
 
 size_t Cryptor::encrypt(common::Data& output, const common::DataConstBuffer& buffer)
 {
+    error::Error e;
+    const auto size = this->encrypt(output, buffer, e);
+
+    if(e != error::ErrorCode::NONE)
+    {
+        throw e;
+    }
+
+    return size;
+}
+
+size_t Cryptor::encrypt(common::Data& output, const common::DataConstBuffer& buffer, error::Error& e) noexcept
+{
+    std::lock_guard<decltype(encryptMutex_)> encryptLock(encryptMutex_);
+
+    if(recordLayer_ != nullptr)
+    {
+        size_t pendingSize = 0;
+
+        if(hasPendingOutput_)
+        {
+            std::lock_guard<decltype(mutex_)> lock(mutex_);
+
+            try
+            {
+                pendingSize = sslWrapper_->bioCtrlPending(bIOs_.second) > 0 ? this->read(output, e) : 0;
+            }
+            catch(const std::bad_alloc&)
+            {
+                e = error::Error(error::ErrorCode::SSL_BIO_READ);
+            }
+
+            hasPendingOutput_ = false;
+        }
+
+        return e != error::ErrorCode::NONE ? pendingSize : pendingSize + recordLayer_->encrypt(output, buffer, e);
+    }
+
     std::lock_guard<decltype(mutex_)> lock(mutex_);
+    const size_t beginOffset = output.size();
 
-    size_t totalWrittenBytes = 0;
+    try
+    {
+        return this->writeRecords(output, buffer, e);
+    }
+    catch(const std::bad_alloc&)
+    {
+        sslWrapper_->setBIOOutput(bIOs_.second, nullptr);
+        e = error::Error(error::ErrorCode::SSL_WRITE);
+        return output.size() - beginOffset;
+    }
+}
 
-    while(totalWrittenBytes < buffer.size)
+void Cryptor::encryptBatch(std::vector<common::Data>& outputs, const std::vector<common::DataConstBuffer>& buffers)
+{
+    error::Error e;
+    this->encryptBatch(outputs, buffers, e);
+
+    if(e != error::ErrorCode::NONE)
     {
-        const common::DataConstBuffer currentBuffer(buffer.cdata, buffer.size, totalWrittenBytes);
-        const auto writeSize = sslWrapper_->sslWrite(ssl_, currentBuffer.cdata, currentBuffer.size);
+        throw e;
+    }
+}
 
-        if(writeSize <= 0)
+void Cryptor::encryptBatch(std::vector<common::Data>& outputs, const std::vector<common::DataConstBuffer>& buffers, error::Error& e) noexcept
+{
+    std::lock_guard<decltype(encryptMutex_)> encryptLock(encryptMutex_);
+
+    if(recordLayer_ != nullptr)
+    {
+        if(hasPendingOutput_ && !outputs.empty())
         {
-            throw error::Error(error::ErrorCode::SSL_WRITE, sslWrapper_->getError(ssl_, writeSize));
+            std::lock_guard<decltype(mutex_)> lock(mutex_);
+
+            try
+            {
+                if(sslWrapper_->bioCtrlPending(bIOs_.second) > 0)
+                {
+                    this->read(outputs.front(), e);
+                }
+            }
+            catch(const std::bad_alloc&)
+            {
+                e = error::Error(error::ErrorCode::SSL_BIO_READ);
+            }
+
+            hasPendingOutput_ = false;
         }
 
-        totalWrittenBytes += writeSize;
+        for(size_t i = 0; i < buffers.size() && e == error::ErrorCode::NONE; ++i)
+        {
+            recordLayer_->encrypt(outputs[i], buffers[i], e);
+        }
+
+        return;
     }
 
-    return this->read(output);
+    std::lock_guard<decltype(mutex_)> lock(mutex_);
+
+    try
+    {
+        for(size_t i = 0; i < buffers.size() && e == error::ErrorCode::NONE; ++i)
+        {
+            this->writeRecords(outputs[i], buffers[i], e);
+        }
+    }
+    catch(const std::bad_alloc&)
+    {
+        sslWrapper_->setBIOOutput(bIOs_.second, nullptr);
+        e = error::Error(error::ErrorCode::SSL_WRITE);
+    }
 }
 
 size_t Cryptor::decrypt(common::Data& output, const common::DataConstBuffer& buffer)
 {
+    error::Error e;
+    const auto size = this->decrypt(output, buffer, e);
+
+    if(e != error::ErrorCode::NONE)
+    {
+        throw e;
+    }
+
+    return size;
+}
+
+size_t Cryptor::decrypt(common::Data& output, const common::DataConstBuffer& buffer, error::Error& e) noexcept
+{
+    std::lock_guard<decltype(decryptMutex_)> decryptLock(decryptMutex_);
+
+    if(recordLayer_ != nullptr)
+    {
+        return recordLayer_->decrypt(output, buffer, e);
+    }
+
     std::lock_guard<decltype(mutex_)> lock(mutex_);
 
-    this->write(buffer);
+    this->write(buffer, e);
+
+    if(e != error::ErrorCode::NONE)
+    {
+        return 0;
+    }
+
+    // Plaintext never exceeds the ciphertext queued in the read BIO plus what SSL has already decrypted.
     const size_t beginOffset = output.size();
-    output.resize(beginOffset + 1);
+    const size_t plaintextBound = sslWrapper_->bioCtrlPending(bIOs_.first) + static_cast<size_t>(sslWrapper_->getAvailableBytes(ssl_));
+
+    try
+    {
+        output.resize(beginOffset + plaintextBound);
+    }
+    catch(const std::bad_alloc&)
+    {
+        e = error::Error(error::ErrorCode::SSL_READ);
+        return 0;
+    }
 
-    size_t availableBytes = 1;
     size_t totalReadSize = 0;
 
-    while(availableBytes > 0)
+    do
     {
         const auto& currentBuffer = common::DataBuffer(output, totalReadSize + beginOffset);
         auto readSize = sslWrapper_->sslRead(ssl_, currentBuffer.data, currentBuffer.size);
 
         if(readSize <= 0)
         {
-            throw error::Error(error::ErrorCode::SSL_READ, sslWrapper_->getError(ssl_, readSize));
+            const auto errorCode = sslWrapper_->getError(ssl_, readSize);
+
+            if(errorCode == SSL_ERROR_WANT_READ && totalReadSize > 0)
+            {
+                break;
+            }
+
+            output.resize(beginOffset + totalReadSize);
+            e = error::Error(error::ErrorCode::SSL_READ, errorCode);
+            return totalReadSize;
         }
 
         totalReadSize += readSize;
-        availableBytes = sslWrapper_->getAvailableBytes(ssl_);
-        output.resize(output.size() + availableBytes);
     }
+    while(totalReadSize < plaintextBound && (sslWrapper_->getAvailableBytes(ssl_) > 0 || sslWrapper_->bioCtrlPending(bIOs_.first) > 0));
 
+    output.resize(beginOffset + totalReadSize);
     return totalReadSize;
 }
 
+ICryptor::DecryptTask Cryptor::prepareDecrypt(const common::DataConstBuffer& buffer, size_t& plaintextSize)
+{
+    std::lock_guard<decltype(decryptMutex_)> decryptLock(decryptMutex_);
+
+    if(recordLayer_ == nullptr)
+    {
+        return DecryptTask();
+    }
+
+    error::Error e;
+    uint64_t sequenceNumber = 0;
+    plaintextSize = recordLayer_->reserveDecrypt(buffer, sequenceNumber, e);
+
+    if(e != error::ErrorCode::NONE)
+    {
+        return DecryptTask();
+    }
+
+    return [recordLayer = recordLayer_, sequenceNumber](const common::DataConstBuffer& buffer, uint8_t* output, error::Error& e) {
+        recordLayer->decrypt(output, buffer, sequenceNumber, e);
+    };
+}
+
 common::Data Cryptor::readHandshakeBuffer()
 {
     std::lock_guard<decltype(mutex_)> lock(mutex_);
@@ -221,10 +368,65 @@ void Cryptor::writeHandshakeBuffer(const common::DataConstBuffer& buffer)
 {
     std::lock_guard<decltype(mutex_)> lock(mutex_);
 
-    this->write(buffer);
+    error::Error e;
+    this->write(buffer, e);
+
+    if(e != error::ErrorCode::NONE)
+    {
+        throw e;
+    }
+}
+
+size_t Cryptor::writeRecords(common::Data& output, const common::DataConstBuffer& buffer, error::Error& e)
+{
+    const size_t beginOffset = output.size();
+    this->read(output, e);
+
+    if(e != error::ErrorCode::NONE)
+    {
+        return output.size() - beginOffset;
+    }
+
+    output.reserve(output.size() + buffer.size + (buffer.size / cMaxRecordSize + 1) * cMaxRecordOverhead);
+    sslWrapper_->setBIOOutput(bIOs_.second, &output);
+
+    size_t totalWrittenBytes = 0;
+
+    while(totalWrittenBytes < buffer.size)
+    {
+        const common::DataConstBuffer currentBuffer(buffer.cdata, buffer.size, totalWrittenBytes);
+        const auto writeSize = sslWrapper_->sslWrite(ssl_, currentBuffer.cdata, currentBuffer.size);
+
+        if(writeSize <= 0)
+        {
+            sslWrapper_->setBIOOutput(bIOs_.second, nullptr);
+            e = error::Error(error::ErrorCode::SSL_WRITE, sslWrapper_->getError(ssl_, writeSize));
+            return output.size() - beginOffset;
+        }
+
+        totalWrittenBytes += writeSize;
+    }
+
+    sslWrapper_->setBIOOutput(bIOs_.second, nullptr);
+    this->read(output, e);
+
+    return output.size() - beginOffset;
 }
 
 size_t Cryptor::read(common::Data& output)
+{
+    error::Error e;
+    const auto size = this->read(output, e);
+
+    if(e != error::ErrorCode::NONE)
+    {
+        throw e;
+    }
+
+    return size;
+}
+
+size_t Cryptor::read(common::Data& output, error::Error& e)
 {
     const auto pendingSize = sslWrapper_->bioCtrlPending(bIOs_.second);
 
@@ -239,7 +441,8 @@ size_t Cryptor::read(common::Data& output)
 
         if(readSize <= 0)
         {
-            throw error::Error(error::ErrorCode::SSL_BIO_READ, sslWrapper_->getError(ssl_, readSize));
+            e = error::Error(error::ErrorCode::SSL_BIO_READ, sslWrapper_->getError(ssl_, readSize));
+            return totalReadSize;
         }
 
         totalReadSize += readSize;
@@ -248,7 +451,7 @@ size_t Cryptor::read(common::Data& output)
     return totalReadSize;
 }
 
-void Cryptor::write(const common::DataConstBuffer& buffer)
+void Cryptor::write(const common::DataConstBuffer& buffer, error::Error& e) noexcept
 {
     size_t totalWrittenBytes = 0;
 
@@ -259,20 +462,90 @@ void Cryptor::write(const common::DataConstBuffer& buffer)
 
         if(writeSize <= 0)
         {
-            throw error::Error(error::ErrorCode::SSL_BIO_WRITE, sslWrapper_->getError(ssl_, writeSize));
+            e = error::Error(error::ErrorCode::SSL_BIO_WRITE, sslWrapper_->getError(ssl_, writeSize));
+            return;
         }
 
         totalWrittenBytes += writeSize;
     }
 }
 
+void Cryptor::createRecordLayer()
+{
+    if(sslWrapper_->bioCtrlPending(bIOs_.first) > 0 || sslWrapper_->getAvailableBytes(ssl_) > 0)
+    {
+        return;
+    }
+
+    transport::SSLTrafficKeys trafficKeys;
+
+    if(sslWrapper_->getTrafficKeys(ssl_, trafficKeys))
+    {
+        recordLayer_ = std::make_shared<RecordLayer>(trafficKeys);
+        hasPendingOutput_ = sslWrapper_->bioCtrlPending(bIOs_.second) > 0;
+    }
+}
+
+void Cryptor::storeSession()
+{
+    if(!sessionKey_.empty())
+    {
+        cryptorContext_->storeSession(sessionKey_, ssl_);
+    }
+}
+
+const std::string& Cryptor::getFastestCipherList() const
+{
+    if(sslWrapper_->hasAESAcceleration())
+    {
+        return cAESCipherList;
+    }
+
+    // The record layer only handles AES-GCM, so ChaCha20 would silently disable it.
+    if(options_.useRecordLayer)
+    {
+        AASDK_LOG(info) << "[Cryptor] no AES acceleration, keeping AES-GCM for the record layer.";
+        return cAESCipherList;
+    }
+
+    AASDK_LOG(info) << "[Cryptor] no AES acceleration, preferring ChaCha20-Poly1305.";
+    return cChaChaCipherList;
+}
+
 bool Cryptor::isActive() const
+{
+    return isActive_;
+}
+
+void Cryptor::setSessionKey(const std::string& sessionKey)
 {
     std::lock_guard<decltype(mutex_)> lock(mutex_);
 
-    return isActive_;
+    sessionKey_ = sessionKey;
 }
 
+HandshakeMetrics Cryptor::getHandshakeMetrics() const
+{
+    std::lock_guard<decltype(mutex_)> lock(mutex_);
+
+    return handshakeMetrics_;
+}
+
+bool Cryptor::hasRecordLayer() const
+{
+    std::lock_guard<decltype(decryptMutex_)> decryptLock(decryptMutex_);
+
+    return recordLayer_ != nullptr;
+}
+
+CryptorContext::Pointer Cryptor::getSharedContext(transport::ISSLWrapper::Pointer sslWrapper)
+{
+    return CryptorContext::getShared(std::move(sslWrapper), cCertificate, cPrivateKey);
+}
+
+const std::string Cryptor::cAESCipherList = "ECDHE-RSA-AES128-GCM-SHA256:AES128-GCM-SHA256:ECDHE-RSA-AES256-GCM-SHA384:AES256-GCM-SHA384:ECDHE-RSA-CHACHA20-POLY1305";
+const std::string Cryptor::cChaChaCipherList = "ECDHE-RSA-CHACHA20-POLY1305:ECDHE-RSA-AES128-GCM-SHA256:AES128-GCM-SHA256:ECDHE-RSA-AES256-GCM-SHA384:AES256-GCM-SHA384";
+
 const std::string Cryptor::cCertificate = "-----BEGIN CERTIFICATE-----\n\
 MIIDKjCCAhICARswDQYJKoZIhvcNAQELBQAwWzELMAkGA1UEBhMCVVMxEzARBgNV\n\
 BAgMCkNhbGlmb3JuaWExFjAUBgNVBAcMDU1vdW50YWluIFZpZXcxHzAdBgNVBAoM\n\
@@ -0,0 +1,416 @@
+/*
+*  This file is part of aasdk library project.
+*  Copyright (C) 2018 f1x.studio (Michal Szwaj)
+*
+*  aasdk is free software: you can redistribute it and/or modify
+*  it under the terms of the GNU General Public License as published by
+*  the Free Software Foundation; either version 3 of the License, or
+*  (at your option) any later version.
+
+*  aasdk is distributed in the hope that it will be useful,
+*  but WITHOUT ANY WARRANTY; without even the implied warranty of
+*  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+*  GNU General Public License for more details.
+*
+*  You should have received a copy of the GNU General Public License
+*  along with aasdk. If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include <algorithm>
+#include <thread>
+#include <boost/test/unit_test.hpp>
+#include <f1x/aasdk/Messenger/UT/SSLServer.hpp>
+#include <f1x/aasdk/Transport/SSLWrapper.hpp>
+#include <f1x/aasdk/Error/Error.hpp>
+#include <f1x/aasdk/Messenger/Cryptor.hpp>
+
+namespace f1x
+{
+namespace aasdk
+{
+namespace messenger
+{
+namespace ut
+{
+
+class CryptorUnitTest
+{
+protected:
+    CryptorUnitTest(CryptorOptions options = CryptorOptions(), int maxProtocolVersion = TLS1_2_VERSION)
+        : cryptor_(std::make_shared<Cryptor>(std::make_shared<transport::SSLWrapper>(), std::move(options)))
+        , server_(maxProtocolVersion)
+    {
+        cryptor_->init();
+        server_.connect(*cryptor_);
+    }
+
+    ~CryptorUnitTest()
+    {
+        cryptor_->deinit();
+    }
+
+    static common::Data createPayload(size_t size)
+    {
+        common::Data payload;
+        for(size_t i = 0; i < size; ++i)
+        {
+            payload.push_back(static_cast<uint8_t>(i));
+        }
+
+        return payload;
+    }
+
+    static CryptorOptions getRecordLayerOptions()
+    {
+        CryptorOptions options;
+        options.useRecordLayer = true;
+        return options;
+    }
+
+    std::shared_ptr<Cryptor> cryptor_;
+    SSLServer server_;
+};
+
+class RecordLayerCryptorUnitTest: public CryptorUnitTest
+{
+protected:
+    RecordLayerCryptorUnitTest()
+        : CryptorUnitTest(getRecordLayerOptions())
+    {
+
+    }
+};
+
+class TLS13RecordLayerCryptorUnitTest: public CryptorUnitTest
+{
+protected:
+    TLS13RecordLayerCryptorUnitTest()
+        : CryptorUnitTest(getRecordLayerOptions(), TLS1_3_VERSION)
+    {
+
+    }
+};
+
+BOOST_FIXTURE_TEST_CASE(Cryptor_Handshake, CryptorUnitTest)
+{
+    BOOST_CHECK(cryptor_->isActive());
+    BOOST_CHECK(!cryptor_->hasRecordLayer());
+}
+
+BOOST_FIXTURE_TEST_CASE(Cryptor_HandshakeMetrics, CryptorUnitTest)
+{
+    const auto handshakeMetrics = cryptor_->getHandshakeMetrics();
+    BOOST_CHECK_EQUAL(handshakeMetrics.roundTrips, 2);
+    BOOST_CHECK(handshakeMetrics.processingTime.count() > 0);
+    BOOST_CHECK(!handshakeMetrics.sessionReused);
+    BOOST_CHECK(!handshakeMetrics.cipherName.empty());
+}
+
+BOOST_AUTO_TEST_CASE(Cryptor_UseFastestCipher)
+{
+    auto sslWrapper(std::make_shared<transport::SSLWrapper>());
+    CryptorOptions options;
+    options.useFastestCipher = true;
+
+    Cryptor cryptor(sslWrapper, options);
+    cryptor.init();
+
+    SSLServer server;
+    server.connect(cryptor);
+    BOOST_CHECK_EQUAL(cryptor.getHandshakeMetrics().cipherName, sslWrapper->hasAESAcceleration() ? "ECDHE-RSA-AES128-GCM-SHA256" : "ECDHE-RSA-CHACHA20-POLY1305");
+    cryptor.deinit();
+}
+
+BOOST_AUTO_TEST_CASE(Cryptor_UseFastestCipherKeepsRecordLayer)
+{
+    auto sslWrapper(std::make_shared<transport::SSLWrapper>());
+    CryptorOptions options;
+    options.useFastestCipher = true;
+    options.useRecordLayer = true;
+
+    Cryptor cryptor(sslWrapper, options);
+    cryptor.init();
+
+    SSLServer server;
+    server.connect(cryptor);
+    BOOST_CHECK_EQUAL(cryptor.getHandshakeMetrics().cipherName, "ECDHE-RSA-AES128-GCM-SHA256");
+    BOOST_CHECK(cryptor.hasRecordLayer());
+    cryptor.deinit();
+}
+
+BOOST_FIXTURE_TEST_CASE(Cryptor_ResumeSession, CryptorUnitTest)
+{
+    auto sslWrapper(std::make_shared<transport::SSLWrapper>());
+    auto cryptorContext = Cryptor::getSharedContext(sslWrapper);
+
+    Cryptor firstCryptor(sslWrapper);
+    firstCryptor.setSessionKey("Cryptor_ResumeSession");
+    firstCryptor.init();
+    server_.reset();
+    server_.connect(firstCryptor);
+    firstCryptor.deinit();
+    BOOST_CHECK(!firstCryptor.getHandshakeMetrics().sessionReused);
+
+    Cryptor secondCryptor(sslWrapper);
+    secondCryptor.setSessionKey("Cryptor_ResumeSession");
+    secondCryptor.init();
+    server_.reset();
+    server_.connect(secondCryptor);
+    BOOST_CHECK(secondCryptor.getHandshakeMetrics().sessionReused);
+    BOOST_CHECK_EQUAL(secondCryptor.getHandshakeMetrics().roundTrips, 1);
+
+    const common::Data payload(1000, 0x5E);
+    common::Data encryptedData;
+    secondCryptor.encrypt(encryptedData, common::DataConstBuffer(payload));
+    BOOST_CHECK(server_.decrypt(common::DataConstBuffer(encryptedData)) == payload);
+    secondCryptor.deinit();
+
+    Cryptor otherDeviceCryptor(sslWrapper);
+    otherDeviceCryptor.setSessionKey("Cryptor_ResumeSession_OtherDevice");
+    otherDeviceCryptor.init();
+    server_.reset();
+    server_.connect(otherDeviceCryptor);
+    BOOST_CHECK(!otherDeviceCryptor.getHandshakeMetrics().sessionReused);
+    otherDeviceCryptor.deinit();
+}
+
+BOOST_FIXTURE_TEST_CASE(Cryptor_EncryptMessage, CryptorUnitTest)
+{
+    const common::Data payload(1000, 0x5E);
+
+    common::Data encryptedData;
+    const auto encryptedSize = cryptor_->encrypt(encryptedData, common::DataConstBuffer(payload));
+    BOOST_CHECK_EQUAL(encryptedSize, encryptedData.size());
+    BOOST_CHECK(server_.decrypt(common::DataConstBuffer(encryptedData)) == payload);
+}
+
+BOOST_FIXTURE_TEST_CASE(Cryptor_EncryptAfterFrameHeader, CryptorUnitTest)
+{
+    const auto payload(createPayload(40000));
+    const common::Data frameHeader{0x01, 0x02, 0x03, 0x04, 0x05, 0x06, 0x07, 0x08};
+
+    common::Data output(frameHeader);
+    const auto encryptedSize = cryptor_->encrypt(output, common::DataConstBuffer(payload));
+    BOOST_CHECK_EQUAL(output.size(), frameHeader.size() + encryptedSize);
+    BOOST_CHECK(common::Data(output.begin(), output.begin() + frameHeader.size()) == frameHeader);
+    BOOST_CHECK(server_.decrypt(common::DataConstBuffer(output, frameHeader.size())) == payload);
+}
+
+BOOST_FIXTURE_TEST_CASE(Cryptor_EncryptBatch, CryptorUnitTest)
+{
+    const std::vector<common::Data> payloads{createPayload(16384), createPayload(1000), createPayload(20000)};
+    const common::Data frameHeader{0x01, 0x02, 0x03, 0x04};
+
+    std::vector<common::Data> outputs(payloads.size(), frameHeader);
+    std::vector<common::DataConstBuffer> buffers;
+    for(const auto& payload : payloads)
+    {
+        buffers.emplace_back(payload);
+    }
+
+    cryptor_->encryptBatch(outputs, buffers);
+
+    for(size_t i = 0; i < payloads.size(); ++i)
+    {
+        BOOST_CHECK(common::Data(outputs[i].begin(), outputs[i].begin() + frameHeader.size()) == frameHeader);
+        BOOST_CHECK(server_.decrypt(common::DataConstBuffer(outputs[i], frameHeader.size())) == payloads[i]);
+    }
+}
+
+BOOST_FIXTURE_TEST_CASE(Cryptor_RecordLayerEncryptBatch, RecordLayerCryptorUnitTest)
+{
+    BOOST_REQUIRE(cryptor_->hasRecordLayer());
+
+    const std::vector<common::Data> payloads{createPayload(16384), createPayload(1), createPayload(40000)};
+    std::vector<common::Data> outputs(payloads.size());
+    std::vector<common::DataConstBuffer> buffers;
+    for(const auto& payload : payloads)
+    {
+        buffers.emplace_back(payload);
+    }
+
+    cryptor_->encryptBatch(outputs, buffers);
+
+    for(size_t i = 0; i < payloads.size(); ++i)
+    {
+        BOOST_CHECK(server_.decrypt(common::DataConstBuffer(outputs[i])) == payloads[i]);
+    }
+}
+
+BOOST_FIXTURE_TEST_CASE(Cryptor_DecryptMultipleRecords, CryptorUnitTest)
+{
+    const auto payload(createPayload(40000));
+    const auto encryptedData = server_.encrypt(common::DataConstBuffer(payload));
+
+    common::Data output{0x01, 0x02};
+    output.reserve(output.size() + encryptedData.size());
+    const auto capacity = output.capacity();
+    const auto* outputData = output.data();
+
+    BOOST_CHECK_EQUAL(cryptor_->decrypt(output, common::DataConstBuffer(encryptedData)), payload.size());
+    BOOST_CHECK_EQUAL(output.capacity(), capacity);
+    BOOST_CHECK(output.data() == outputData);
+
+    common::Data expectedOutput{0x01, 0x02};
+    expectedOutput.insert(expectedOutput.end(), payload.begin(), payload.end());
+    BOOST_CHECK(output == expectedOutput);
+}
+
+BOOST_FIXTURE_TEST_CASE(Cryptor_RecordLayerEncrypt, RecordLayerCryptorUnitTest)
+{
+    BOOST_REQUIRE(cryptor_->hasRecordLayer());
+
+    for(size_t size : {1, 1000, 16384, 40000})
+    {
+        const auto payload(createPayload(size));
+
+        common::Data encryptedData;
+        const auto encryptedSize = cryptor_->encrypt(encryptedData, common::DataConstBuffer(payload));
+        BOOST_CHECK_EQUAL(encryptedSize, encryptedData.size());
+        BOOST_CHECK_EQUAL(encryptedData.size(), size + ((size + 16383) / 16384) * 29);
+        BOOST_CHECK(server_.decrypt(common::DataConstBuffer(encryptedData)) == payload);
+    }
+}
+
+BOOST_FIXTURE_TEST_CASE(Cryptor_RecordLayerDecrypt, RecordLayerCryptorUnitTest)
+{
+    BOOST_REQUIRE(cryptor_->hasRecordLayer());
+
+    for(size_t size : {1, 1000, 16384, 40000})
+    {
+        const auto payload(createPayload(size));
+        const auto encryptedData = server_.encrypt(common::DataConstBuffer(payload));
+
+        common::Data output;
+        BOOST_CHECK_EQUAL(cryptor_->decrypt(output, common::DataConstBuffer(encryptedData)), payload.size());
+        BOOST_CHECK(output == payload);
+    }
+}
+
+BOOST_FIXTURE_TEST_CASE(Cryptor_RecordLayerParallelDecrypt, RecordLayerCryptorUnitTest)
+{
+    BOOST_REQUIRE(cryptor_->hasRecordLayer());
+
+    std::vector<common::Data> payloads;
+    std::vector<common::Data> encryptedFrames;
+    std::vector<common::Data> outputs;
+    std::vector<ICryptor::DecryptTask> decryptTasks;
+
+    for(size_t size : {16384, 1000, 40000, 1})
+    {
+        payloads.push_back(createPayload(size));
+        encryptedFrames.push_back(server_.encrypt(common::DataConstBuffer(payloads.back())));
+
+        size_t plaintextSize = 0;
+        decryptTasks.push_back(cryptor_->prepareDecrypt(common::DataConstBuffer(encryptedFrames.back()), plaintextSize));
+        BOOST_REQUIRE(decryptTasks.back());
+        BOOST_CHECK_EQUAL(plaintextSize, size);
+        outputs.emplace_back(plaintextSize);
+    }
+
+    std::vector<std::thread> threads;
+    std::vector<error::Error> errors(decryptTasks.size());
+    for(size_t i = decryptTasks.size(); i > 0; --i)
+    {
+        threads.emplace_back([&, i]() { decryptTasks[i - 1](common::DataConstBuffer(encryptedFrames[i - 1]), outputs[i - 1].data(), errors[i - 1]); });
+    }
+
+    for(auto& thread : threads)
+    {
+        thread.join();
+    }
+
+    for(const auto& e : errors)
+    {
+        BOOST_CHECK(e == error::ErrorCode::NONE);
+    }
+
+    BOOST_CHECK(outputs == payloads);
+
+    const auto payload(createPayload(1000));
+    common::Data output;
+    cryptor_->decrypt(output, common::DataConstBuffer(server_.encrypt(common::DataConstBuffer(payload))));
+    BOOST_CHECK(output == payload);
+}
+
+BOOST_FIXTURE_TEST_CASE(Cryptor_RecordLayerConcurrentEncryptDecrypt, RecordLayerCryptorUnitTest)
+{
+    BOOST_REQUIRE(cryptor_->hasRecordLayer());
+
+    const size_t cFramesCount = 200;
+    const auto payload(createPayload(16384));
+
+    std::vector<common::Data> encryptedFrames;
+    for(size_t i = 0; i < cFramesCount; ++i)
+    {
+        encryptedFrames.push_back(server_.encrypt(common::DataConstBuffer(payload)));
+    }
+
+    std::vector<common::Data> decryptedFrames(cFramesCount);
+    std::thread decryptThread([&]() {
+        for(size_t i = 0; i < cFramesCount; ++i)
+        {
+            cryptor_->decrypt(decryptedFrames[i], common::DataConstBuffer(encryptedFrames[i]));
+        }
+    });
+
+    common::Data encryptedData;
+    for(size_t i = 0; i < cFramesCount; ++i)
+    {
+        cryptor_->encrypt(encryptedData, common::DataConstBuffer(payload));
+        BOOST_CHECK(cryptor_->isActive());
+    }
+
+    decryptThread.join();
+
+    BOOST_CHECK(std::all_of(decryptedFrames.begin(), decryptedFrames.end(), [&](const auto& frame) { return frame == payload; }));
+    BOOST_CHECK_EQUAL(server_.decrypt(common::DataConstBuffer(encryptedData)).size(), payload.size() * cFramesCount);
+}
+
+BOOST_FIXTURE_TEST_CASE(Cryptor_RecordLayerRejectTamperedRecord, RecordLayerCryptorUnitTest)
+{
+    BOOST_REQUIRE(cryptor_->hasRecordLayer());
+
+    const auto payload(createPayload(1000));
+    auto encryptedData = server_.encrypt(common::DataConstBuffer(payload));
+    encryptedData[100] ^= 0x01;
+
+    common::Data output{0x01};
+    BOOST_CHECK_THROW(cryptor_->decrypt(output, common::DataConstBuffer(encryptedData)), error::Error);
+    BOOST_CHECK_EQUAL(output.size(), 1u);
+}
+
+BOOST_FIXTURE_TEST_CASE(Cryptor_RecordLayerReportTruncatedRecord, RecordLayerCryptorUnitTest)
+{
+    BOOST_REQUIRE(cryptor_->hasRecordLayer());
+
+    const auto payload(createPayload(1000));
+    auto encryptedData = server_.encrypt(common::DataConstBuffer(payload));
+    encryptedData.resize(encryptedData.size() - 1);
+
+    size_t plaintextSize = 0;
+    BOOST_CHECK(!cryptor_->prepareDecrypt(common::DataConstBuffer(encryptedData), plaintextSize));
+
+    error::Error e;
+    common::Data output;
+    BOOST_CHECK_EQUAL(cryptor_->decrypt(output, common::DataConstBuffer(encryptedData), e), 0u);
+    BOOST_CHECK(e == error::ErrorCode::SSL_READ);
+    BOOST_CHECK(output.empty());
+}
+
+BOOST_FIXTURE_TEST_CASE(Cryptor_RecordLayerFallbackForTLS13, TLS13RecordLayerCryptorUnitTest)
+{
+    BOOST_CHECK(!cryptor_->hasRecordLayer());
+
+    const auto payload(createPayload(1000));
+    const auto encryptedData = server_.encrypt(common::DataConstBuffer(payload));
+
+    common::Data output;
+    cryptor_->decrypt(output, common::DataConstBuffer(encryptedData));
+    BOOST_CHECK(output == payload);
+}
+
+}
+}
+}
+}
@@ -0,0 +1,199 @@
+/*
+*  This file is part of aasdk library project.
+*  Copyright (C) 2018 f1x.studio (Michal Szwaj)
+*
+*  aasdk is free software: you can redistribute it and/or modify
+*  it under the terms of the GNU General Public License as published by
+*  the Free Software Foundation; either version 3 of the License, or
+*  (at your option) any later version.
+
+*  aasdk is distributed in the hope that it will be useful,
+*  but WITHOUT ANY WARRANTY; without even the implied warranty of
+*  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+*  GNU General Public License for more details.
+*
+*  You should have received a copy of the GNU General Public License
+*  along with aasdk. If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include <algorithm>
+#include <iterator>
+#include <map>
+#include <tuple>
+#include <f1x/aasdk/Messenger/CryptorContext.hpp>
+#include <f1x/aasdk/Error/Error.hpp>
+
+namespace f1x
+{
+namespace aasdk
+{
+namespace messenger
+{
+
+CryptorContext::CryptorContext(transport::ISSLWrapper::Pointer sslWrapper, const std::string& certificate, const std::string& privateKey)
+    : sslWrapper_(std::move(sslWrapper))
+    , certificate_(nullptr)
+    , privateKey_(nullptr)
+    , context_(nullptr)
+{
+    try
+    {
+        certificate_ = sslWrapper_->readCertificate(certificate);
+
+        if(certificate_ == nullptr)
+        {
+            throw error::Error(error::ErrorCode::SSL_READ_CERTIFICATE);
+        }
+
+        privateKey_ = sslWrapper_->readPrivateKey(privateKey);
+
+        if(privateKey_ == nullptr)
+        {
+            throw error::Error(error::ErrorCode::SSL_READ_PRIVATE_KEY);
+        }
+
+        auto method = sslWrapper_->getMethod();
+
+        if(method == nullptr)
+        {
+            throw error::Error(error::ErrorCode::SSL_METHOD);
+        }
+
+        context_ = sslWrapper_->createContext(method);
+
+        if(context_ == nullptr)
+        {
+            throw error::Error(error::ErrorCode::SSL_CONTEXT_CREATION);
+        }
+
+        if(!sslWrapper_->useCertificate(context_, certificate_))
+        {
+            throw error::Error(error::ErrorCode::SSL_USE_CERTIFICATE);
+        }
+
+        if(!sslWrapper_->usePrivateKey(context_, privateKey_))
+        {
+            throw error::Error(error::ErrorCode::SSL_USE_PRIVATE_KEY);
+        }
+    }
+    catch(const error::Error&)
+    {
+        this->release();
+        throw;
+    }
+}
+
+CryptorContext::~CryptorContext()
+{
+    this->release();
+}
+
+SSL_CTX* CryptorContext::getContext() const
+{
+    return context_;
+}
+
+void CryptorContext::storeSession(const std::string& sessionKey, SSL* ssl)
+{
+    auto session = sslWrapper_->getSession(ssl);
+
+    if(session == nullptr)
+    {
+        return;
+    }
+
+    std::lock_guard<decltype(sessionsMutex_)> lock(sessionsMutex_);
+
+    auto iter = this->findSession(sessionKey);
+
+    if(iter != sessions_.end())
+    {
+        sslWrapper_->free(iter->second);
+        sessions_.erase(iter);
+    }
+    else if(sessions_.size() >= cMaxSessionsCount)
+    {
+        sslWrapper_->free(sessions_.back().second);
+        sessions_.pop_back();
+    }
+
+    sessions_.emplace_front(sessionKey, session);
+}
+
+bool CryptorContext::resumeSession(const std::string& sessionKey, SSL* ssl)
+{
+    std::lock_guard<decltype(sessionsMutex_)> lock(sessionsMutex_);
+
+    auto iter = this->findSession(sessionKey);
+
+    if(iter == sessions_.end())
+    {
+        return false;
+    }
+
+    sessions_.splice(sessions_.begin(), sessions_, iter);
+    return sslWrapper_->setSession(ssl, iter->second);
+}
+
+CryptorContext::Sessions::iterator CryptorContext::findSession(const std::string& sessionKey)
+{
+    return std::find_if(sessions_.begin(), sessions_.end(), [&](const Sessions::value_type& session) { return session.first == sessionKey; });
+}
+
+CryptorContext::Pointer CryptorContext::getShared(transport::ISSLWrapper::Pointer sslWrapper, const std::string& certificate, const std::string& privateKey)
+{
+    typedef std::tuple<const transport::ISSLWrapper*, std::string, std::string> Key;
+
+    static std::mutex mutex;
+    static std::map<Key, std::weak_ptr<CryptorContext>> contexts;
+
+    std::lock_guard<decltype(mutex)> lock(mutex);
+
+    for(auto iter = contexts.begin(); iter != contexts.end();)
+    {
+        iter = iter->second.expired() ? contexts.erase(iter) : std::next(iter);
+    }
+
+    auto& sharedContext = contexts[Key(sslWrapper.get(), certificate, privateKey)];
+    auto context = sharedContext.lock();
+
+    if(context == nullptr)
+    {
+        context = std::make_shared<CryptorContext>(std::move(sslWrapper), certificate, privateKey);
+        sharedContext = context;
+    }
+
+    return context;
+}
+
+void CryptorContext::release()
+{
+    for(const auto& session : sessions_)
+    {
+        sslWrapper_->free(session.second);
+    }
+
+    sessions_.clear();
+
+    if(context_ != nullptr)
+    {
+        sslWrapper_->free(context_);
+        context_ = nullptr;
+    }
+
+    if(certificate_ != nullptr)
+    {
+        sslWrapper_->free(certificate_);
+        certificate_ = nullptr;
+    }
+
+    if(privateKey_ != nullptr)
+    {
+        sslWrapper_->free(privateKey_);
+        privateKey_ = nullptr;
+    }
+}
+
+}
+}
+}
@@ -0,0 +1,99 @@
+/*
+*  This file is part of aasdk library project.
+*  Copyright (C) 2018 f1x.studio (Michal Szwaj)
+*
+*  aasdk is free software: you can redistribute it and/or modify
+*  it under the terms of the GNU General Public License as published by
+*  the Free Software Foundation; either version 3 of the License, or
+*  (at your option) any later version.
+
+*  aasdk is distributed in the hope that it will be useful,
+*  but WITHOUT ANY WARRANTY; without even the implied warranty of
+*  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+*  GNU General Public License for more details.
+*
+*  You should have received a copy of the GNU General Public License
+*  along with aasdk. If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include <boost/test/unit_test.hpp>
+#include <f1x/aasdk/Messenger/UT/SSLServer.hpp>
+#include <f1x/aasdk/Transport/SSLWrapper.hpp>
+#include <f1x/aasdk/Error/Error.hpp>
+#include <f1x/aasdk/Messenger/CryptorContext.hpp>
+
+namespace f1x
+{
+namespace aasdk
+{
+namespace messenger
+{
+namespace ut
+{
+
+class CryptorContextUnitTest
+{
+protected:
+    CryptorContextUnitTest()
+        : sslWrapper_(std::make_shared<transport::SSLWrapper>())
+    {
+
+    }
+
+    transport::ISSLWrapper::Pointer sslWrapper_;
+    SSLServer server_;
+};
+
+BOOST_FIXTURE_TEST_CASE(CryptorContext_ReuseSharedContext, CryptorContextUnitTest)
+{
+    auto context = CryptorContext::getShared(sslWrapper_, server_.getCertificate(), server_.getPrivateKey());
+    BOOST_REQUIRE(context != nullptr);
+    BOOST_CHECK(context->getContext() != nullptr);
+    BOOST_CHECK(CryptorContext::getShared(sslWrapper_, server_.getCertificate(), server_.getPrivateKey()) == context);
+
+    SSLServer otherServer;
+    BOOST_CHECK(CryptorContext::getShared(sslWrapper_, otherServer.getCertificate(), otherServer.getPrivateKey()) != context);
+}
+
+BOOST_FIXTURE_TEST_CASE(CryptorContext_SharedContextPerSSLWrapper, CryptorContextUnitTest)
+{
+    auto context = CryptorContext::getShared(sslWrapper_, server_.getCertificate(), server_.getPrivateKey());
+    auto otherSSLWrapper(std::make_shared<transport::SSLWrapper>());
+    auto otherContext = CryptorContext::getShared(otherSSLWrapper, server_.getCertificate(), server_.getPrivateKey());
+
+    BOOST_CHECK(otherContext != context);
+    BOOST_CHECK(CryptorContext::getShared(otherSSLWrapper, server_.getCertificate(), server_.getPrivateKey()) == otherContext);
+}
+
+BOOST_FIXTURE_TEST_CASE(CryptorContext_ReleaseUnusedSharedContext, CryptorContextUnitTest)
+{
+    auto context = CryptorContext::getShared(sslWrapper_, server_.getCertificate(), server_.getPrivateKey());
+    std::weak_ptr<CryptorContext> releasedContext(context);
+    context.reset();
+
+    BOOST_CHECK(releasedContext.expired());
+    BOOST_CHECK(CryptorContext::getShared(sslWrapper_, server_.getCertificate(), server_.getPrivateKey()) != nullptr);
+}
+
+BOOST_FIXTURE_TEST_CASE(CryptorContext_InvalidCertificate, CryptorContextUnitTest)
+{
+    try
+    {
+        CryptorContext::getShared(sslWrapper_, "invalid", server_.getPrivateKey());
+        BOOST_FAIL("error expected");
+    }
+    catch(const error::Error& e)
+    {
+        BOOST_CHECK(e == error::ErrorCode::SSL_READ_CERTIFICATE);
+    }
+}
+
+BOOST_FIXTURE_TEST_CASE(CryptorContext_InvalidPrivateKey, CryptorContextUnitTest)
+{
+    BOOST_CHECK_THROW(CryptorContext(sslWrapper_, server_.getCertificate(), "invalid"), error::Error);
+}
+
+}
+}
+}
+}
@@ -26,6 +26,8 @@ namespace aasdk
 namespace messenger
 {
 
+constexpr size_t FrameSize::cMaxFramePayloadSize;
+
 FrameSize::FrameSize(size_t frameSize, size_t totalSize)
     : frameSizeType_(FrameSizeType::EXTENDED)
     , frameSize_(frameSize)
@@ -43,6 +45,9 @@ FrameSize::FrameSize(size_t frameSize)
 }
 
 FrameSize::FrameSize(const common::DataConstBuffer& buffer)
+    : frameSizeType_(FrameSizeType::SHORT)
+    , frameSize_(0)
+    , totalSize_(0)
 {
     if(buffer.size >= 2)
     {
@@ -80,6 +85,11 @@ size_t FrameSize::getSize() const
     return frameSize_;
 }
 
+size_t FrameSize::getTotalSize() const
+{
+    return totalSize_;
+}
+
 size_t FrameSize::getSizeOf(FrameSizeType type)
 {
     return type == FrameSizeType::EXTENDED ? 6 : 2;
@@ -30,6 +30,7 @@ Message::Message(ChannelId channelId, EncryptionType encryptionType, MessageType
     : channelId_(channelId)
     , encryptionType_(encryptionType)
     , type_(type)
+    , headroom_(0)
 {
 }
 
@@ -38,7 +39,10 @@ Message::Message(Message&& other)
     , encryptionType_(other.encryptionType_)
     , type_(other.type_)
     , payload_(std::move(other.payload_))
+    , segments_(std::move(other.segments_))
+    , headroom_(other.headroom_)
 {
+    other.headroom_ = 0;
 
 }
 
@@ -48,6 +52,9 @@ Message& Message::operator=(Message&& other)
     encryptionType_ = std::move(other.encryptionType_);
     type_ = std::move(other.type_);
     payload_ = std::move(other.payload_);
+    segments_ = std::move(other.segments_);
+    headroom_ = other.headroom_;
+    other.headroom_ = 0;
 
     return *this;
 }
@@ -69,16 +76,36 @@ MessageType Message::getType() const
 
 common::Data& Message::getPayload()
 {
+    this->materializePayload();
     return payload_;
 }
 
-const common::Data& Message::getPayload() const
+size_t Message::getPayloadSize() const
 {
-    return payload_;
+    return payload_.size() - headroom_ + common::getSize(segments_);
+}
+
+std::vector<common::DataConstBuffer> Message::getPayloadBuffers() const
+{
+    std::vector<common::DataConstBuffer> buffers;
+    buffers.reserve(segments_.size() + 1);
+
+    if(payload_.size() > headroom_)
+    {
+        buffers.emplace_back(payload_, headroom_);
+    }
+
+    for(const auto& segment : segments_)
+    {
+        buffers.push_back(segment.buffer);
+    }
+
+    return buffers;
 }
 
 void Message::insertPayload(const common::Data& payload)
 {
+    this->materializeSegments();
     payload_.insert(payload_.end(), payload.begin(), payload.end());
 }
 
@@ -87,6 +114,7 @@ void Message::insertPayload(const google::protobuf::Message& message)
     if (message.GetTypeName() != "f1x.aasdk.proto.messages.AVMediaAckIndication") {
         AASDK_LOG(debug) << message.GetTypeName() << " - " + message.DebugString();
     }
+    this->materializeSegments();
     auto offset = payload_.size();
     payload_.resize(payload_.size() + message.ByteSize());
 
@@ -96,14 +124,94 @@ void Message::insertPayload(const google::protobuf::Message& message)
 
 void Message::insertPayload(const common::DataConstBuffer& buffer)
 {
+    this->materializeSegments();
     common::copy(payload_, buffer);
 }
 
 void Message::insertPayload(common::DataBuffer& buffer)
 {
+    this->materializeSegments();
     common::copy(payload_, buffer);
 }
 
+void Message::insertPayload(common::DataSegment segment)
+{
+    if(segment.buffer.size > 0)
+    {
+        segments_.push_back(std::move(segment));
+    }
+}
+
+void Message::reserveHeadroom(size_t size)
+{
+    this->materializePayload();
+
+    if(payload_.empty())
+    {
+        payload_.resize(size);
+        headroom_ = size;
+    }
+}
+
+size_t Message::getHeadroom() const
+{
+    return headroom_;
+}
+
+common::Data Message::releaseFrame(const common::Data& header)
+{
+    if(header.size() == headroom_)
+    {
+        this->materializeSegments();
+        std::copy(header.begin(), header.end(), payload_.begin());
+        headroom_ = 0;
+    }
+    else
+    {
+        this->materializePayload();
+        payload_.insert(payload_.begin(), header.begin(), header.end());
+    }
+
+    common::Data frame;
+    std::swap(frame, payload_);
+    return frame;
+}
+
+void Message::materializePayload()
+{
+    if(headroom_ > 0)
+    {
+        payload_.erase(payload_.begin(), payload_.begin() + headroom_);
+        headroom_ = 0;
+    }
+
+    this->materializeSegments();
+}
+
+void Message::materializeSegments()
+{
+    if(segments_.empty())
+    {
+        return;
+    }
+
+    if(payload_.empty() && segments_.size() == 1 && segments_.front().isWhole() && segments_.front().storage.use_count() == 1)
+    {
+        std::swap(payload_, *segments_.front().storage);
+    }
+    else
+    {
+        payload_.reserve(payload_.size() + common::getSize(segments_));
+
+        for(const auto& segment : segments_)
+        {
+            common::copy(payload_, segment.buffer);
+        }
+    }
+
+    segments_.clear();
+}
+
 }
 }
 }
@@ -0,0 +1,72 @@
+/*
+*  This file is part of aasdk library project.
+*  Copyright (C) 2018 f1x.studio (Michal Szwaj)
+*
+*  aasdk is free software: you can redistribute it and/or modify
+*  it under the terms of the GNU General Public License as published by
+*  the Free Software Foundation; either version 3 of the License, or
+*  (at your option) any later version.
+
+*  aasdk is distributed in the hope that it will be useful,
+*  but WITHOUT ANY WARRANTY; without even the implied warranty of
+*  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+*  GNU General Public License for more details.
+*
+*  You should have received a copy of the GNU General Public License
+*  along with aasdk. If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include <boost/test/unit_test.hpp>
+#include <f1x/aasdk/Messenger/Message.hpp>
+
+namespace f1x
+{
+namespace aasdk
+{
+namespace messenger
+{
+namespace ut
+{
+
+BOOST_AUTO_TEST_CASE(Message_AdoptSingleSegment)
+{
+    auto storage = std::make_shared<common::Data>(100, 0x5A);
+    const auto* storageData = storage->data();
+
+    Message message(ChannelId::VIDEO, EncryptionType::PLAIN, MessageType::SPECIFIC);
+    message.insertPayload(common::DataSegment(std::move(storage)));
+    BOOST_CHECK_EQUAL(message.getPayloadSize(), 100u);
+
+    const auto& payload = message.getPayload();
+    BOOST_CHECK_EQUAL(payload.size(), 100u);
+    BOOST_CHECK(payload.data() == storageData);
+}
+
+BOOST_AUTO_TEST_CASE(Message_MaterializeSharedSegments)
+{
+    auto storage = std::make_shared<common::Data>();
+    for(uint8_t i = 0; i < 10; ++i)
+    {
+        storage->push_back(i);
+    }
+
+    Message message(ChannelId::VIDEO, EncryptionType::PLAIN, MessageType::SPECIFIC);
+    message.insertPayload(common::Data{0xAA});
+    message.insertPayload(common::DataSegment(storage, 6, 4));
+    message.insertPayload(common::DataSegment(storage, 0, 3));
+    BOOST_CHECK_EQUAL(message.getPayloadSize(), 8u);
+
+    const auto buffers = message.getPayloadBuffers();
+    BOOST_REQUIRE_EQUAL(buffers.size(), 3u);
+    BOOST_CHECK(buffers[1].cdata == storage->data() + 6);
+
+    const common::Data expectedPayload{0xAA, 6, 7, 8, 9, 0, 1, 2};
+    const auto& payload = message.getPayload();
+    BOOST_CHECK_EQUAL_COLLECTIONS(payload.begin(), payload.end(), expectedPayload.begin(), expectedPayload.end());
+    BOOST_CHECK_EQUAL(storage->size(), 10u);
+}
+
+}
+}
+}
+}
@@ -16,9 +16,9 @@
 *  along with aasdk. If not, see <http://www.gnu.org/licenses/>.
 */
 
+#include <algorithm>
 #include <f1x/aasdk/Messenger/MessageInStream.hpp>
 #include <f1x/aasdk/Error/Error.hpp>
-#include <f1x/aasdk/Common/Log.hpp>
 
 #include <iostream>
 namespace f1x
@@ -28,10 +28,21 @@ namespace aasdk
 namespace messenger
 {
 
-MessageInStream::MessageInStream(boost::asio::io_service& ioService, transport::ITransport::Pointer transport, ICryptor::Pointer cryptor)
+MessageInStream::MessageInStream(boost::asio::io_service& ioService, transport::ITransport::Pointer transport, ICryptor::Pointer cryptor,
+                                 MessagePool::Pointer messagePool, io::WorkerPool::Pointer decryptionPool)
     : strand_(ioService)
     , transport_(std::move(transport))
     , cryptor_(std::move(cryptor))
+    , messagePool_(std::move(messagePool))
+    , decryptionPool_(std::move(decryptionPool))
+    , awaitingDecryption_(false)
+    , isReceivingFrames_(false)
+{
+
+}
+
+MessageInStream::PendingDecryption::PendingDecryption()
+    : tasksCount(0)
 {
 
 }
@@ -39,35 +50,69 @@ MessageInStream::MessageInStream(boost::asio::io_service& ioService, transport::
 void MessageInStream::startReceive(ReceivePromise::Pointer promise)
 {
     strand_.dispatch([this, self = this->shared_from_this(), promise = std::move(promise)]() mutable {
-        if(promise_ == nullptr)
+        if(this->isReceiving())
+        {
+            promise->reject(error::Error(error::ErrorCode::OPERATION_IN_PROGRESS));
+        }
+        else if(unclaimedMessage_ != nullptr)
+        {
+            promise->resolve(std::move(unclaimedMessage_));
+        }
+        else if(unclaimedError_ != error::ErrorCode::NONE)
+        {
+            promise->reject(unclaimedError_);
+            unclaimedError_ = error::Error();
+        }
+        else
         {
             promise_ = std::move(promise);
+            this->resumeReceive();
+        }
+    });
+}
 
-            auto transportPromise = transport::ITransport::ReceivePromise::defer(strand_);
-            transportPromise->then(
-                [this, self = this->shared_from_this()](common::Data data) mutable {
-                    this->receiveFrameHeaderHandler(common::DataConstBuffer(data));
-                },
-                [this, self = this->shared_from_this()](const error::Error& e) mutable {
-                    promise_->reject(e);
-                    promise_.reset();
-                });
-
-            transport_->receive(FrameHeader::getSizeOf(), std::move(transportPromise));
+void MessageInStream::startReceiveLoop(MessageHandler messageHandler, ErrorHandler errorHandler)
+{
+    strand_.dispatch([this, self = this->shared_from_this(), messageHandler = std::move(messageHandler), errorHandler = std::move(errorHandler)]() mutable {
+        if(this->isReceiving())
+        {
+            errorHandler(error::Error(error::ErrorCode::OPERATION_IN_PROGRESS));
+        }
+        else if(unclaimedError_ != error::ErrorCode::NONE)
+        {
+            auto e = unclaimedError_;
+            unclaimedError_ = error::Error();
+            errorHandler(e);
         }
         else
         {
-            promise->reject(error::Error(error::ErrorCode::OPERATION_IN_PROGRESS));
+            loopMessageHandler_ = std::move(messageHandler);
+            loopErrorHandler_ = std::move(errorHandler);
+
+            if(unclaimedMessage_ != nullptr)
+            {
+                this->resolveMessage(std::move(unclaimedMessage_));
+            }
+            else
+            {
+                this->resumeReceive();
+            }
         }
     });
 }
 
+void MessageInStream::stopReceiveLoop()
+{
+    strand_.dispatch([this, self = this->shared_from_this()]() {
+        // A frame read already in flight completes on its own; its message or error is kept for the next receive.
+        loopMessageHandler_ = nullptr;
+        loopErrorHandler_ = nullptr;
+    });
+}
+
 void MessageInStream::receiveFrameHeaderHandler(const common::DataConstBuffer& buffer)
 {
     FrameHeader frameHeader(buffer);
-    if (buffer.cdata[0] != 3) {
-        AASDK_LOG(debug) << "Message from channel " << std::to_string(buffer.cdata[0]);
-    }
 
     if(message_ != nullptr && message_->getChannelId() != frameHeader.getChannelId())
     {
@@ -84,12 +129,15 @@ void MessageInStream::receiveFrameHeaderHandler(const common::DataConstBuffer& b
         if(frameHeader.getType()!=FrameType::FIRST) //only use the data if we're not on a new frame, otherwise disregard
             message_ = prevBuffer->second;
         else{
-            message_ = std::make_shared<Message>(frameHeader.getChannelId(), frameHeader.getEncryptionType(), frameHeader.getMessageType());
+            auto pendingDecryption = pendingDecryptions_.find(prevBuffer->second);
+            if(pendingDecryption != pendingDecryptions_.end() && pendingDecryption->second.tasksCount == 0)
+                pendingDecryptions_.erase(pendingDecryption);
+            message_ = messagePool_->acquire(frameHeader.getChannelId(), frameHeader.getEncryptionType(), frameHeader.getMessageType());
         }
         channel_assembly_buffers.erase(prevBuffer); // get rid of the previously stored data because it's now our working data.
     }
     else if(message_ == nullptr){
-        message_ = std::make_shared<Message>(frameHeader.getChannelId(), frameHeader.getEncryptionType(), frameHeader.getMessageType());
+        message_ = messagePool_->acquire(frameHeader.getChannelId(), frameHeader.getEncryptionType(), frameHeader.getMessageType());
     }
     recentFrameType_ = frameHeader.getType();
     const size_t frameSize = FrameSize::getSizeOf(frameHeader.getType() == FrameType::FIRST ? FrameSizeType::EXTENDED : FrameSizeType::SHORT);
@@ -101,8 +149,7 @@ void MessageInStream::receiveFrameHeaderHandler(const common::DataConstBuffer& b
         },
         [this, self = this->shared_from_this()](const error::Error& e) mutable {
             message_.reset();
-            promise_->reject(e);
-            promise_.reset();
+            this->rejectMessage(e);
         });
 
     transport_->receive(frameSize, std::move(transportPromise));
@@ -113,59 +160,286 @@ void MessageInStream::receiveFrameSizeHandler(const common::DataConstBuffer& buf
     auto transportPromise = transport::ITransport::ReceivePromise::defer(strand_);
     transportPromise->then(
         [this, self = this->shared_from_this()](common::Data data) mutable {
-            this->receiveFramePayloadHandler(common::DataConstBuffer(data));
+            this->receiveFramePayloadHandler(std::move(data));
         },
         [this, self = this->shared_from_this()](const error::Error& e) mutable {
             message_.reset();
-            promise_->reject(e);
-            promise_.reset();
+            this->rejectMessage(e);
         });
 
     FrameSize frameSize(buffer);
+
+    const auto pendingDecryption = pendingDecryptions_.find(message_);
+
+    if(message_->getEncryptionType() == EncryptionType::ENCRYPTED && (pendingDecryption == pendingDecryptions_.end() || pendingDecryption->second.tasksCount == 0))
+    {
+        // The total size is announced by the peer, so only trust it up to the largest pooled buffer; the payload grows with the frames past that.
+        const auto expectedSize = recentFrameType_ == FrameType::FIRST ? std::min(frameSize.getTotalSize(), MessagePool::cMaxPooledPayloadSize)
+                                                                       : message_->getPayload().size() + frameSize.getSize();
+        messagePool_->reservePayload(*message_, expectedSize);
+    }
+
     transport_->receive(frameSize.getSize(), std::move(transportPromise));
 }
 
-void MessageInStream::receiveFramePayloadHandler(const common::DataConstBuffer& buffer)
-{   
+void MessageInStream::receiveFramePayloadHandler(common::Data data)
+{
     if(message_->getEncryptionType() == EncryptionType::ENCRYPTED)
     {
-        try
+        error::Error e;
+
+        if(!this->decryptInParallel(data))
         {
-            cryptor_->decrypt(message_->getPayload(), buffer);
+            const auto pendingDecryption = pendingDecryptions_.find(message_);
+
+            if(pendingDecryption != pendingDecryptions_.end() && pendingDecryption->second.tasksCount > 0)
+            {
+                // Workers still write into the payload, so it cannot be resized until they are done.
+                deferredDecryption_ = [this, data = std::move(data)]() {
+                    error::Error e;
+                    cryptor_->decrypt(message_->getPayload(), common::DataConstBuffer(data), e);
+                    auto& pendingDecryption = pendingDecryptions_[message_];
+
+                    if(e != error::ErrorCode::NONE && !pendingDecryption.error)
+                    {
+                        pendingDecryption.error = e;
+                    }
+                };
+            }
+            else
+            {
+                cryptor_->decrypt(message_->getPayload(), common::DataConstBuffer(data), e);
+            }
         }
-        catch(const error::Error& e)
+
+        if(e != error::ErrorCode::NONE)
         {
+            pendingDecryptions_.erase(message_);
             message_.reset();
-            promise_->reject(e);
-            promise_.reset();
+            this->rejectMessage(e);
+            return;
+        }
+
+        if(deferredDecryption_)
+        {
             return;
         }
     }
     else
     {
-        message_->insertPayload(buffer);
+        message_->insertPayload(common::DataSegment(messagePool_->adopt(std::move(data))));
     }
 
     if(recentFrameType_ == FrameType::BULK || recentFrameType_ == FrameType::LAST)
     {
-        promise_->resolve(std::move(message_));
-        promise_.reset();
+        this->completeMessage();
+    }
+    else
+    {
+        this->receiveNextFrame();
+    }
+}
+
+bool MessageInStream::decryptInParallel(common::Data& data)
+{
+    if(decryptionPool_ == nullptr || recentFrameType_ == FrameType::BULK)
+    {
+        return false;
+    }
+
+    size_t plaintextSize = 0;
+    auto decryptTask = cryptor_->prepareDecrypt(common::DataConstBuffer(data), plaintextSize);
+
+    if(!decryptTask)
+    {
+        return false;
+    }
+
+    auto frame = messagePool_->adopt(std::move(data));
+    const auto& payload = message_->getPayload();
+    const auto pendingDecryption = pendingDecryptions_.find(message_);
+
+    if(pendingDecryption != pendingDecryptions_.end() && pendingDecryption->second.tasksCount > 0 && payload.size() + plaintextSize > payload.capacity())
+    {
+        deferredDecryption_ = [this, frame = std::move(frame), decryptTask = std::move(decryptTask), plaintextSize]() mutable {
+            this->dispatchDecryption(std::move(frame), std::move(decryptTask), plaintextSize);
+        };
+    }
+    else
+    {
+        this->dispatchDecryption(std::move(frame), std::move(decryptTask), plaintextSize);
+    }
+
+    return true;
+}
+
+void MessageInStream::dispatchDecryption(std::shared_ptr<common::Data> frame, ICryptor::DecryptTask decryptTask, size_t plaintextSize)
+{
+    auto& payload = message_->getPayload();
+    const auto offset = payload.size();
+    payload.resize(offset + plaintextSize);
+    ++pendingDecryptions_[message_].tasksCount;
+
+    decryptionPool_->post([this, self = this->shared_from_this(), message = message_, output = payload.data() + offset,
+                           frame = std::move(frame), decryptTask = std::move(decryptTask)]() mutable {
+        error::Error e;
+        decryptTask(common::DataConstBuffer(*frame), output, e);
+
+        strand_.dispatch([this, self = std::move(self), message = std::move(message), e]() mutable {
+            this->decryptionHandler(std::move(message), e);
+        });
+    });
+}
+
+void MessageInStream::decryptionHandler(Message::Pointer message, const error::Error& e)
+{
+    auto pendingDecryption = pendingDecryptions_.find(message);
+
+    if(pendingDecryption == pendingDecryptions_.end())
+    {
+        return;
+    }
+
+    if(e != error::ErrorCode::NONE && !pendingDecryption->second.error)
+    {
+        pendingDecryption->second.error = e;
+    }
+
+    if(--pendingDecryption->second.tasksCount > 0)
+    {
+        return;
+    }
+
+    if(message != message_)
+    {
+        auto assemblyBuffer = channel_assembly_buffers.find(message->getChannelId());
+
+        if(assemblyBuffer == channel_assembly_buffers.end() || assemblyBuffer->second != message)
+        {
+            pendingDecryptions_.erase(pendingDecryption);
+        }
+    }
+    else if(deferredDecryption_)
+    {
+        auto deferredDecryption = std::move(deferredDecryption_);
+        deferredDecryption_ = nullptr;
+        deferredDecryption();
+
+        if(recentFrameType_ == FrameType::LAST)
+        {
+            this->completeMessage();
+        }
+        else
+        {
+            this->receiveNextFrame();
+        }
+    }
+    else if(awaitingDecryption_)
+    {
+        this->completeMessage();
+    }
+}
+
+void MessageInStream::completeMessage()
+{
+    auto pendingDecryption = pendingDecryptions_.find(message_);
+
+    if(pendingDecryption != pendingDecryptions_.end())
+    {
+        if(pendingDecryption->second.tasksCount > 0)
+        {
+            awaitingDecryption_ = true;
+            return;
+        }
+
+        const auto e = pendingDecryption->second.error;
+        pendingDecryptions_.erase(pendingDecryption);
+        awaitingDecryption_ = false;
+
+        if(e != error::ErrorCode::NONE)
+        {
+            message_.reset();
+            this->rejectMessage(e);
+            return;
+        }
+    }
+
+    this->resolveMessage(std::move(message_));
+}
+
+void MessageInStream::resumeReceive()
+{
+    if(!isReceivingFrames_)
+    {
+        this->receiveNextFrame();
+    }
+}
+
+void MessageInStream::receiveNextFrame()
+{
+    isReceivingFrames_ = true;
+    auto transportPromise = transport::ITransport::ReceivePromise::defer(strand_);
+    transportPromise->then(
+        [this, self = this->shared_from_this()](common::Data data) mutable {
+            this->receiveFrameHeaderHandler(common::DataConstBuffer(data));
+        },
+        [this, self = this->shared_from_this()](const error::Error& e) mutable {
+            message_.reset();
+            this->rejectMessage(e);
+        });
+
+    transport_->receive(FrameHeader::getSizeOf(), std::move(transportPromise));
+}
+
+void MessageInStream::resolveMessage(Message::Pointer message)
+{
+    if(loopMessageHandler_)
+    {
+        // Keep the transport busy while the message is being handed over.
+        this->receiveNextFrame();
+        loopMessageHandler_(std::move(message));
     }
     else
     {
-        auto transportPromise = transport::ITransport::ReceivePromise::defer(strand_);
-        transportPromise->then(
-            [this, self = this->shared_from_this()](common::Data data) mutable {
-                this->receiveFrameHeaderHandler(common::DataConstBuffer(data));
-            },
-            [this, self = this->shared_from_this()](const error::Error& e) mutable {
-                message_.reset();
-                promise_->reject(e);
-                promise_.reset();
-            });
+        isReceivingFrames_ = false;
 
-        transport_->receive(FrameHeader::getSizeOf(), std::move(transportPromise));
+        if(promise_ != nullptr)
+        {
+            promise_->resolve(std::move(message));
+            promise_.reset();
+        }
+        else
+        {
+            unclaimedMessage_ = std::move(message);
+        }
+    }
+}
+
+void MessageInStream::rejectMessage(const error::Error& e)
+{
+    isReceivingFrames_ = false;
+
+    if(loopErrorHandler_)
+    {
+        auto errorHandler(std::move(loopErrorHandler_));
+        loopMessageHandler_ = nullptr;
+        loopErrorHandler_ = nullptr;
+        errorHandler(e);
     }
+    else if(promise_ != nullptr)
+    {
+        promise_->reject(e);
+        promise_.reset();
+    }
+    else
+    {
+        unclaimedError_ = e;
+    }
+}
+
+bool MessageInStream::isReceiving() const
+{
+    return promise_ != nullptr || loopMessageHandler_;
 }
 
 }
@@ -16,6 +16,9 @@
 *  along with aasdk. If not, see <http://www.gnu.org/licenses/>.
 */
 
+#include <atomic>
+#include <limits>
+#include <thread>
 #include <boost/test/unit_test.hpp>
 #include <f1x/aasdk/Transport/UT/Transport.mock.hpp>
 #include <f1x/aasdk/Messenger/UT/Cryptor.mock.hpp>
@@ -36,6 +39,7 @@ using ::testing::_;
 using ::testing::SaveArg;
 using ::testing::SetArgReferee;
 using ::testing::Return;
+using ::testing::Invoke;
 
 class MessageInStreamUnitTest
 {
@@ -350,6 +354,257 @@ BOOST_FIXTURE_TEST_CASE(MessageInStream_ReceiveSplittedMessage, MessageInStreamU
     BOOST_CHECK_EQUAL_COLLECTIONS(payload.begin(), payload.end(), expectedPayload.begin(), expectedPayload.end());
 }
 
+BOOST_FIXTURE_TEST_CASE(MessageInStream_CapOversizedFirstFrameReservation, MessageInStreamUnitTest)
+{
+    MessageInStream::Pointer messageInStream(std::make_shared<MessageInStream>(ioService_, transport_, cryptor_));
+    FrameHeader frame1Header(ChannelId::VIDEO, FrameType::FIRST, EncryptionType::ENCRYPTED, MessageType::SPECIFIC);
+
+    transport::ITransport::ReceivePromise::Pointer frameHeaderTransportPromise;
+    EXPECT_CALL(transportMock_, receive(FrameHeader::getSizeOf(), _)).Times(2).WillRepeatedly(SaveArg<1>(&frameHeaderTransportPromise));
+
+    messageInStream->startReceive(std::move(receivePromise_));
+
+    ioService_.run();
+    ioService_.reset();
+
+    transport::ITransport::ReceivePromise::Pointer frame1SizeTransportPromise;
+    EXPECT_CALL(transportMock_, receive(FrameSize::getSizeOf(FrameSizeType::EXTENDED), _)).WillOnce(SaveArg<1>(&frame1SizeTransportPromise));
+    frameHeaderTransportPromise->resolve(frame1Header.getData());
+
+    ioService_.run();
+    ioService_.reset();
+
+    common::Data frame1Payload(1000, 0x5E);
+    transport::ITransport::ReceivePromise::Pointer frame1PayloadTransportPromise;
+    EXPECT_CALL(transportMock_, receive(frame1Payload.size(), _)).WillOnce(SaveArg<1>(&frame1PayloadTransportPromise));
+    FrameSize frame1Size(frame1Payload.size(), std::numeric_limits<uint32_t>::max());
+    frame1SizeTransportPromise->resolve(frame1Size.getData());
+
+    ioService_.run();
+    ioService_.reset();
+
+    size_t reservedSize = 0;
+    EXPECT_CALL(cryptorMock_, decrypt(_, _)).WillOnce(Invoke([&](common::Data& output, const common::DataConstBuffer& buffer) {
+        reservedSize = output.capacity();
+        output.insert(output.end(), buffer.cdata, buffer.cdata + buffer.size);
+        return buffer.size;
+    }));
+    EXPECT_CALL(receivePromiseHandlerMock_, onReject(_)).Times(0);
+    EXPECT_CALL(receivePromiseHandlerMock_, onResolve(_)).Times(0);
+    frame1PayloadTransportPromise->resolve(frame1Payload);
+
+    ioService_.run();
+
+    BOOST_CHECK_LE(reservedSize, MessagePool::cMaxPooledPayloadSize);
+}
+
+BOOST_FIXTURE_TEST_CASE(MessageInStream_DecryptSplittedMessageInParallel, MessageInStreamUnitTest)
+{
+    MessageInStream::Pointer messageInStream(std::make_shared<MessageInStream>(ioService_, transport_, cryptor_, std::make_shared<MessagePool>(),
+                                                                               std::make_shared<io::WorkerPool>(2)));
+    FrameHeader frame1Header(ChannelId::VIDEO, FrameType::FIRST, EncryptionType::ENCRYPTED, MessageType::SPECIFIC);
+
+    transport::ITransport::ReceivePromise::Pointer frameHeaderTransportPromise;
+    EXPECT_CALL(transportMock_, receive(FrameHeader::getSizeOf(), _)).Times(2).WillRepeatedly(SaveArg<1>(&frameHeaderTransportPromise));
+
+    messageInStream->startReceive(std::move(receivePromise_));
+
+    ioService_.run();
+    ioService_.reset();
+
+    common::Data frame1Payload(1000, 0x5E);
+    common::Data frame2Payload(2000, 0x5F);
+    common::Data expectedPayload(frame1Payload.size(), 0x5E ^ 0xFF);
+    expectedPayload.insert(expectedPayload.end(), frame2Payload.size(), 0x5F ^ 0xFF);
+
+    const ICryptor::DecryptTask decryptTask = [](const common::DataConstBuffer& buffer, uint8_t* output, error::Error&) {
+        for(size_t i = 0; i < buffer.size; ++i)
+        {
+            output[i] = buffer.cdata[i] ^ 0xFF;
+        }
+    };
+    EXPECT_CALL(cryptorMock_, decrypt(_, _)).Times(0);
+    EXPECT_CALL(cryptorMock_, prepareDecrypt(_, _)).Times(2)
+            .WillOnce(DoAll(SetArgReferee<1>(frame1Payload.size()), Return(decryptTask)))
+            .WillOnce(DoAll(SetArgReferee<1>(frame2Payload.size()), Return(decryptTask)));
+
+    transport::ITransport::ReceivePromise::Pointer frame1SizeTransportPromise;
+    EXPECT_CALL(transportMock_, receive(FrameSize::getSizeOf(FrameSizeType::EXTENDED), _)).WillOnce(SaveArg<1>(&frame1SizeTransportPromise));
+    frameHeaderTransportPromise->resolve(frame1Header.getData());
+
+    ioService_.run();
+    ioService_.reset();
+
+    transport::ITransport::ReceivePromise::Pointer frame1PayloadTransportPromise;
+    EXPECT_CALL(transportMock_, receive(frame1Payload.size(), _)).WillOnce(SaveArg<1>(&frame1PayloadTransportPromise));
+    FrameSize frame1Size(frame1Payload.size(), frame1Payload.size() + frame2Payload.size());
+    frame1SizeTransportPromise->resolve(frame1Size.getData());
+
+    ioService_.run();
+    ioService_.reset();
+
+    frame1PayloadTransportPromise->resolve(frame1Payload);
+
+    ioService_.run();
+    ioService_.reset();
+
+    transport::ITransport::ReceivePromise::Pointer frame2SizeTransportPromise;
+    EXPECT_CALL(transportMock_, receive(FrameSize::getSizeOf(FrameSizeType::SHORT), _)).WillOnce(SaveArg<1>(&frame2SizeTransportPromise));
+
+    FrameHeader frame2Header(ChannelId::VIDEO, FrameType::LAST, EncryptionType::ENCRYPTED, MessageType::SPECIFIC);
+    frameHeaderTransportPromise->resolve(frame2Header.getData());
+
+    ioService_.run();
+    ioService_.reset();
+
+    transport::ITransport::ReceivePromise::Pointer frame2PayloadTransportPromise;
+    EXPECT_CALL(transportMock_, receive(frame2Payload.size(), _)).WillOnce(SaveArg<1>(&frame2PayloadTransportPromise));
+    FrameSize frame2Size(frame2Payload.size());
+    frame2SizeTransportPromise->resolve(frame2Size.getData());
+
+    ioService_.run();
+    ioService_.reset();
+
+    Message::Pointer message;
+    EXPECT_CALL(receivePromiseHandlerMock_, onReject(_)).Times(0);
+    EXPECT_CALL(receivePromiseHandlerMock_, onResolve(_)).WillOnce(SaveArg<0>(&message));
+    frame2PayloadTransportPromise->resolve(frame2Payload);
+
+    while(message == nullptr)
+    {
+        ioService_.run();
+        ioService_.reset();
+        std::this_thread::yield();
+    }
+
+    BOOST_CHECK(message->getChannelId() == ChannelId::VIDEO);
+    BOOST_CHECK(message->getEncryptionType() == EncryptionType::ENCRYPTED);
+
+    const auto& payload = message->getPayload();
+    BOOST_CHECK_EQUAL_COLLECTIONS(payload.begin(), payload.end(), expectedPayload.begin(), expectedPayload.end());
+}
+
+BOOST_FIXTURE_TEST_CASE(MessageInStream_DeferSequentialDecryptionBehindParallelTasks, MessageInStreamUnitTest)
+{
+    MessageInStream::Pointer messageInStream(std::make_shared<MessageInStream>(ioService_, transport_, cryptor_, std::make_shared<MessagePool>(),
+                                                                               std::make_shared<io::WorkerPool>(1)));
+
+    // Frame headers and short frame sizes are both two bytes long.
+    transport::ITransport::ReceivePromise::Pointer shortTransportPromise;
+    EXPECT_CALL(transportMock_, receive(FrameHeader::getSizeOf(), _)).Times(5).WillRepeatedly(SaveArg<1>(&shortTransportPromise));
+
+    messageInStream->startReceive(std::move(receivePromise_));
+
+    ioService_.run();
+    ioService_.reset();
+
+    common::Data frame1Payload(1000, 0x5E);
+    common::Data frame2Payload(500, 0x5F);
+    common::Data frame3Payload(2000, 0x60);
+    common::Data expectedPayload(frame1Payload.size(), 0x5E ^ 0xFF);
+    expectedPayload.insert(expectedPayload.end(), frame2Payload.begin(), frame2Payload.end());
+    expectedPayload.insert(expectedPayload.end(), frame3Payload.size(), 0x60 ^ 0xFF);
+
+    std::atomic<bool> releaseTask(false);
+    std::atomic<bool> taskDone(false);
+    const ICryptor::DecryptTask blockingDecryptTask = [&](const common::DataConstBuffer& buffer, uint8_t* output, error::Error&) {
+        while(!releaseTask)
+        {
+            std::this_thread::yield();
+        }
+
+        for(size_t i = 0; i < buffer.size; ++i)
+        {
+            output[i] = buffer.cdata[i] ^ 0xFF;
+        }
+
+        taskDone = true;
+    };
+    const ICryptor::DecryptTask decryptTask = [](const common::DataConstBuffer& buffer, uint8_t* output, error::Error&) {
+        for(size_t i = 0; i < buffer.size; ++i)
+        {
+            output[i] = buffer.cdata[i] ^ 0xFF;
+        }
+    };
+    EXPECT_CALL(cryptorMock_, prepareDecrypt(_, _)).Times(3)
+            .WillOnce(DoAll(SetArgReferee<1>(frame1Payload.size()), Return(blockingDecryptTask)))
+            .WillOnce(Return(ICryptor::DecryptTask()))
+            .WillOnce(DoAll(SetArgReferee<1>(frame3Payload.size()), Return(decryptTask)));
+
+    bool decrypted = false;
+    bool decryptedBehindTask = false;
+    EXPECT_CALL(cryptorMock_, decrypt(_, _)).WillOnce(Invoke([&](common::Data& output, const common::DataConstBuffer& buffer) {
+        decrypted = true;
+        decryptedBehindTask = taskDone;
+        output.insert(output.end(), buffer.cdata, buffer.cdata + buffer.size);
+        return buffer.size;
+    }));
+
+    transport::ITransport::ReceivePromise::Pointer frameSizeTransportPromise;
+    transport::ITransport::ReceivePromise::Pointer framePayloadTransportPromise;
+
+    EXPECT_CALL(transportMock_, receive(FrameSize::getSizeOf(FrameSizeType::EXTENDED), _)).WillOnce(SaveArg<1>(&frameSizeTransportPromise));
+    shortTransportPromise->resolve(FrameHeader(ChannelId::VIDEO, FrameType::FIRST, EncryptionType::ENCRYPTED, MessageType::SPECIFIC).getData());
+    ioService_.run();
+    ioService_.reset();
+
+    EXPECT_CALL(transportMock_, receive(frame1Payload.size(), _)).WillOnce(SaveArg<1>(&framePayloadTransportPromise));
+    frameSizeTransportPromise->resolve(FrameSize(frame1Payload.size(), expectedPayload.size()).getData());
+    ioService_.run();
+    ioService_.reset();
+
+    framePayloadTransportPromise->resolve(frame1Payload);
+    ioService_.run();
+    ioService_.reset();
+
+    shortTransportPromise->resolve(FrameHeader(ChannelId::VIDEO, FrameType::MIDDLE, EncryptionType::ENCRYPTED, MessageType::SPECIFIC).getData());
+    ioService_.run();
+    ioService_.reset();
+
+    EXPECT_CALL(transportMock_, receive(frame2Payload.size(), _)).WillOnce(SaveArg<1>(&framePayloadTransportPromise));
+    shortTransportPromise->resolve(FrameSize(frame2Payload.size()).getData());
+    ioService_.run();
+    ioService_.reset();
+
+    framePayloadTransportPromise->resolve(frame2Payload);
+    ioService_.run();
+    ioService_.reset();
+
+    releaseTask = true;
+    while(!decrypted)
+    {
+        ioService_.run();
+        ioService_.reset();
+        std::this_thread::yield();
+    }
+
+    BOOST_CHECK(decryptedBehindTask);
+
+    shortTransportPromise->resolve(FrameHeader(ChannelId::VIDEO, FrameType::LAST, EncryptionType::ENCRYPTED, MessageType::SPECIFIC).getData());
+    ioService_.run();
+    ioService_.reset();
+
+    EXPECT_CALL(transportMock_, receive(frame3Payload.size(), _)).WillOnce(SaveArg<1>(&framePayloadTransportPromise));
+    shortTransportPromise->resolve(FrameSize(frame3Payload.size()).getData());
+    ioService_.run();
+    ioService_.reset();
+
+    Message::Pointer message;
+    EXPECT_CALL(receivePromiseHandlerMock_, onReject(_)).Times(0);
+    EXPECT_CALL(receivePromiseHandlerMock_, onResolve(_)).WillOnce(SaveArg<0>(&message));
+    framePayloadTransportPromise->resolve(frame3Payload);
+
+    while(message == nullptr)
+    {
+        ioService_.run();
+        ioService_.reset();
+        std::this_thread::yield();
+    }
+
+    const auto& payload = message->getPayload();
+    BOOST_CHECK_EQUAL_COLLECTIONS(payload.begin(), payload.end(), expectedPayload.begin(), expectedPayload.end());
+}
+
 BOOST_FIXTURE_TEST_CASE(MessageInStream_IntertwinedChannels, MessageInStreamUnitTest)
 {
     MessageInStream::Pointer messageInStream(std::make_shared<MessageInStream>(ioService_, transport_, cryptor_));
@@ -418,6 +673,149 @@ BOOST_FIXTURE_TEST_CASE(MessageInStream_RejectWhenInProgress, MessageInStreamUni
 }
 
 
+BOOST_FIXTURE_TEST_CASE(MessageInStream_ReceiveLoopRearmsAfterMessage, MessageInStreamUnitTest)
+{
+    MessageInStream::Pointer messageInStream(std::make_shared<MessageInStream>(ioService_, transport_, cryptor_));
+
+    FrameHeader frameHeader(ChannelId::BLUETOOTH, FrameType::BULK, EncryptionType::PLAIN, MessageType::SPECIFIC);
+    transport::ITransport::ReceivePromise::Pointer frameHeaderTransportPromise;
+    EXPECT_CALL(transportMock_, receive(FrameHeader::getSizeOf(), _)).WillOnce(SaveArg<1>(&frameHeaderTransportPromise));
+
+    messageInStream->startReceiveLoop(std::bind(&ReceivePromiseHandlerMock::onResolve, &receivePromiseHandlerMock_, std::placeholders::_1),
+                                      std::bind(&ReceivePromiseHandlerMock::onReject, &receivePromiseHandlerMock_, std::placeholders::_1));
+
+    ioService_.run();
+    ioService_.reset();
+
+    common::Data framePayload(100, 0x5E);
+    FrameSize frameSize(framePayload.size());
+    transport::ITransport::ReceivePromise::Pointer frameSizeTransportPromise;
+    EXPECT_CALL(transportMock_, receive(FrameSize::getSizeOf(FrameSizeType::SHORT), _)).WillOnce(SaveArg<1>(&frameSizeTransportPromise));
+    frameHeaderTransportPromise->resolve(frameHeader.getData());
+
+    ioService_.run();
+    ioService_.reset();
+
+    transport::ITransport::ReceivePromise::Pointer framePayloadTransportPromise;
+    EXPECT_CALL(transportMock_, receive(framePayload.size(), _)).WillOnce(SaveArg<1>(&framePayloadTransportPromise));
+    frameSizeTransportPromise->resolve(frameSize.getData());
+
+    ioService_.run();
+    ioService_.reset();
+
+    Message::Pointer message;
+    EXPECT_CALL(receivePromiseHandlerMock_, onResolve(_)).WillOnce(SaveArg<0>(&message));
+    EXPECT_CALL(transportMock_, receive(FrameHeader::getSizeOf(), _)).WillOnce(SaveArg<1>(&frameHeaderTransportPromise));
+    framePayloadTransportPromise->resolve(framePayload);
+
+    ioService_.run();
+    ioService_.reset();
+
+    BOOST_CHECK(message->getChannelId() == ChannelId::BLUETOOTH);
+
+    const error::Error e(error::ErrorCode::USB_TRANSFER, 5);
+    EXPECT_CALL(receivePromiseHandlerMock_, onReject(e));
+    frameHeaderTransportPromise->reject(e);
+
+    ioService_.run();
+}
+
+BOOST_FIXTURE_TEST_CASE(MessageInStream_StopReceiveLoopReleasesHandlers, MessageInStreamUnitTest)
+{
+    MessageInStream::Pointer messageInStream(std::make_shared<MessageInStream>(ioService_, transport_, cryptor_));
+
+    transport::ITransport::ReceivePromise::Pointer frameHeaderTransportPromise;
+    EXPECT_CALL(transportMock_, receive(FrameHeader::getSizeOf(), _)).WillOnce(SaveArg<1>(&frameHeaderTransportPromise));
+
+    auto handlerOwner = std::make_shared<int>(0);
+    messageInStream->startReceiveLoop([handlerOwner](Message::Pointer) { BOOST_FAIL("message handler called after stop"); },
+                                      [handlerOwner](const error::Error&) { BOOST_FAIL("error handler called after stop"); });
+
+    ioService_.run();
+    ioService_.reset();
+
+    messageInStream->stopReceiveLoop();
+    ioService_.run();
+    ioService_.reset();
+    BOOST_CHECK_EQUAL(handlerOwner.use_count(), 1);
+
+    // The header read is still in flight, a new receive picks up its message instead of starting another read.
+    messageInStream->startReceive(std::move(receivePromise_));
+    ioService_.run();
+    ioService_.reset();
+
+    FrameHeader frameHeader(ChannelId::BLUETOOTH, FrameType::BULK, EncryptionType::PLAIN, MessageType::SPECIFIC);
+    common::Data framePayload(100, 0x5E);
+    FrameSize frameSize(framePayload.size());
+    transport::ITransport::ReceivePromise::Pointer frameSizeTransportPromise;
+    EXPECT_CALL(transportMock_, receive(FrameSize::getSizeOf(FrameSizeType::SHORT), _)).WillOnce(SaveArg<1>(&frameSizeTransportPromise));
+    frameHeaderTransportPromise->resolve(frameHeader.getData());
+
+    ioService_.run();
+    ioService_.reset();
+
+    transport::ITransport::ReceivePromise::Pointer framePayloadTransportPromise;
+    EXPECT_CALL(transportMock_, receive(framePayload.size(), _)).WillOnce(SaveArg<1>(&framePayloadTransportPromise));
+    frameSizeTransportPromise->resolve(frameSize.getData());
+
+    ioService_.run();
+    ioService_.reset();
+
+    Message::Pointer message;
+    EXPECT_CALL(receivePromiseHandlerMock_, onResolve(_)).WillOnce(SaveArg<0>(&message));
+    framePayloadTransportPromise->resolve(framePayload);
+
+    ioService_.run();
+    BOOST_REQUIRE(message != nullptr);
+    BOOST_CHECK(message->getChannelId() == ChannelId::BLUETOOTH);
+}
+
+BOOST_FIXTURE_TEST_CASE(MessageInStream_StopReceiveLoopKeepsInFlightMessage, MessageInStreamUnitTest)
+{
+    MessageInStream::Pointer messageInStream(std::make_shared<MessageInStream>(ioService_, transport_, cryptor_));
+
+    transport::ITransport::ReceivePromise::Pointer frameHeaderTransportPromise;
+    EXPECT_CALL(transportMock_, receive(FrameHeader::getSizeOf(), _)).WillOnce(SaveArg<1>(&frameHeaderTransportPromise));
+
+    messageInStream->startReceiveLoop([](Message::Pointer) { BOOST_FAIL("message handler called after stop"); },
+                                      [](const error::Error&) { BOOST_FAIL("error handler called after stop"); });
+    ioService_.run();
+    ioService_.reset();
+
+    messageInStream->stopReceiveLoop();
+    ioService_.run();
+    ioService_.reset();
+
+    FrameHeader frameHeader(ChannelId::BLUETOOTH, FrameType::BULK, EncryptionType::PLAIN, MessageType::SPECIFIC);
+    common::Data framePayload(100, 0x5E);
+    transport::ITransport::ReceivePromise::Pointer frameSizeTransportPromise;
+    EXPECT_CALL(transportMock_, receive(FrameSize::getSizeOf(FrameSizeType::SHORT), _)).WillOnce(SaveArg<1>(&frameSizeTransportPromise));
+    frameHeaderTransportPromise->resolve(frameHeader.getData());
+    ioService_.run();
+    ioService_.reset();
+
+    transport::ITransport::ReceivePromise::Pointer framePayloadTransportPromise;
+    EXPECT_CALL(transportMock_, receive(framePayload.size(), _)).WillOnce(SaveArg<1>(&framePayloadTransportPromise));
+    frameSizeTransportPromise->resolve(FrameSize(framePayload.size()).getData());
+    ioService_.run();
+    ioService_.reset();
+
+    framePayloadTransportPromise->resolve(framePayload);
+    ioService_.run();
+    ioService_.reset();
+
+    // The message completed without a consumer is handed to the next receive without another read.
+    Message::Pointer message;
+    EXPECT_CALL(receivePromiseHandlerMock_, onReject(_)).Times(0);
+    EXPECT_CALL(receivePromiseHandlerMock_, onResolve(_)).WillOnce(SaveArg<0>(&message));
+    messageInStream->startReceive(std::move(receivePromise_));
+
+    ioService_.run();
+    BOOST_REQUIRE(message != nullptr);
+    BOOST_CHECK(message->getChannelId() == ChannelId::BLUETOOTH);
+    BOOST_CHECK_EQUAL(message->getPayload().size(), framePayload.size());
+}
+
 }
 }
 }
@@ -49,27 +49,30 @@ void MessageOutStream::stream(Message::Pointer message, SendPromise::Pointer pro
         message_ = std::move(message);
         promise_ = std::move(promise);
 
-        if(message_->getPayload().size() >= cMaxFramePayloadSize)
+        if(message_->getPayloadSize() >= FrameSize::cMaxFramePayloadSize)
         {
             offset_ = 0;
-            remainingSize_ = message_->getPayload().size();
+            remainingSize_ = message_->getPayloadSize();
             this->streamSplittedMessage();
         }
         else
         {
-            try
-            {
-                auto data(this->compoundFrame(FrameType::BULK, common::DataConstBuffer(message_->getPayload())));
+            error::Error e;
+            auto data(message_->getEncryptionType() == EncryptionType::PLAIN && message_.use_count() == 1
+                      ? this->releasePlainFrame()
+                      : this->compoundFrame(FrameType::BULK, common::DataConstBuffer(message_->getPayload()), e));
 
-                auto transportPromise = transport::ITransport::SendPromise::defer(strand_);
-                io::PromiseLink<>::forward(*transportPromise, std::move(promise_));
-                transport_->send(std::move(data), std::move(transportPromise));
-            }
-            catch(const error::Error& e)
+            if(e != error::ErrorCode::NONE)
             {
                 promise_->reject(e);
                 promise_.reset();
             }
+            else
+            {
+                auto transportPromise = transport::ITransport::SendPromise::defer(strand_.context(), io::PromiseResolution::DISPATCH);
+                io::PromiseLink<>::forward(*transportPromise, std::move(promise_));
+                transport_->send(std::move(data), std::move(transportPromise));
+            }
 
             this->reset();
         }
@@ -78,56 +81,63 @@ void MessageOutStream::stream(Message::Pointer message, SendPromise::Pointer pro
 
 void MessageOutStream::streamSplittedMessage()
 {
-    try
-    {
-        const auto& payload = message_->getPayload();
-        auto ptr = &payload[offset_];
-        auto size = remainingSize_ < cMaxFramePayloadSize ? remainingSize_ : cMaxFramePayloadSize;
+    const auto& payload = message_->getPayload();
+    auto ptr = &payload[offset_];
+    auto size = remainingSize_ < FrameSize::cMaxFramePayloadSize ? remainingSize_ : FrameSize::cMaxFramePayloadSize;
 
-        FrameType frameType = offset_ == 0 ? FrameType::FIRST : (remainingSize_ - size > 0 ? FrameType::MIDDLE : FrameType::LAST);
-        auto data(this->compoundFrame(frameType, common::DataConstBuffer(ptr, size)));
+    FrameType frameType = offset_ == 0 ? FrameType::FIRST : (remainingSize_ - size > 0 ? FrameType::MIDDLE : FrameType::LAST);
+    error::Error e;
 
-        auto transportPromise = transport::ITransport::SendPromise::defer(strand_);
+    if(offset_ == 0 && message_->getEncryptionType() == EncryptionType::ENCRYPTED)
+    {
+        this->compoundEncryptedFrames(e);
+    }
 
-        if(frameType == FrameType::LAST)
-        {
-            this->reset();
-            io::PromiseLink<>::forward(*transportPromise, std::move(promise_));
-        }
-        else
-        {
-            transportPromise->then([this, self = this->shared_from_this(), size]() mutable {
-                    offset_ += size;
-                    remainingSize_ -= size;
-                    this->streamSplittedMessage();
-                },
-                [this, self = this->shared_from_this()](const error::Error& e) mutable {
-                    this->reset();
-                    promise_->reject(e);
-                    promise_.reset();
-                });
-        }
+    auto data(encryptedFrames_.empty() ? this->compoundFrame(frameType, common::DataConstBuffer(ptr, size), e)
+                                       : std::move(encryptedFrames_[offset_ / FrameSize::cMaxFramePayloadSize]));
 
-        transport_->send(std::move(data), std::move(transportPromise));
-    }
-    catch(const error::Error& e)
+    if(e != error::ErrorCode::NONE)
     {
         this->reset();
         promise_->reject(e);
         promise_.reset();
+        return;
+    }
+
+    transport::ITransport::SendPromise::Pointer transportPromise;
+
+    if(frameType == FrameType::LAST)
+    {
+        this->reset();
+        transportPromise = transport::ITransport::SendPromise::defer(strand_.context(), io::PromiseResolution::DISPATCH);
+        io::PromiseLink<>::forward(*transportPromise, std::move(promise_));
+    }
+    else
+    {
+        transportPromise = transport::ITransport::SendPromise::defer(strand_);
+        transportPromise->then([this, self = this->shared_from_this(), size]() mutable {
+                offset_ += size;
+                remainingSize_ -= size;
+                this->streamSplittedMessage();
+            },
+            [this, self = this->shared_from_this()](const error::Error& e) mutable {
+                this->reset();
+                promise_->reject(e);
+                promise_.reset();
+            });
     }
+
+    transport_->send(std::move(data), std::move(transportPromise));
 }
 
-common::Data MessageOutStream::compoundFrame(FrameType frameType, const common::DataConstBuffer& payloadBuffer)
+common::Data MessageOutStream::compoundFrame(FrameType frameType, const common::DataConstBuffer& payloadBuffer, error::Error& e)
 {
-    const FrameHeader frameHeader(message_->getChannelId(), frameType, message_->getEncryptionType(), message_->getType());
-    common::Data data(frameHeader.getData());
-    data.resize(data.size() + FrameSize::getSizeOf(frameType == FrameType::FIRST ? FrameSizeType::EXTENDED : FrameSizeType::SHORT));
+    common::Data data(this->compoundFrameHeader(frameType));
     size_t payloadSize = 0;
 
     if(message_->getEncryptionType() == EncryptionType::ENCRYPTED)
     {
-        payloadSize = cryptor_->encrypt(data, payloadBuffer);
+        payloadSize = cryptor_->encrypt(data, payloadBuffer, e);
     }
     else
     {
@@ -139,6 +149,54 @@ common::Data MessageOutStream::compoundFrame(FrameType frameType, const common::
     return data;
 }
 
+void MessageOutStream::compoundEncryptedFrames(error::Error& e)
+{
+    const auto& payload = message_->getPayload();
+    std::vector<common::DataConstBuffer> buffers;
+    std::vector<FrameType> frameTypes;
+
+    for(size_t offset = 0; offset < payload.size(); offset += FrameSize::cMaxFramePayloadSize)
+    {
+        const auto size = payload.size() - offset < FrameSize::cMaxFramePayloadSize ? payload.size() - offset : FrameSize::cMaxFramePayloadSize;
+        frameTypes.push_back(offset == 0 ? FrameType::FIRST : (offset + size < payload.size() ? FrameType::MIDDLE : FrameType::LAST));
+        buffers.emplace_back(&payload[offset], size);
+        encryptedFrames_.push_back(this->compoundFrameHeader(frameTypes.back()));
+    }
+
+    cryptor_->encryptBatch(encryptedFrames_, buffers, e);
+
+    if(e != error::ErrorCode::NONE)
+    {
+        return;
+    }
+
+    for(size_t i = 0; i < encryptedFrames_.size(); ++i)
+    {
+        const auto headerSize = FrameHeader::getSizeOf() + FrameSize::getSizeOf(frameTypes[i] == FrameType::FIRST ? FrameSizeType::EXTENDED : FrameSizeType::SHORT);
+        this->setFrameSize(encryptedFrames_[i], frameTypes[i], encryptedFrames_[i].size() - headerSize, payload.size());
+    }
+}
+
+common::Data MessageOutStream::compoundFrameHeader(FrameType frameType)
+{
+    const FrameHeader frameHeader(message_->getChannelId(), frameType, message_->getEncryptionType(), message_->getType());
+    common::Data data(frameHeader.getData());
+    data.resize(data.size() + FrameSize::getSizeOf(frameType == FrameType::FIRST ? FrameSizeType::EXTENDED : FrameSizeType::SHORT));
+    return data;
+}
+
+common::Data MessageOutStream::releasePlainFrame()
+{
+    // The frame is handed over to the transport by value and freed once sent, so this buffer does not
+    // return to the MessagePool; createMessage acquires a new one for the next plain message.
+    const FrameHeader frameHeader(message_->getChannelId(), FrameType::BULK, message_->getEncryptionType(), message_->getType());
+    common::Data header(frameHeader.getData());
+    const auto& frameSizeData = FrameSize(message_->getPayloadSize()).getData();
+    header.insert(header.end(), frameSizeData.begin(), frameSizeData.end());
+
+    return message_->releaseFrame(header);
+}
+
 void MessageOutStream::setFrameSize(common::Data& data, FrameType frameType, size_t payloadSize, size_t totalSize)
 {
     const auto& frameSize = frameType == FrameType::FIRST ? FrameSize(payloadSize, totalSize) : FrameSize(payloadSize);
@@ -151,6 +209,7 @@ void MessageOutStream::reset()
     offset_ = 0;
     remainingSize_ = 0;
     message_.reset();
+    encryptedFrames_.clear();
 }
 
 }
@@ -20,6 +20,10 @@
 #include <f1x/aasdk/Transport/UT/Transport.mock.hpp>
 #include <f1x/aasdk/Messenger/UT/Cryptor.mock.hpp>
 #include <f1x/aasdk/Messenger/UT/SendPromiseHandler.mock.hpp>
+#include <f1x/aasdk/Messenger/UT/MessageInStream.mock.hpp>
+#include <f1x/aasdk/Messenger/UT/MessageOutStream.mock.hpp>
+#include <f1x/aasdk/Messenger/Messenger.hpp>
+#include <f1x/aasdk/Channel/Control/ControlServiceChannel.hpp>
 #include <f1x/aasdk/Messenger/Promise.hpp>
 #include <f1x/aasdk/Messenger/MessageOutStream.hpp>
 
@@ -34,6 +38,7 @@ namespace ut
 
 using ::testing::_;
 using ::testing::SaveArg;
+using ::testing::Invoke;
 using ::testing::SetArgReferee;
 using ::testing::Return;
 
@@ -93,6 +98,79 @@ BOOST_FIXTURE_TEST_CASE(MessageOutStream_SendPlainMessage, MessageOutStreamUnitT
     ioService_.run();
 }
 
+BOOST_FIXTURE_TEST_CASE(MessageOutStream_SendPlainMessageFromHeadroom, MessageOutStreamUnitTest)
+{
+    const FrameHeader frameHeader(ChannelId::INPUT, FrameType::BULK, EncryptionType::PLAIN, MessageType::CONTROL);
+    const common::Data payload(1000, 0x5E);
+    const FrameSize frameSize(payload.size());
+
+    const auto& frameHeaderData = frameHeader.getData();
+    common::Data expectedData(frameHeaderData.begin(), frameHeaderData.end());
+
+    const auto& frameSizeData = frameSize.getData();
+    expectedData.insert(expectedData.end(), frameSizeData.begin(), frameSizeData.end());
+    expectedData.insert(expectedData.end(), payload.begin(), payload.end());
+
+    Message::Pointer message(std::make_shared<Message>(ChannelId::INPUT, EncryptionType::PLAIN, MessageType::CONTROL));
+    message->reserveHeadroom(FrameHeader::getSizeOf() + FrameSize::getSizeOf(FrameSizeType::SHORT));
+    message->insertPayload(payload);
+    BOOST_CHECK_EQUAL(message->getHeadroom(), FrameHeader::getSizeOf() + FrameSize::getSizeOf(FrameSizeType::SHORT));
+    BOOST_CHECK_EQUAL(message->getPayloadSize(), payload.size());
+    const auto* frameData = message->getPayloadBuffers().front().cdata - message->getHeadroom();
+
+    const common::Data::value_type* sentData = nullptr;
+    transport::ITransport::SendPromise::Pointer transportSendPromise;
+    EXPECT_CALL(transportMock_, send(expectedData, _)).WillOnce(DoAll(Invoke([&sentData](const common::Data& data, auto) { sentData = data.data(); }),
+                                                                      SaveArg<1>(&transportSendPromise)));
+
+    MessageOutStream::Pointer messageOutStream(std::make_shared<MessageOutStream>(ioService_, transport_, cryptor_));
+    messageOutStream->stream(std::move(message), std::move(sendPromise_));
+
+    ioService_.run();
+    ioService_.reset();
+
+    BOOST_CHECK(sentData == frameData);
+
+    EXPECT_CALL(sendPromiseHandlerMock_, onReject(_)).Times(0);
+    EXPECT_CALL(sendPromiseHandlerMock_, onResolve());
+    transportSendPromise->resolve();
+    ioService_.run();
+}
+
+BOOST_FIXTURE_TEST_CASE(MessageOutStream_SendChannelMessageFromHeadroom, MessageOutStreamUnitTest)
+{
+    MessageInStreamMock messageInStreamMock;
+    MessageOutStreamMock messageOutStreamMock;
+    auto messenger(std::make_shared<Messenger>(ioService_, IMessageInStream::Pointer(&messageInStreamMock, [](auto*) {}),
+                                               IMessageOutStream::Pointer(&messageOutStreamMock, [](auto*) {})));
+    boost::asio::io_service::strand strand(ioService_);
+    auto controlServiceChannel(std::make_shared<channel::control::ControlServiceChannel>(strand, messenger));
+
+    Message::Pointer message;
+    EXPECT_CALL(messageOutStreamMock, stream(_, _)).WillOnce(SaveArg<0>(&message));
+
+    proto::messages::PingRequest request;
+    request.set_timestamp(123);
+    controlServiceChannel->sendPingRequest(request, channel::SendPromise::defer(strand));
+
+    ioService_.run();
+    ioService_.reset();
+
+    BOOST_REQUIRE(message != nullptr);
+    BOOST_CHECK_EQUAL(message->getHeadroom(), FrameHeader::getSizeOf() + FrameSize::getSizeOf(FrameSizeType::SHORT));
+    const auto* frameData = message->getPayloadBuffers().front().cdata - message->getHeadroom();
+
+    const common::Data::value_type* sentData = nullptr;
+    EXPECT_CALL(transportMock_, send(_, _)).WillOnce(Invoke([&sentData](const common::Data& data, auto) { sentData = data.data(); }));
+
+    MessageOutStream::Pointer messageOutStream(std::make_shared<MessageOutStream>(ioService_, transport_, cryptor_));
+    messageOutStream->stream(std::move(message), std::move(sendPromise_));
+
+    ioService_.run();
+
+    BOOST_CHECK(sentData == frameData);
+}
+
 BOOST_FIXTURE_TEST_CASE(MessageOutStream_SendEncryptedMessage, MessageOutStreamUnitTest)
 {
     const FrameHeader frameHeader(ChannelId::VIDEO, FrameType::BULK, EncryptionType::ENCRYPTED, MessageType::CONTROL);
@@ -223,6 +301,61 @@ BOOST_FIXTURE_TEST_CASE(MessageOutStream_SendSplittedMessage, MessageOutStreamUn
     ioService_.run();
 }
 
+BOOST_FIXTURE_TEST_CASE(MessageOutStream_SendSplittedEncryptedMessage, MessageOutStreamUnitTest)
+{
+    const size_t maxFramePayloadSize = 0x4000;
+    const size_t recordOverhead = 29;
+
+    const common::Data frame1Payload(maxFramePayloadSize, 0x5E);
+    const common::Data frame2Payload(100, 0x5F);
+
+    Message::Pointer message(std::make_shared<Message>(ChannelId::VIDEO, EncryptionType::ENCRYPTED, MessageType::CONTROL));
+    message->insertPayload(frame1Payload);
+    message->insertPayload(frame2Payload);
+
+    EXPECT_CALL(cryptorMock_, encrypt(_, _)).Times(0);
+    EXPECT_CALL(cryptorMock_, encryptBatch(_, _)).WillOnce(Invoke([&](std::vector<common::Data>& outputs, const std::vector<common::DataConstBuffer>& buffers) {
+        BOOST_REQUIRE_EQUAL(outputs.size(), 2);
+        BOOST_REQUIRE_EQUAL(buffers.size(), 2);
+        BOOST_CHECK(common::Data(buffers[0].cdata, buffers[0].cdata + buffers[0].size) == frame1Payload);
+        BOOST_CHECK(common::Data(buffers[1].cdata, buffers[1].cdata + buffers[1].size) == frame2Payload);
+
+        outputs[0].insert(outputs[0].end(), buffers[0].size + recordOverhead, 0xE1);
+        outputs[1].insert(outputs[1].end(), buffers[1].size + recordOverhead, 0xE2);
+    }));
+
+    const auto& frame1HeaderData = FrameHeader(ChannelId::VIDEO, FrameType::FIRST, EncryptionType::ENCRYPTED, MessageType::CONTROL).getData();
+    const auto& frame1SizeData = FrameSize(frame1Payload.size() + recordOverhead, frame1Payload.size() + frame2Payload.size()).getData();
+    common::Data expectedData1(frame1HeaderData.begin(), frame1HeaderData.end());
+    expectedData1.insert(expectedData1.end(), frame1SizeData.begin(), frame1SizeData.end());
+    expectedData1.insert(expectedData1.end(), frame1Payload.size() + recordOverhead, 0xE1);
+
+    transport::ITransport::SendPromise::Pointer transportSendPromise;
+    EXPECT_CALL(transportMock_, send(expectedData1, _)).WillOnce(SaveArg<1>(&transportSendPromise));
+
+    MessageOutStream::Pointer messageOutStream(std::make_shared<MessageOutStream>(ioService_, transport_, cryptor_));
+    messageOutStream->stream(message, std::move(sendPromise_));
+
+    ioService_.run();
+    ioService_.reset();
+
+    const auto& frame2HeaderData = FrameHeader(ChannelId::VIDEO, FrameType::LAST, EncryptionType::ENCRYPTED, MessageType::CONTROL).getData();
+    const auto& frame2SizeData = FrameSize(frame2Payload.size() + recordOverhead).getData();
+    common::Data expectedData2(frame2HeaderData.begin(), frame2HeaderData.end());
+    expectedData2.insert(expectedData2.end(), frame2SizeData.begin(), frame2SizeData.end());
+    expectedData2.insert(expectedData2.end(), frame2Payload.size() + recordOverhead, 0xE2);
+    EXPECT_CALL(transportMock_, send(expectedData2, _)).WillOnce(SaveArg<1>(&transportSendPromise));
+
+    transportSendPromise->resolve();
+    ioService_.run();
+    ioService_.reset();
+
+    EXPECT_CALL(sendPromiseHandlerMock_, onReject(_)).Times(0);
+    EXPECT_CALL(sendPromiseHandlerMock_, onResolve());
+    transportSendPromise->resolve();
+    ioService_.run();
+}
+
 }
 }
 }
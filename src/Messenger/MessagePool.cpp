@@ -0,0 +1,369 @@
+/*
+*  This file is part of aasdk library project.
+*  Copyright (C) 2018 f1x.studio (Michal Szwaj)
+*
+*  aasdk is free software: you can redistribute it and/or modify
+*  it under the terms of the GNU General Public License as published by
+*  the Free Software Foundation; either version 3 of the License, or
+*  (at your option) any later version.
+
+*  aasdk is distributed in the hope that it will be useful,
+*  but WITHOUT ANY WARRANTY; without even the implied warranty of
+*  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+*  GNU General Public License for more details.
+*
+*  You should have received a copy of the GNU General Public License
+*  along with aasdk. If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <mutex>
+#include <new>
+#include <vector>
+#include <f1x/aasdk/Messenger/MessagePool.hpp>
+
+namespace f1x
+{
+namespace aasdk
+{
+namespace messenger
+{
+
+class MessagePool::Storage: boost::noncopyable
+{
+public:
+    Storage()
+        : messageHits_(0)
+        , messageMisses_(0)
+        , payloadHits_(0)
+        , payloadMisses_(0)
+        , blockHits_(0)
+        , blockMisses_(0)
+    {
+        messages_.reserve(cMaxPooledMessages);
+        blocks_.reserve(cMaxPooledMessages);
+
+        for(auto& buffers : buffers_)
+        {
+            buffers.reserve(cMaxPooledBuffersPerClass);
+        }
+    }
+
+    ~Storage()
+    {
+        for(auto message : messages_)
+        {
+            delete message;
+        }
+
+        for(auto block : blocks_)
+        {
+            ::operator delete(block);
+        }
+    }
+
+    Message* acquireMessage()
+    {
+        {
+            std::lock_guard<decltype(messagesMutex_)> lock(messagesMutex_);
+
+            if(!messages_.empty())
+            {
+                auto message = messages_.back();
+                messages_.pop_back();
+                ++messageHits_;
+                return message;
+            }
+        }
+
+        ++messageMisses_;
+        return new Message(ChannelId::NONE, EncryptionType::PLAIN, MessageType::SPECIFIC);
+    }
+
+    void releaseMessage(Message* message)
+    {
+        this->releasePayload(std::move(message->payload_));
+        message->segments_.clear();
+        message->headroom_ = 0;
+
+        {
+            std::lock_guard<decltype(messagesMutex_)> lock(messagesMutex_);
+
+            if(messages_.size() < cMaxPooledMessages)
+            {
+                messages_.push_back(message);
+                return;
+            }
+        }
+
+        delete message;
+    }
+
+    common::Data acquirePayload(size_t size)
+    {
+        const auto sizeClass = this->getSizeClass(size);
+
+        if(sizeClass < cSizeClasses.size())
+        {
+            std::lock_guard<decltype(buffersMutex_)> lock(buffersMutex_);
+
+            for(auto i = sizeClass; i < cSizeClasses.size(); ++i)
+            {
+                if(!buffers_[i].empty())
+                {
+                    common::Data payload(std::move(buffers_[i].back()));
+                    buffers_[i].pop_back();
+                    ++payloadHits_;
+                    return payload;
+                }
+            }
+        }
+
+        ++payloadMisses_;
+        common::Data payload;
+        payload.reserve(sizeClass < cSizeClasses.size() ? cSizeClasses[sizeClass] : size);
+        return payload;
+    }
+
+    void releasePayload(common::Data payload)
+    {
+        if(payload.capacity() < cSizeClasses.front() || payload.capacity() > cSizeClasses.back())
+        {
+            return;
+        }
+
+        auto sizeClass = this->getSizeClass(payload.capacity());
+        sizeClass = cSizeClasses[sizeClass] > payload.capacity() ? sizeClass - 1 : sizeClass;
+        payload.clear();
+
+        std::lock_guard<decltype(buffersMutex_)> lock(buffersMutex_);
+
+        if(buffers_[sizeClass].size() < cMaxPooledBuffersPerClass)
+        {
+            buffers_[sizeClass].push_back(std::move(payload));
+        }
+    }
+
+    common::Data* acquireData(common::Data data)
+    {
+        return new(this->acquireBlock(sizeof(common::Data))) common::Data(std::move(data));
+    }
+
+    void releaseData(common::Data* data)
+    {
+        this->releasePayload(std::move(*data));
+        data->~vector();
+        this->releaseBlock(data, sizeof(common::Data));
+    }
+
+    void* acquireBlock(size_t size)
+    {
+        if(size <= cBlockSize)
+        {
+            std::lock_guard<decltype(blocksMutex_)> lock(blocksMutex_);
+
+            if(!blocks_.empty())
+            {
+                auto block = blocks_.back();
+                blocks_.pop_back();
+                ++blockHits_;
+                return block;
+            }
+        }
+
+        ++blockMisses_;
+        return ::operator new(std::max(size, cBlockSize));
+    }
+
+    void releaseBlock(void* block, size_t size)
+    {
+        if(size <= cBlockSize)
+        {
+            std::lock_guard<decltype(blocksMutex_)> lock(blocksMutex_);
+
+            if(blocks_.size() < cMaxPooledMessages)
+            {
+                blocks_.push_back(block);
+                return;
+            }
+        }
+
+        ::operator delete(block);
+    }
+
+    MessagePoolStatistics getStatistics() const
+    {
+        MessagePoolStatistics statistics;
+        statistics.messageHits = messageHits_;
+        statistics.messageMisses = messageMisses_;
+        statistics.payloadHits = payloadHits_;
+        statistics.payloadMisses = payloadMisses_;
+        statistics.blockHits = blockHits_;
+        statistics.blockMisses = blockMisses_;
+        return statistics;
+    }
+
+private:
+    size_t getSizeClass(size_t size) const
+    {
+        size_t sizeClass = 0;
+
+        while(sizeClass < cSizeClasses.size() && cSizeClasses[sizeClass] < size)
+        {
+            ++sizeClass;
+        }
+
+        return sizeClass;
+    }
+
+    std::mutex messagesMutex_;
+    std::vector<Message*> messages_;
+    std::mutex blocksMutex_;
+    std::vector<void*> blocks_;
+    std::mutex buffersMutex_;
+    std::array<std::vector<common::Data>, 7> buffers_;
+    std::atomic<size_t> messageHits_;
+    std::atomic<size_t> messageMisses_;
+    std::atomic<size_t> payloadHits_;
+    std::atomic<size_t> payloadMisses_;
+    std::atomic<size_t> blockHits_;
+    std::atomic<size_t> blockMisses_;
+
+    static constexpr size_t cMaxPooledMessages = 64;
+    static constexpr size_t cMaxPooledBuffersPerClass = 16;
+    static constexpr size_t cBlockSize = 128;
+    static constexpr std::array<size_t, 7> cSizeClasses{{256, 1024, 4096, 16384, 65536, 262144, MessagePool::cMaxPooledPayloadSize}};
+};
+
+constexpr std::array<size_t, 7> MessagePool::Storage::cSizeClasses;
+constexpr size_t MessagePool::cMaxPooledPayloadSize;
+
+class MessagePool::Recycler
+{
+public:
+    Recycler(std::shared_ptr<Storage> storage)
+        : storage_(std::move(storage))
+    {
+
+    }
+
+    void operator()(Message* message) const
+    {
+        storage_->releaseMessage(message);
+    }
+
+private:
+    std::shared_ptr<Storage> storage_;
+};
+
+class MessagePool::DataRecycler
+{
+public:
+    DataRecycler(std::shared_ptr<Storage> storage)
+        : storage_(std::move(storage))
+    {
+
+    }
+
+    void operator()(common::Data* data) const
+    {
+        storage_->releaseData(data);
+    }
+
+private:
+    std::shared_ptr<Storage> storage_;
+};
+
+template<typename BlockType>
+class MessagePool::BlockAllocator
+{
+public:
+    typedef BlockType value_type;
+
+    BlockAllocator(std::shared_ptr<Storage> storage)
+        : storage_(std::move(storage))
+    {
+
+    }
+
+    template<typename OtherBlockType>
+    BlockAllocator(const BlockAllocator<OtherBlockType>& other)
+        : storage_(other.storage_)
+    {
+
+    }
+
+    BlockType* allocate(size_t count)
+    {
+        return static_cast<BlockType*>(storage_->acquireBlock(count * sizeof(BlockType)));
+    }
+
+    void deallocate(BlockType* block, size_t count)
+    {
+        storage_->releaseBlock(block, count * sizeof(BlockType));
+    }
+
+    template<typename OtherBlockType>
+    bool operator==(const BlockAllocator<OtherBlockType>& other) const
+    {
+        return storage_ == other.storage_;
+    }
+
+    template<typename OtherBlockType>
+    bool operator!=(const BlockAllocator<OtherBlockType>& other) const
+    {
+        return storage_ != other.storage_;
+    }
+
+private:
+    template<typename OtherBlockType> friend class BlockAllocator;
+
+    std::shared_ptr<Storage> storage_;
+};
+
+MessagePool::MessagePool()
+    : storage_(std::make_shared<Storage>())
+{
+
+}
+
+Message::Pointer MessagePool::acquire(ChannelId channelId, EncryptionType encryptionType, MessageType type, size_t payloadSize)
+{
+    auto message = storage_->acquireMessage();
+    message->channelId_ = channelId;
+    message->encryptionType_ = encryptionType;
+    message->type_ = type;
+    message->payload_ = storage_->acquirePayload(payloadSize);
+
+    return Message::Pointer(message, Recycler(storage_), BlockAllocator<Message>(storage_));
+}
+
+std::shared_ptr<common::Data> MessagePool::adopt(common::Data data)
+{
+    return std::shared_ptr<common::Data>(storage_->acquireData(std::move(data)), DataRecycler(storage_), BlockAllocator<common::Data>(storage_));
+}
+
+MessagePoolStatistics MessagePool::getStatistics() const
+{
+    return storage_->getStatistics();
+}
+
+void MessagePool::reservePayload(Message& message, size_t payloadSize)
+{
+    if(message.payload_.capacity() >= payloadSize)
+    {
+        return;
+    }
+
+    // Grow geometrically so payloads assembled past the largest size class are not reallocated on every frame.
+    auto payload = storage_->acquirePayload(std::max(payloadSize, message.payload_.capacity() * 2));
+    payload.insert(payload.end(), message.payload_.begin(), message.payload_.end());
+    std::swap(payload, message.payload_);
+    storage_->releasePayload(std::move(payload));
+}
+
+}
+}
+}
@@ -0,0 +1,199 @@
+/*
+*  This file is part of aasdk library project.
+*  Copyright (C) 2018 f1x.studio (Michal Szwaj)
+*
+*  aasdk is free software: you can redistribute it and/or modify
+*  it under the terms of the GNU General Public License as published by
+*  the Free Software Foundation; either version 3 of the License, or
+*  (at your option) any later version.
+
+*  aasdk is distributed in the hope that it will be useful,
+*  but WITHOUT ANY WARRANTY; without even the implied warranty of
+*  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+*  GNU General Public License for more details.
+*
+*  You should have received a copy of the GNU General Public License
+*  along with aasdk. If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include <boost/test/unit_test.hpp>
+#include <f1x/aasdk/Common/UT/AllocationCounter.hpp>
+#include <f1x/aasdk/Channel/UT/LoopbackServiceChannel.hpp>
+#include <f1x/aasdk/Transport/UT/LoopbackTransport.hpp>
+#include <f1x/aasdk/Transport/SSLWrapper.hpp>
+#include <f1x/aasdk/Messenger/Cryptor.hpp>
+#include <f1x/aasdk/Messenger/MessageInStream.hpp>
+#include <f1x/aasdk/Messenger/MessageOutStream.hpp>
+#include <f1x/aasdk/Messenger/Messenger.hpp>
+#include <f1x/aasdk/Messenger/MessagePool.hpp>
+
+namespace f1x
+{
+namespace aasdk
+{
+namespace messenger
+{
+namespace ut
+{
+
+BOOST_AUTO_TEST_CASE(MessagePool_RecycleMessage)
+{
+    MessagePool messagePool;
+
+    auto message = messagePool.acquire(ChannelId::VIDEO, EncryptionType::ENCRYPTED, MessageType::SPECIFIC, 1000);
+    message->insertPayload(common::Data(1000, 0x5E));
+    const auto rawMessage = message.get();
+    const auto payloadCapacity = message->getPayload().capacity();
+    message.reset();
+
+    message = messagePool.acquire(ChannelId::MEDIA_AUDIO, EncryptionType::PLAIN, MessageType::CONTROL, 1000);
+    BOOST_CHECK(message.get() == rawMessage);
+    BOOST_CHECK(message->getChannelId() == ChannelId::MEDIA_AUDIO);
+    BOOST_CHECK(message->getEncryptionType() == EncryptionType::PLAIN);
+    BOOST_CHECK(message->getType() == MessageType::CONTROL);
+    BOOST_CHECK(message->getPayload().empty());
+    BOOST_CHECK_EQUAL(message->getPayload().capacity(), payloadCapacity);
+}
+
+BOOST_AUTO_TEST_CASE(MessagePool_ReservePayload)
+{
+    MessagePool messagePool;
+
+    auto message = messagePool.acquire(ChannelId::VIDEO, EncryptionType::ENCRYPTED, MessageType::SPECIFIC);
+    const common::Data payload(100, 0x5E);
+    message->insertPayload(payload);
+    messagePool.reservePayload(*message, 100000);
+
+    BOOST_CHECK(message->getPayload().capacity() >= 100000);
+    BOOST_CHECK_EQUAL_COLLECTIONS(message->getPayload().begin(), message->getPayload().end(), payload.begin(), payload.end());
+}
+
+BOOST_AUTO_TEST_CASE(MessagePool_MessageOutlivesPool)
+{
+    auto messagePool = std::make_shared<MessagePool>();
+    auto message = messagePool->acquire(ChannelId::VIDEO, EncryptionType::ENCRYPTED, MessageType::SPECIFIC, 100);
+    messagePool.reset();
+
+    message->insertPayload(common::Data(100, 0x5E));
+    BOOST_CHECK_EQUAL(message->getPayload().size(), 100u);
+}
+
+BOOST_AUTO_TEST_CASE(MessagePool_RecycleAdoptedData)
+{
+    MessagePool messagePool;
+
+    common::Data data;
+    data.reserve(4096);
+    const auto rawData = data.data();
+
+    auto sharedData = messagePool.adopt(std::move(data));
+    BOOST_CHECK(sharedData->data() == rawData);
+    sharedData.reset();
+
+    auto message = messagePool.acquire(ChannelId::VIDEO, EncryptionType::PLAIN, MessageType::SPECIFIC, 4096);
+    BOOST_CHECK(message->getPayload().data() == rawData);
+}
+
+BOOST_AUTO_TEST_CASE(MessagePool_SteadyStateWithoutAllocations)
+{
+    MessagePool messagePool;
+    const common::Data videoPayload(50000, 0x5E);
+    const common::Data audioPayload(2048, 0x5F);
+
+    auto transfer = [&]() {
+        auto videoMessage = messagePool.acquire(ChannelId::VIDEO, EncryptionType::ENCRYPTED, MessageType::SPECIFIC);
+        messagePool.reservePayload(*videoMessage, videoPayload.size());
+        videoMessage->insertPayload(common::DataConstBuffer(videoPayload));
+
+        auto audioMessage = messagePool.acquire(ChannelId::MEDIA_AUDIO, EncryptionType::ENCRYPTED, MessageType::SPECIFIC, audioPayload.size());
+        audioMessage->insertPayload(common::DataConstBuffer(audioPayload));
+
+        Message::Pointer sharedVideoMessage(videoMessage);
+        videoMessage.reset();
+    };
+
+    transfer();
+
+    common::ut::AllocationCounter allocationCounter;
+
+    for(size_t i = 0; i < 1000; ++i)
+    {
+        transfer();
+    }
+
+    BOOST_CHECK_EQUAL(allocationCounter.getCount(), 0u);
+}
+
+BOOST_AUTO_TEST_CASE(MessagePool_SteadyStateLoopbackTraffic)
+{
+    boost::asio::io_service ioService;
+    boost::asio::io_service::strand strand(ioService);
+    auto messagePool(std::make_shared<MessagePool>());
+    auto transport(std::make_shared<transport::ut::LoopbackTransport>(ioService));
+    auto cryptor(std::make_shared<Cryptor>(std::make_shared<transport::SSLWrapper>()));
+    auto messenger(std::make_shared<Messenger>(ioService, std::make_shared<MessageInStream>(ioService, transport, cryptor, messagePool),
+                                               std::make_shared<MessageOutStream>(ioService, transport, cryptor), messagePool));
+    channel::ut::LoopbackServiceChannel videoChannel(strand, messenger, ChannelId::VIDEO);
+    channel::ut::LoopbackServiceChannel audioChannel(strand, messenger, ChannelId::MEDIA_AUDIO);
+
+    const common::Data videoPayload(12000, 0x5E);
+    const common::Data audioPayload(2048, 0x5F);
+    size_t receivedCount = 0;
+
+    auto messageHandler = [&](Message::Pointer) { ++receivedCount; };
+    auto errorHandler = [](const error::Error& e) { BOOST_FAIL(e.what()); };
+    videoChannel.startSubscription(messageHandler, errorHandler);
+    audioChannel.startSubscription(messageHandler, errorHandler);
+
+    auto transfer = [&]() {
+        auto videoMessage(videoChannel.createMessage(EncryptionType::PLAIN, MessageType::SPECIFIC, videoPayload.size()));
+        videoMessage->insertPayload(videoPayload);
+        videoChannel.send(std::move(videoMessage), channel::SendPromise::defer(strand));
+
+        auto audioMessage(audioChannel.createMessage(EncryptionType::PLAIN, MessageType::SPECIFIC, audioPayload.size()));
+        audioMessage->insertPayload(audioPayload);
+        audioChannel.send(std::move(audioMessage), channel::SendPromise::defer(strand));
+
+        ioService.run();
+        ioService.reset();
+    };
+
+    for(size_t i = 0; i < 10; ++i)
+    {
+        transfer();
+    }
+
+    const size_t cTransfersCount = 1000;
+    const auto warmStatistics = messagePool->getStatistics();
+    common::ut::AllocationCounter allocationCounter;
+
+    for(size_t i = 0; i < cTransfersCount; ++i)
+    {
+        transfer();
+    }
+
+    // Message objects, inbound payloads and their segment storage come from the pool. What is
+    // left per message are the transport receive copies, promises, send queue nodes and the
+    // outbound payload handed over to the transport.
+    const size_t cAllocationsPerMessage = 22;
+    BOOST_CHECK_LE(allocationCounter.getCount(), cTransfersCount * 2 * cAllocationsPerMessage);
+    BOOST_CHECK_EQUAL(receivedCount, (cTransfersCount + 10) * 2);
+
+    // Every sent and received message, and every outbound payload, is served by the pool once it is warm.
+    const auto statistics = messagePool->getStatistics();
+    BOOST_CHECK_EQUAL(statistics.messageHits - warmStatistics.messageHits, cTransfersCount * 4);
+    BOOST_CHECK_EQUAL(statistics.messageMisses, warmStatistics.messageMisses);
+    BOOST_CHECK_EQUAL(statistics.blockMisses, warmStatistics.blockMisses);
+    BOOST_CHECK_EQUAL(statistics.payloadHits + statistics.payloadMisses - warmStatistics.payloadHits - warmStatistics.payloadMisses, cTransfersCount * 4);
+
+    // Outbound frame buffers leave with the transport and only received data is adopted back, so some payloads still miss.
+    BOOST_CHECK_LE(statistics.payloadMisses - warmStatistics.payloadMisses, cTransfersCount);
+
+    messenger->stop();
+    ioService.poll();
+}
+
+}
+}
+}
+}
@@ -0,0 +1,275 @@
+/*
+*  This file is part of aasdk library project.
+*  Copyright (C) 2018 f1x.studio (Michal Szwaj)
+*
+*  aasdk is free software: you can redistribute it and/or modify
+*  it under the terms of the GNU General Public License as published by
+*  the Free Software Foundation; either version 3 of the License, or
+*  (at your option) any later version.
+
+*  aasdk is distributed in the hope that it will be useful,
+*  but WITHOUT ANY WARRANTY; without even the implied warranty of
+*  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+*  GNU General Public License for more details.
+*
+*  You should have received a copy of the GNU General Public License
+*  along with aasdk. If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include <atomic>
+#include <functional>
+#include <thread>
+#include <boost/test/unit_test.hpp>
+#include <f1x/aasdk/Common/UT/Benchmark.hpp>
+#include <f1x/aasdk/Transport/UT/LoopbackTransport.hpp>
+#include <f1x/aasdk/Transport/SSLWrapper.hpp>
+#include <f1x/aasdk/Channel/UT/LoopbackServiceChannel.hpp>
+#include <f1x/aasdk/Messenger/Cryptor.hpp>
+#include <f1x/aasdk/Messenger/MessageInStream.hpp>
+#include <f1x/aasdk/Messenger/MessageOutStream.hpp>
+#include <f1x/aasdk/Messenger/Messenger.hpp>
+#include <f1x/aasdk/Messenger/ReceiveRing.hpp>
+#include <f1x/aasdk/Messenger/ReceiveSubscription.hpp>
+
+namespace f1x
+{
+namespace aasdk
+{
+namespace messenger
+{
+namespace ut
+{
+
+using channel::ut::LoopbackServiceChannel;
+
+void benchmarkLoopback(size_t payloadSize)
+{
+    const size_t cIterations = 20000;
+
+    boost::asio::io_service ioService;
+    boost::asio::io_service::strand strand(ioService);
+    auto messagePool(std::make_shared<MessagePool>());
+    auto transport(std::make_shared<transport::ut::LoopbackTransport>(ioService));
+    auto cryptor(std::make_shared<Cryptor>(std::make_shared<transport::SSLWrapper>()));
+    auto messenger(std::make_shared<Messenger>(ioService, std::make_shared<MessageInStream>(ioService, transport, cryptor, messagePool),
+                                               std::make_shared<MessageOutStream>(ioService, transport, cryptor), messagePool));
+    LoopbackServiceChannel serviceChannel(strand, messenger);
+
+    const common::Data payload(payloadSize, 0x5A);
+    size_t sentCount = 0;
+    size_t receivedSize = 0;
+
+    common::ut::runBenchmark("Messenger loopback send and receive " + std::to_string(payloadSize) + "B message", cIterations, payloadSize, [&]() {
+        auto receivePromise = ReceivePromise::defer(strand);
+        receivePromise->then([&](Message::Pointer message) { receivedSize += message->getPayload().size(); },
+                             [](const error::Error& e) { BOOST_FAIL(e.what()); });
+        messenger->enqueueReceive(ChannelId::VIDEO, std::move(receivePromise));
+
+        auto message(serviceChannel.createMessage(EncryptionType::PLAIN, MessageType::SPECIFIC));
+        message->insertPayload(payload);
+
+        auto sendPromise = channel::SendPromise::defer(strand);
+        sendPromise->then([&]() { ++sentCount; }, [](const error::Error& e) { BOOST_FAIL(e.what()); });
+        serviceChannel.send(std::move(message), std::move(sendPromise));
+
+        ioService.run();
+        ioService.reset();
+    });
+
+    BOOST_CHECK_EQUAL(sentCount, cIterations + 0);
+    BOOST_CHECK_EQUAL(receivedSize, cIterations * payloadSize);
+    messenger->stop();
+}
+
+void benchmarkSubscribedLoopback(size_t payloadSize)
+{
+    const size_t cIterations = 20000;
+
+    boost::asio::io_service ioService;
+    boost::asio::io_service::strand strand(ioService);
+    auto messagePool(std::make_shared<MessagePool>());
+    auto transport(std::make_shared<transport::ut::LoopbackTransport>(ioService));
+    auto cryptor(std::make_shared<Cryptor>(std::make_shared<transport::SSLWrapper>()));
+    auto messenger(std::make_shared<Messenger>(ioService, std::make_shared<MessageInStream>(ioService, transport, cryptor, messagePool),
+                                               std::make_shared<MessageOutStream>(ioService, transport, cryptor), messagePool));
+    LoopbackServiceChannel serviceChannel(strand, messenger);
+
+    const common::Data payload(payloadSize, 0x5A);
+    size_t sentCount = 0;
+    size_t receivedSize = 0;
+
+    messenger->subscribe(ChannelId::VIDEO, std::make_shared<ReceiveSubscription>(strand,
+                         [&](Message::Pointer message) { receivedSize += message->getPayload().size(); },
+                         [](const error::Error& e) { BOOST_FAIL(e.what()); }));
+
+    common::ut::runBenchmark("Messenger subscribed loopback send and receive " + std::to_string(payloadSize) + "B message", cIterations, payloadSize, [&]() {
+        auto message(serviceChannel.createMessage(EncryptionType::PLAIN, MessageType::SPECIFIC));
+        message->insertPayload(payload);
+
+        auto sendPromise = channel::SendPromise::defer(strand);
+        sendPromise->then([&]() { ++sentCount; }, [](const error::Error& e) { BOOST_FAIL(e.what()); });
+        serviceChannel.send(std::move(message), std::move(sendPromise));
+
+        ioService.run();
+        ioService.reset();
+    });
+
+    BOOST_CHECK_EQUAL(sentCount, cIterations + 0);
+    BOOST_CHECK_EQUAL(receivedSize, cIterations * payloadSize);
+    messenger->stop();
+    ioService.poll();
+}
+
+void benchmarkRingLoopback(size_t payloadSize)
+{
+    const size_t cIterations = 20000;
+
+    boost::asio::io_service ioService;
+    boost::asio::io_service::strand strand(ioService);
+    auto messagePool(std::make_shared<MessagePool>());
+    auto transport(std::make_shared<transport::ut::LoopbackTransport>(ioService));
+    auto cryptor(std::make_shared<Cryptor>(std::make_shared<transport::SSLWrapper>()));
+    auto messenger(std::make_shared<Messenger>(ioService, std::make_shared<MessageInStream>(ioService, transport, cryptor, messagePool),
+                                               std::make_shared<MessageOutStream>(ioService, transport, cryptor), messagePool));
+    LoopbackServiceChannel serviceChannel(strand, messenger);
+
+    const common::Data payload(payloadSize, 0x5A);
+    auto ring = std::make_shared<ReceiveRing>();
+    messenger->subscribe(ChannelId::VIDEO, ring);
+
+    size_t receivedSize = 0;
+    std::thread consumer([&]() {
+        Message::Pointer message;
+
+        while(receivedSize < cIterations * payloadSize && ring->pop(message, std::chrono::milliseconds(1000)))
+        {
+            receivedSize += message->getPayload().size();
+        }
+    });
+
+    common::ut::runBenchmark("Messenger ring loopback send and receive " + std::to_string(payloadSize) + "B message", cIterations, payloadSize, [&]() {
+        auto message(serviceChannel.createMessage(EncryptionType::PLAIN, MessageType::SPECIFIC));
+        message->insertPayload(payload);
+        serviceChannel.send(std::move(message), channel::SendPromise::defer(strand));
+
+        ioService.run();
+        ioService.reset();
+    });
+
+    consumer.join();
+    BOOST_CHECK_EQUAL(receivedSize, cIterations * payloadSize);
+    messenger->stop();
+    ioService.poll();
+}
+
+void benchmarkThreadScaling(size_t threadsCount)
+{
+    const size_t cMessagesPerChannel = 2000;
+    const std::vector<std::pair<ChannelId, size_t>> cTraffic{{ChannelId::VIDEO, 16000}, {ChannelId::MEDIA_AUDIO, 2048}, {ChannelId::INPUT, 64}};
+
+    boost::asio::io_service ioService;
+    auto messagePool(std::make_shared<MessagePool>());
+    auto transport(std::make_shared<transport::ut::LoopbackTransport>(ioService));
+    auto cryptor(std::make_shared<Cryptor>(std::make_shared<transport::SSLWrapper>()));
+    auto messenger(std::make_shared<Messenger>(ioService, std::make_shared<MessageInStream>(ioService, transport, cryptor, messagePool),
+                                               std::make_shared<MessageOutStream>(ioService, transport, cryptor), messagePool));
+
+    std::vector<std::unique_ptr<boost::asio::io_service::strand>> strands;
+    std::vector<std::unique_ptr<LoopbackServiceChannel>> serviceChannels;
+    auto work = std::make_unique<boost::asio::io_service::work>(ioService);
+    std::atomic<size_t> receivedCount(0);
+    size_t totalSize = 0;
+
+    for(const auto& traffic : cTraffic)
+    {
+        strands.emplace_back(std::make_unique<boost::asio::io_service::strand>(ioService));
+        serviceChannels.emplace_back(std::make_unique<LoopbackServiceChannel>(*strands.back(), messenger, traffic.first));
+        totalSize += cMessagesPerChannel * traffic.second;
+
+        messenger->subscribe(traffic.first, std::make_shared<ReceiveSubscription>(*strands.back(),
+                             [&](Message::Pointer) {
+                                 if(++receivedCount == cMessagesPerChannel * cTraffic.size())
+                                 {
+                                     work.reset();
+                                 }
+                             },
+                             [](const error::Error& e) { BOOST_FAIL(e.what()); }));
+    }
+
+    std::vector<common::Data> payloads;
+    std::vector<size_t> sentCounts(cTraffic.size(), 0);
+    std::vector<std::function<void()>> senders(cTraffic.size());
+
+    for(size_t i = 0; i < cTraffic.size(); ++i)
+    {
+        payloads.emplace_back(cTraffic[i].second, 0x5A);
+        senders[i] = [&, i]() {
+            if(sentCounts[i] == cMessagesPerChannel)
+            {
+                return;
+            }
+
+            ++sentCounts[i];
+            auto message(serviceChannels[i]->createMessage(EncryptionType::PLAIN, MessageType::SPECIFIC));
+            message->insertPayload(payloads[i]);
+
+            auto sendPromise = channel::SendPromise::defer(*strands[i]);
+            sendPromise->then([&, i]() { senders[i](); }, [](const error::Error& e) { BOOST_FAIL(e.what()); });
+            serviceChannels[i]->send(std::move(message), std::move(sendPromise));
+        };
+
+        strands[i]->post([&, i]() { senders[i](); });
+    }
+
+    common::ut::runBenchmark("Messenger video+audio+input on " + std::to_string(threadsCount) + " threads", 1, totalSize, [&]() {
+        std::vector<std::thread> threads;
+
+        for(size_t i = 0; i < threadsCount; ++i)
+        {
+            threads.emplace_back([&]() { ioService.run(); });
+        }
+
+        for(auto& thread : threads)
+        {
+            thread.join();
+        }
+    });
+
+    BOOST_CHECK_EQUAL(receivedCount.load(), cMessagesPerChannel * cTraffic.size());
+    messenger->stop();
+    ioService.reset();
+    ioService.poll();
+}
+
+BOOST_AUTO_TEST_CASE(Messenger_LoopbackLatency)
+{
+    benchmarkLoopback(64);
+    benchmarkLoopback(16000);
+}
+
+BOOST_AUTO_TEST_CASE(Messenger_SubscribedLoopbackLatency)
+{
+    benchmarkSubscribedLoopback(64);
+    benchmarkSubscribedLoopback(16000);
+}
+
+BOOST_AUTO_TEST_CASE(Messenger_RingLoopbackLatency)
+{
+    benchmarkRingLoopback(64);
+    benchmarkRingLoopback(16000);
+}
+
+BOOST_AUTO_TEST_CASE(Messenger_ThreadScaling)
+{
+    const size_t cMaxThreadsCount = std::max<size_t>(std::thread::hardware_concurrency(), 4);
+
+    for(size_t threadsCount = 1; threadsCount <= cMaxThreadsCount; threadsCount *= 2)
+    {
+        benchmarkThreadScaling(threadsCount);
+    }
+}
+
+}
+}
+}
+}
@@ -19,6 +19,8 @@
 #include <boost/endian/conversion.hpp>
 #include <f1x/aasdk/Error/Error.hpp>
 #include <f1x/aasdk/Messenger/Messenger.hpp>
+#include <f1x/aasdk/Messenger/FrameHeader.hpp>
+#include <f1x/aasdk/Messenger/FrameSize.hpp>
 #include <f1x/aasdk/Common/Log.hpp>
 
 namespace f1x
@@ -28,11 +30,16 @@ namespace aasdk
 namespace messenger
 {
 
-Messenger::Messenger(boost::asio::io_service& ioService, IMessageInStream::Pointer messageInStream, IMessageOutStream::Pointer messageOutStream)
+Messenger::Messenger(boost::asio::io_service& ioService, IMessageInStream::Pointer messageInStream, IMessageOutStream::Pointer messageOutStream,
+                     MessagePool::Pointer messagePool)
     : receiveStrand_(ioService)
     , sendStrand_(ioService)
     , messageInStream_(std::move(messageInStream))
     , messageOutStream_(std::move(messageOutStream))
+    , messagePool_(std::move(messagePool))
+    , isReceiving_(false)
+    , isReceivingLoop_(false)
+    , expiredSendCount_(0)
 {
 
 }
@@ -47,22 +54,129 @@ void Messenger::enqueueReceive(ChannelId channelId, ReceivePromise::Pointer prom
         else
         {
             channelReceivePromiseQueue_.push(channelId, std::move(promise));
+            this->startReceive();
+        }
+    });
+}
 
-            if(channelReceivePromiseQueue_.size() == 1)
-            {
-                auto inStreamPromise = ReceivePromise::defer(receiveStrand_);
-                inStreamPromise->then(std::bind(&Messenger::inStreamMessageHandler, this->shared_from_this(), std::placeholders::_1),
-                                     std::bind(&Messenger::rejectReceivePromiseQueue, this->shared_from_this(), std::placeholders::_1));
-                messageInStream_->startReceive(std::move(inStreamPromise));
-            }
+void Messenger::subscribe(ChannelId channelId, IReceiveSubscription::Pointer subscription)
+{
+    receiveStrand_.dispatch([this, self = this->shared_from_this(), channelId, subscription = std::move(subscription)]() mutable {
+        std::unique_lock<std::mutex> lock(receiveMutex_);
+        auto previousSubscription = channelReceiveSubscriptions_.find(channelId);
+        if(previousSubscription != channelReceiveSubscriptions_.end())
+        {
+            previousSubscription->second->cancel();
         }
+
+        while(!channelReceiveMessageQueue_.empty(channelId))
+        {
+            subscription->deliver(channelReceiveMessageQueue_.pop(channelId));
+        }
+
+        channelReceiveSubscriptions_[channelId] = std::move(subscription);
+        lock.unlock();
+        this->startReceive();
     });
 }
 
+void Messenger::unsubscribe(ChannelId channelId)
+{
+    receiveStrand_.dispatch([this, self = this->shared_from_this(), channelId]() {
+        std::unique_lock<std::mutex> lock(receiveMutex_);
+        auto subscription = channelReceiveSubscriptions_.find(channelId);
+        if(subscription != channelReceiveSubscriptions_.end())
+        {
+            subscription->second->cancel();
+            channelReceiveSubscriptions_.erase(subscription);
+        }
+        lock.unlock();
+        this->stopIdleReceiveLoop();
+    });
+}
+
+void Messenger::startReceive()
+{
+    if(isReceiving_)
+    {
+        return;
+    }
+
+    std::unique_lock<std::mutex> lock(receiveMutex_);
+    const bool isSubscribed = !channelReceiveSubscriptions_.empty();
+    lock.unlock();
+
+    if(isSubscribed)
+    {
+        // Subscribed channels are fed by a receive loop that keeps running across messages
+        // and hands their messages over on the in stream strand, bypassing receiveStrand_.
+        isReceiving_ = true;
+        isReceivingLoop_ = true;
+        messageInStream_->startReceiveLoop(std::bind(&Messenger::inStreamLoopMessageHandler, this->shared_from_this(), std::placeholders::_1),
+                                           std::bind(&Messenger::inStreamLoopErrorHandler, this->shared_from_this(), std::placeholders::_1));
+    }
+    else if(!channelReceivePromiseQueue_.empty())
+    {
+        isReceiving_ = true;
+        auto inStreamPromise = ReceivePromise::defer(receiveStrand_);
+        inStreamPromise->then(std::bind(&Messenger::inStreamMessageHandler, this->shared_from_this(), std::placeholders::_1),
+                             std::bind(&Messenger::rejectReceivePromiseQueue, this->shared_from_this(), std::placeholders::_1));
+        messageInStream_->startReceive(std::move(inStreamPromise));
+    }
+}
+
+void Messenger::stopIdleReceiveLoop()
+{
+    std::unique_lock<std::mutex> lock(receiveMutex_);
+    const bool isSubscribed = !channelReceiveSubscriptions_.empty();
+    lock.unlock();
+
+    if(isReceivingLoop_ && !isSubscribed)
+    {
+        // Without subscribers the loop would read and queue messages for good; stop it so the
+        // transport is only read again for pending receives.
+        messageInStream_->stopReceiveLoop();
+        isReceiving_ = false;
+        isReceivingLoop_ = false;
+        this->startReceive();
+    }
+}
+
+bool Messenger::deliverToSubscription(Message::Pointer& message)
+{
+    // Called with receiveMutex_ held.
+    auto subscription = channelReceiveSubscriptions_.find(message->getChannelId());
+    if(subscription == channelReceiveSubscriptions_.end())
+    {
+        return false;
+    }
+
+    if(subscription->second->isCancelled())
+    {
+        channelReceiveSubscriptions_.erase(subscription);
+        receiveStrand_.post(std::bind(&Messenger::stopIdleReceiveLoop, this->shared_from_this()));
+        return false;
+    }
+
+    subscription->second->deliver(std::move(message));
+    return true;
+}
+
 void Messenger::enqueueSend(Message::Pointer message, SendPromise::Pointer promise)
 {
-    sendStrand_.dispatch([this, self = this->shared_from_this(), message = std::move(message), promise = std::move(promise)]() mutable {
-        channelSendPromiseQueue_.emplace_back(std::make_pair(std::move(message), std::move(promise)));
+    this->enqueueSend(std::move(message), std::move(promise), SendDeadline::max());
+}
+
+void Messenger::enqueueSend(Message::Pointer message, SendPromise::Pointer promise, SendDeadline deadline)
+{
+    sendStrand_.dispatch([this, self = this->shared_from_this(), message = std::move(message), promise = std::move(promise), deadline]() mutable {
+        if(!channelSendPromiseQueue_.empty())
+        {
+            this->dropExpiredSends(std::next(channelSendPromiseQueue_.begin()));
+        }
+
+        channelSendPromiseQueue_.emplace_back(std::move(message), std::move(promise), deadline);
+        channelSendBacklog_.push(channelSendPromiseQueue_.back().channelId, channelSendPromiseQueue_.back().size);
 
         if(channelSendPromiseQueue_.size() == 1)
         {
@@ -71,28 +185,85 @@ void Messenger::enqueueSend(Message::Pointer message, SendPromise::Pointer promi
     });
 }
 
+void Messenger::enqueueWritable(ChannelId channelId, SendPromise::Pointer promise)
+{
+    sendStrand_.dispatch([this, self = this->shared_from_this(), channelId, promise = std::move(promise)]() mutable {
+        channelSendBacklog_.enqueueWritable(channelId, std::move(promise));
+    });
+}
+
+void Messenger::setSendWatermarks(ChannelId channelId, SendWatermarks watermarks)
+{
+    sendStrand_.dispatch([this, self = this->shared_from_this(), channelId, watermarks]() mutable {
+        channelSendBacklog_.setWatermarks(channelId, watermarks);
+    });
+}
+
 void Messenger::inStreamMessageHandler(Message::Pointer message)
 {
-    auto channelId = message->getChannelId();
-    if (message->getChannelId() != ChannelId::VIDEO) {
-        //AASDK_LOG(debug) << channelIdToString(message->getChannelId()) << ": " << common::dump(message->getPayload());
+    isReceiving_ = false;
+
+    std::unique_lock<std::mutex> lock(receiveMutex_);
+    const bool isDelivered = this->deliverToSubscription(message);
+    lock.unlock();
+
+    if(!isDelivered)
+    {
+        this->queueMessage(std::move(message));
     }
 
-    if(channelReceivePromiseQueue_.isPending(channelId))
+    this->startReceive();
+}
+
+void Messenger::inStreamLoopMessageHandler(Message::Pointer message)
+{
     {
-        this->parseMessage(message, channelReceivePromiseQueue_.pop(channelId));
+        std::lock_guard<std::mutex> lock(receiveMutex_);
+        auto& pendingReceives = channelPendingReceives_[message->getChannelId()];
+
+        // Earlier messages of this channel still waiting on receiveStrand_ must be delivered first.
+        if(pendingReceives == 0 && this->deliverToSubscription(message))
+        {
+            return;
+        }
+
+        ++pendingReceives;
     }
-    else
+
+    receiveStrand_.post(std::bind(&Messenger::pendingReceiveHandler, this->shared_from_this(), std::move(message)));
+}
+
+void Messenger::pendingReceiveHandler(Message::Pointer message)
+{
     {
-        channelReceiveMessageQueue_.push(std::move(message));
+        std::lock_guard<std::mutex> lock(receiveMutex_);
+        --channelPendingReceives_[message->getChannelId()];
+
+        if(this->deliverToSubscription(message))
+        {
+            return;
+        }
     }
 
-    if(!channelReceivePromiseQueue_.empty())
+    this->queueMessage(std::move(message));
+}
+
+void Messenger::inStreamLoopErrorHandler(const error::Error& e)
+{
+    receiveStrand_.post(std::bind(&Messenger::rejectReceivePromiseQueue, this->shared_from_this(), e));
+}
+
+void Messenger::queueMessage(Message::Pointer message)
+{
+    const auto channelId = message->getChannelId();
+
+    if(channelReceivePromiseQueue_.isPending(channelId))
     {
-        auto inStreamPromise = ReceivePromise::defer(receiveStrand_);
-        inStreamPromise->then(std::bind(&Messenger::inStreamMessageHandler, this->shared_from_this(), std::placeholders::_1),
-                             std::bind(&Messenger::rejectReceivePromiseQueue, this->shared_from_this(), std::placeholders::_1));
-        messageInStream_->startReceive(std::move(inStreamPromise));
+        this->parseMessage(std::move(message), channelReceivePromiseQueue_.pop(channelId));
+    }
+    else
+    {
+        channelReceiveMessageQueue_.push(std::move(message));
     }
 }
 
@@ -105,17 +276,45 @@ void Messenger::parseMessage(Message::Pointer message, ReceivePromise::Pointer p
 
 void Messenger::doSend()
 {
+    this->dropExpiredSends(channelSendPromiseQueue_.begin());
+
+    if(channelSendPromiseQueue_.empty())
+    {
+        return;
+    }
+
     auto queueElementIter = channelSendPromiseQueue_.begin();
     auto outStreamPromise = SendPromise::defer(sendStrand_);
     outStreamPromise->then(std::bind(&Messenger::outStreamMessageHandler, this->shared_from_this(), queueElementIter),
                            std::bind(&Messenger::rejectSendPromiseQueue, this->shared_from_this(), std::placeholders::_1));
 
-    messageOutStream_->stream(std::move(queueElementIter->first), std::move(outStreamPromise));
+    messageOutStream_->stream(std::move(queueElementIter->message), std::move(outStreamPromise));
+}
+
+void Messenger::dropExpiredSends(ChannelSendQueue::iterator queueElement)
+{
+    const auto now = std::chrono::steady_clock::now();
+
+    while(queueElement != channelSendPromiseQueue_.end())
+    {
+        if(queueElement->deadline < now)
+        {
+            queueElement->promise->reject(error::Error(error::ErrorCode::MESSENGER_SEND_DEADLINE_EXCEEDED));
+            channelSendBacklog_.pop(queueElement->channelId, queueElement->size);
+            queueElement = channelSendPromiseQueue_.erase(queueElement);
+            ++expiredSendCount_;
+        }
+        else
+        {
+            ++queueElement;
+        }
+    }
 }
 
 void Messenger::outStreamMessageHandler(ChannelSendQueue::iterator queueElement)
 {
-    queueElement->second->resolve();
+    queueElement->promise->resolve();
+    channelSendBacklog_.pop(queueElement->channelId, queueElement->size);
     channelSendPromiseQueue_.erase(queueElement);
 
     if(!channelSendPromiseQueue_.empty())
@@ -126,6 +325,17 @@ void Messenger::outStreamMessageHandler(ChannelSendQueue::iterator queueElement)
 
 void Messenger::rejectReceivePromiseQueue(const error::Error& e)
 {
+    isReceiving_ = false;
+    isReceivingLoop_ = false;
+
+    std::unique_lock<std::mutex> lock(receiveMutex_);
+    for(auto& subscription : channelReceiveSubscriptions_)
+    {
+        subscription.second->fail(e);
+    }
+    channelReceiveSubscriptions_.clear();
+    lock.unlock();
+
     while(!channelReceivePromiseQueue_.empty())
     {
         channelReceivePromiseQueue_.pop()->reject(e);
@@ -138,14 +348,59 @@ void Messenger::rejectSendPromiseQueue(const error::Error& e)
     {
         auto queueElement(std::move(channelSendPromiseQueue_.front()));
         channelSendPromiseQueue_.pop_front();
-        queueElement.second->reject(e);
+        queueElement.promise->reject(e);
     }
+
+    channelSendBacklog_.reject(e);
+}
+
+size_t Messenger::getExpiredSendCount() const
+{
+    return expiredSendCount_;
+}
+
+Message::Pointer Messenger::createMessage(ChannelId channelId, EncryptionType encryptionType, MessageType type, size_t payloadSize)
+{
+    if(encryptionType != EncryptionType::PLAIN || payloadSize >= FrameSize::cMaxFramePayloadSize)
+    {
+        return messagePool_->acquire(channelId, encryptionType, type, payloadSize);
+    }
+
+    const auto headroom = FrameHeader::getSizeOf() + FrameSize::getSizeOf(FrameSizeType::SHORT);
+    auto message = messagePool_->acquire(channelId, encryptionType, type, headroom + payloadSize);
+    message->reserveHeadroom(headroom);
+    return message;
+}
+
+Messenger::ChannelSendQueueElement::ChannelSendQueueElement(Message::Pointer _message, SendPromise::Pointer _promise, SendDeadline _deadline)
+    : message(std::move(_message))
+    , promise(std::move(_promise))
+    , channelId(message->getChannelId())
+    , size(message->getPayloadSize())
+    , deadline(_deadline)
+{
+
 }
 
 void Messenger::stop()
 {
     receiveStrand_.dispatch([this, self = this->shared_from_this()]() {
+        // The loop handlers keep this messenger alive, so the loop has to be stopped explicitly.
+        if(isReceivingLoop_)
+        {
+            messageInStream_->stopReceiveLoop();
+            isReceiving_ = false;
+            isReceivingLoop_ = false;
+        }
+
         channelReceiveMessageQueue_.clear();
+
+        std::lock_guard<std::mutex> lock(receiveMutex_);
+        for(auto& subscription : channelReceiveSubscriptions_)
+        {
+            subscription.second->cancel();
+        }
+        channelReceiveSubscriptions_.clear();
     });
 }
 
@@ -16,12 +16,15 @@
 *  along with aasdk. If not, see <http://www.gnu.org/licenses/>.
 */
 
+#include <thread>
 #include <boost/test/unit_test.hpp>
 #include <f1x/aasdk/Messenger/UT/MessageInStream.mock.hpp>
 #include <f1x/aasdk/Messenger/UT/MessageOutStream.mock.hpp>
 #include <f1x/aasdk/Messenger/UT/ReceivePromiseHandler.mock.hpp>
 #include <f1x/aasdk/Messenger/UT/SendPromiseHandler.mock.hpp>
 #include <f1x/aasdk/Messenger/Messenger.hpp>
+#include <f1x/aasdk/Messenger/ReceiveRing.hpp>
+#include <f1x/aasdk/Messenger/ReceiveSubscription.hpp>
 
 namespace f1x
 {
@@ -226,6 +229,317 @@ BOOST_FIXTURE_TEST_CASE(Messenger_SendFailed, MessengerUnitTest)
     ioService_.run();
 }
 
+BOOST_FIXTURE_TEST_CASE(Messenger_WritableWithoutWatermarks, MessengerUnitTest)
+{
+    Messenger::Pointer themessenger(std::make_shared<Messenger>(ioService_, messageInStream_, messageOutStream_));
+    themessenger->enqueueWritable(ChannelId::AV_INPUT, std::move(sendPromise_));
+
+    EXPECT_CALL(sendPromiseHandlerMock_, onReject(_)).Times(0);
+    EXPECT_CALL(sendPromiseHandlerMock_, onResolve());
+    ioService_.run();
+}
+
+BOOST_FIXTURE_TEST_CASE(Messenger_WritableAfterLowWatermark, MessengerUnitTest)
+{
+    Messenger::Pointer themessenger(std::make_shared<Messenger>(ioService_, messageInStream_, messageOutStream_));
+    themessenger->setSendWatermarks(ChannelId::AV_INPUT, SendWatermarks(std::numeric_limits<size_t>::max(), 0, 2, 0));
+
+    SendPromise::Pointer outStreamSendPromise;
+    EXPECT_CALL(messageOutStreamMock_, stream(_, _)).Times(2).WillRepeatedly(SaveArg<1>(&outStreamSendPromise));
+
+    Message::Pointer message(std::make_shared<Message>(ChannelId::AV_INPUT, EncryptionType::ENCRYPTED, MessageType::SPECIFIC));
+    themessenger->enqueueSend(message, SendPromise::defer(ioService_));
+    themessenger->enqueueSend(message, SendPromise::defer(ioService_));
+    themessenger->enqueueWritable(ChannelId::AV_INPUT, std::move(sendPromise_));
+
+    EXPECT_CALL(sendPromiseHandlerMock_, onReject(_)).Times(0);
+    EXPECT_CALL(sendPromiseHandlerMock_, onResolve()).Times(0);
+    ioService_.run();
+    ioService_.reset();
+
+    outStreamSendPromise->resolve();
+    ioService_.run();
+    ioService_.reset();
+    ::testing::Mock::VerifyAndClearExpectations(&sendPromiseHandlerMock_);
+
+    EXPECT_CALL(sendPromiseHandlerMock_, onReject(_)).Times(0);
+    EXPECT_CALL(sendPromiseHandlerMock_, onResolve());
+    outStreamSendPromise->resolve();
+    ioService_.run();
+}
+
+BOOST_FIXTURE_TEST_CASE(Messenger_InvertedWatermarksKeepHysteresis, MessengerUnitTest)
+{
+    Messenger::Pointer themessenger(std::make_shared<Messenger>(ioService_, messageInStream_, messageOutStream_));
+    themessenger->setSendWatermarks(ChannelId::AV_INPUT, SendWatermarks(std::numeric_limits<size_t>::max(), 0, 2, 5));
+
+    EXPECT_CALL(messageOutStreamMock_, stream(_, _));
+
+    Message::Pointer message(std::make_shared<Message>(ChannelId::AV_INPUT, EncryptionType::ENCRYPTED, MessageType::SPECIFIC));
+    themessenger->enqueueSend(message, SendPromise::defer(ioService_));
+    themessenger->enqueueSend(message, SendPromise::defer(ioService_));
+    themessenger->enqueueSend(message, SendPromise::defer(ioService_));
+    themessenger->enqueueWritable(ChannelId::AV_INPUT, std::move(sendPromise_));
+
+    EXPECT_CALL(sendPromiseHandlerMock_, onReject(_)).Times(0);
+    EXPECT_CALL(sendPromiseHandlerMock_, onResolve()).Times(0);
+    ioService_.run();
+}
+
+BOOST_FIXTURE_TEST_CASE(Messenger_WritableRejectedOnSendFailure, MessengerUnitTest)
+{
+    Messenger::Pointer themessenger(std::make_shared<Messenger>(ioService_, messageInStream_, messageOutStream_));
+    themessenger->setSendWatermarks(ChannelId::AV_INPUT, SendWatermarks(1, 0));
+
+    SendPromise::Pointer outStreamSendPromise;
+    EXPECT_CALL(messageOutStreamMock_, stream(_, _)).WillOnce(SaveArg<1>(&outStreamSendPromise));
+
+    Message::Pointer message(std::make_shared<Message>(ChannelId::AV_INPUT, EncryptionType::ENCRYPTED, MessageType::SPECIFIC));
+    message->insertPayload(common::Data(100, 0x5E));
+    themessenger->enqueueSend(message, SendPromise::defer(ioService_));
+    themessenger->enqueueWritable(ChannelId::AV_INPUT, std::move(sendPromise_));
+
+    ioService_.run();
+    ioService_.reset();
+
+    error::Error e(error::ErrorCode::USB_TRANSFER, 13);
+    outStreamSendPromise->reject(e);
+
+    EXPECT_CALL(sendPromiseHandlerMock_, onReject(e));
+    EXPECT_CALL(sendPromiseHandlerMock_, onResolve()).Times(0);
+    ioService_.run();
+}
+
+BOOST_FIXTURE_TEST_CASE(Messenger_SendDeadlineExceeded, MessengerUnitTest)
+{
+    Messenger::Pointer themessenger(std::make_shared<Messenger>(ioService_, messageInStream_, messageOutStream_));
+
+    Message::Pointer message(std::make_shared<Message>(ChannelId::AV_INPUT, EncryptionType::ENCRYPTED, MessageType::SPECIFIC));
+    themessenger->enqueueSend(message, std::move(sendPromise_), std::chrono::steady_clock::now() - std::chrono::milliseconds(1));
+
+    EXPECT_CALL(messageOutStreamMock_, stream(_, _)).Times(0);
+    EXPECT_CALL(sendPromiseHandlerMock_, onReject(error::Error(error::ErrorCode::MESSENGER_SEND_DEADLINE_EXCEEDED)));
+    EXPECT_CALL(sendPromiseHandlerMock_, onResolve()).Times(0);
+    ioService_.run();
+
+    BOOST_CHECK_EQUAL(themessenger->getExpiredSendCount(), 1u);
+}
+
+BOOST_FIXTURE_TEST_CASE(Messenger_QueuedSendExpiresDuringStall, MessengerUnitTest)
+{
+    Messenger::Pointer themessenger(std::make_shared<Messenger>(ioService_, messageInStream_, messageOutStream_));
+
+    Message::Pointer message(std::make_shared<Message>(ChannelId::AV_INPUT, EncryptionType::ENCRYPTED, MessageType::SPECIFIC));
+    themessenger->enqueueSend(message, SendPromise::defer(ioService_));
+    themessenger->enqueueSend(message, std::move(sendPromise_), std::chrono::steady_clock::now() + std::chrono::milliseconds(1));
+
+    SendPromise::Pointer outStreamSendPromise;
+    EXPECT_CALL(messageOutStreamMock_, stream(message, _)).WillOnce(SaveArg<1>(&outStreamSendPromise));
+
+    ioService_.run();
+    ioService_.reset();
+
+    std::this_thread::sleep_for(std::chrono::milliseconds(5));
+
+    EXPECT_CALL(sendPromiseHandlerMock_, onReject(error::Error(error::ErrorCode::MESSENGER_SEND_DEADLINE_EXCEEDED)));
+    EXPECT_CALL(sendPromiseHandlerMock_, onResolve()).Times(0);
+    outStreamSendPromise->resolve();
+    ioService_.run();
+
+    BOOST_CHECK_EQUAL(themessenger->getExpiredSendCount(), 1u);
+}
+
+BOOST_FIXTURE_TEST_CASE(Messenger_SubscriptionReceivesWithoutRearm, MessengerUnitTest)
+{
+    Messenger::Pointer themessenger(std::make_shared<Messenger>(ioService_, messageInStream_, messageOutStream_));
+    boost::asio::io_service::strand strand(ioService_);
+    themessenger->subscribe(ChannelId::MEDIA_AUDIO, std::make_shared<ReceiveSubscription>(strand,
+                            std::bind(&ReceivePromiseHandlerMock::onResolve, &receivePromiseHandlerMock_, std::placeholders::_1),
+                            std::bind(&ReceivePromiseHandlerMock::onReject, &receivePromiseHandlerMock_, std::placeholders::_1)));
+
+    IMessageInStream::MessageHandler loopMessageHandler;
+    EXPECT_CALL(messageInStreamMock_, startReceive(_)).Times(0);
+    EXPECT_CALL(messageInStreamMock_, startReceiveLoop(_, _)).WillOnce(SaveArg<0>(&loopMessageHandler));
+
+    ioService_.run();
+    ioService_.reset();
+
+    Message::Pointer firstMessage(std::make_shared<Message>(ChannelId::MEDIA_AUDIO, EncryptionType::ENCRYPTED, MessageType::SPECIFIC));
+    Message::Pointer secondMessage(std::make_shared<Message>(ChannelId::MEDIA_AUDIO, EncryptionType::ENCRYPTED, MessageType::SPECIFIC));
+
+    EXPECT_CALL(receivePromiseHandlerMock_, onReject(_)).Times(0);
+    EXPECT_CALL(receivePromiseHandlerMock_, onResolve(firstMessage));
+    EXPECT_CALL(receivePromiseHandlerMock_, onResolve(secondMessage));
+
+    loopMessageHandler(firstMessage);
+    loopMessageHandler(secondMessage);
+    ioService_.run();
+}
+
+BOOST_FIXTURE_TEST_CASE(Messenger_SubscriptionDrainsQueuedMessages, MessengerUnitTest)
+{
+    Messenger::Pointer themessenger(std::make_shared<Messenger>(ioService_, messageInStream_, messageOutStream_));
+    themessenger->enqueueReceive(ChannelId::INPUT, std::move(receivePromise_));
+
+    ReceivePromise::Pointer inStreamReceivePromise;
+    EXPECT_CALL(messageInStreamMock_, startReceive(_)).WillRepeatedly(SaveArg<0>(&inStreamReceivePromise));
+
+    ioService_.run();
+    ioService_.reset();
+
+    Message::Pointer message(std::make_shared<Message>(ChannelId::MEDIA_AUDIO, EncryptionType::ENCRYPTED, MessageType::SPECIFIC));
+    inStreamReceivePromise->resolve(message);
+    ioService_.run();
+    ioService_.reset();
+
+    boost::asio::io_service::strand strand(ioService_);
+    themessenger->subscribe(ChannelId::MEDIA_AUDIO, std::make_shared<ReceiveSubscription>(strand,
+                            std::bind(&ReceivePromiseHandlerMock::onResolve, &receivePromiseHandlerMock_, std::placeholders::_1),
+                            std::bind(&ReceivePromiseHandlerMock::onReject, &receivePromiseHandlerMock_, std::placeholders::_1)));
+
+    EXPECT_CALL(receivePromiseHandlerMock_, onReject(_)).Times(0);
+    EXPECT_CALL(receivePromiseHandlerMock_, onResolve(message));
+    ioService_.run();
+}
+
+BOOST_FIXTURE_TEST_CASE(Messenger_UnsubscribeStopsDelivery, MessengerUnitTest)
+{
+    Messenger::Pointer themessenger(std::make_shared<Messenger>(ioService_, messageInStream_, messageOutStream_));
+    boost::asio::io_service::strand strand(ioService_);
+    ReceivePromiseHandlerMock subscriptionHandlerMock;
+    themessenger->subscribe(ChannelId::MEDIA_AUDIO, std::make_shared<ReceiveSubscription>(strand,
+                            std::bind(&ReceivePromiseHandlerMock::onResolve, &subscriptionHandlerMock, std::placeholders::_1),
+                            std::bind(&ReceivePromiseHandlerMock::onReject, &subscriptionHandlerMock, std::placeholders::_1)));
+
+    IMessageInStream::MessageHandler loopMessageHandler;
+    EXPECT_CALL(messageInStreamMock_, startReceiveLoop(_, _)).WillOnce(SaveArg<0>(&loopMessageHandler));
+
+    ioService_.run();
+    ioService_.reset();
+
+    // Without subscribers the loop stops and the pending receive reads on its own.
+    EXPECT_CALL(messageInStreamMock_, stopReceiveLoop());
+    EXPECT_CALL(messageInStreamMock_, startReceive(_));
+    themessenger->unsubscribe(ChannelId::MEDIA_AUDIO);
+    themessenger->enqueueReceive(ChannelId::MEDIA_AUDIO, std::move(receivePromise_));
+    ioService_.run();
+    ioService_.reset();
+
+    // A message the loop handed over before it was stopped still reaches the pending receive.
+    Message::Pointer message(std::make_shared<Message>(ChannelId::MEDIA_AUDIO, EncryptionType::ENCRYPTED, MessageType::SPECIFIC));
+    EXPECT_CALL(subscriptionHandlerMock, onResolve(_)).Times(0);
+    EXPECT_CALL(subscriptionHandlerMock, onReject(_)).Times(0);
+    EXPECT_CALL(receivePromiseHandlerMock_, onReject(_)).Times(0);
+    EXPECT_CALL(receivePromiseHandlerMock_, onResolve(message));
+
+    loopMessageHandler(message);
+    ioService_.run();
+}
+
+BOOST_FIXTURE_TEST_CASE(Messenger_SubscriptionFailedOnReceiveError, MessengerUnitTest)
+{
+    Messenger::Pointer themessenger(std::make_shared<Messenger>(ioService_, messageInStream_, messageOutStream_));
+    boost::asio::io_service::strand strand(ioService_);
+    themessenger->subscribe(ChannelId::MEDIA_AUDIO, std::make_shared<ReceiveSubscription>(strand,
+                            std::bind(&ReceivePromiseHandlerMock::onResolve, &receivePromiseHandlerMock_, std::placeholders::_1),
+                            std::bind(&ReceivePromiseHandlerMock::onReject, &receivePromiseHandlerMock_, std::placeholders::_1)));
+
+    IMessageInStream::ErrorHandler loopErrorHandler;
+    EXPECT_CALL(messageInStreamMock_, startReceiveLoop(_, _)).WillOnce(SaveArg<1>(&loopErrorHandler));
+
+    ioService_.run();
+    ioService_.reset();
+
+    const error::Error e(error::ErrorCode::USB_TRANSFER, 29);
+    EXPECT_CALL(receivePromiseHandlerMock_, onReject(e));
+    EXPECT_CALL(receivePromiseHandlerMock_, onResolve(_)).Times(0);
+
+    loopErrorHandler(e);
+    ioService_.run();
+}
+
+BOOST_FIXTURE_TEST_CASE(Messenger_DeliverToReceiveRing, MessengerUnitTest)
+{
+    Messenger::Pointer themessenger(std::make_shared<Messenger>(ioService_, messageInStream_, messageOutStream_));
+    auto ring = std::make_shared<ReceiveRing>();
+    themessenger->subscribe(ChannelId::VIDEO, ring);
+
+    IMessageInStream::MessageHandler loopMessageHandler;
+    EXPECT_CALL(messageInStreamMock_, startReceiveLoop(_, _)).WillOnce(SaveArg<0>(&loopMessageHandler));
+
+    ioService_.run();
+    ioService_.reset();
+
+    Message::Pointer firstMessage(std::make_shared<Message>(ChannelId::VIDEO, EncryptionType::ENCRYPTED, MessageType::SPECIFIC));
+    loopMessageHandler(firstMessage);
+
+    Message::Pointer secondMessage(std::make_shared<Message>(ChannelId::VIDEO, EncryptionType::ENCRYPTED, MessageType::SPECIFIC));
+    loopMessageHandler(secondMessage);
+
+    Message::Pointer message;
+    BOOST_CHECK(ring->pop(message));
+    BOOST_CHECK(message == firstMessage);
+    BOOST_CHECK(ring->pop(message));
+    BOOST_CHECK(message == secondMessage);
+    BOOST_CHECK(!ring->pop(message));
+}
+
+BOOST_FIXTURE_TEST_CASE(Messenger_LoopDeliversMessagesReceivedBeforeSubscription, MessengerUnitTest)
+{
+    Messenger::Pointer themessenger(std::make_shared<Messenger>(ioService_, messageInStream_, messageOutStream_));
+    boost::asio::io_service::strand strand(ioService_);
+    themessenger->subscribe(ChannelId::VIDEO, std::make_shared<ReceiveSubscription>(strand,
+                            std::bind(&ReceivePromiseHandlerMock::onResolve, &receivePromiseHandlerMock_, std::placeholders::_1),
+                            std::bind(&ReceivePromiseHandlerMock::onReject, &receivePromiseHandlerMock_, std::placeholders::_1)));
+
+    IMessageInStream::MessageHandler loopMessageHandler;
+    EXPECT_CALL(messageInStreamMock_, startReceiveLoop(_, _)).WillOnce(SaveArg<0>(&loopMessageHandler));
+
+    ioService_.run();
+    ioService_.reset();
+
+    ReceivePromiseHandlerMock subscriptionHandlerMock;
+    themessenger->subscribe(ChannelId::MEDIA_AUDIO, std::make_shared<ReceiveSubscription>(strand,
+                            std::bind(&ReceivePromiseHandlerMock::onResolve, &subscriptionHandlerMock, std::placeholders::_1),
+                            std::bind(&ReceivePromiseHandlerMock::onReject, &subscriptionHandlerMock, std::placeholders::_1)));
+
+    // Both messages arrive before the subscription is registered on the receive strand.
+    Message::Pointer firstMessage(std::make_shared<Message>(ChannelId::MEDIA_AUDIO, EncryptionType::ENCRYPTED, MessageType::SPECIFIC));
+    Message::Pointer secondMessage(std::make_shared<Message>(ChannelId::MEDIA_AUDIO, EncryptionType::ENCRYPTED, MessageType::SPECIFIC));
+    loopMessageHandler(firstMessage);
+    loopMessageHandler(secondMessage);
+
+    ::testing::InSequence sequence;
+    EXPECT_CALL(subscriptionHandlerMock, onResolve(firstMessage));
+    EXPECT_CALL(subscriptionHandlerMock, onResolve(secondMessage));
+    ioService_.run();
+}
+
+BOOST_FIXTURE_TEST_CASE(Messenger_StopEndsReceiveLoop, MessengerUnitTest)
+{
+    Messenger::Pointer themessenger(std::make_shared<Messenger>(ioService_, messageInStream_, messageOutStream_));
+    boost::asio::io_service::strand strand(ioService_);
+    themessenger->subscribe(ChannelId::VIDEO, std::make_shared<ReceiveSubscription>(strand,
+                            std::bind(&ReceivePromiseHandlerMock::onResolve, &receivePromiseHandlerMock_, std::placeholders::_1),
+                            std::bind(&ReceivePromiseHandlerMock::onReject, &receivePromiseHandlerMock_, std::placeholders::_1)));
+
+    EXPECT_CALL(messageInStreamMock_, startReceiveLoop(_, _));
+    ioService_.run();
+    ioService_.reset();
+
+    EXPECT_CALL(messageInStreamMock_, stopReceiveLoop());
+    themessenger->stop();
+    ioService_.run();
+    ioService_.reset();
+
+    // A later subscription starts a new loop.
+    EXPECT_CALL(messageInStreamMock_, startReceiveLoop(_, _));
+    themessenger->subscribe(ChannelId::VIDEO, std::make_shared<ReceiveSubscription>(strand,
+                            std::bind(&ReceivePromiseHandlerMock::onResolve, &receivePromiseHandlerMock_, std::placeholders::_1),
+                            std::bind(&ReceivePromiseHandlerMock::onReject, &receivePromiseHandlerMock_, std::placeholders::_1)));
+    ioService_.run();
+}
+
 }
 }
 }
@@ -0,0 +1,149 @@
+/*
+*  This file is part of aasdk library project.
+*  Copyright (C) 2018 f1x.studio (Michal Szwaj)
+*
+*  aasdk is free software: you can redistribute it and/or modify
+*  it under the terms of the GNU General Public License as published by
+*  the Free Software Foundation; either version 3 of the License, or
+*  (at your option) any later version.
+
+*  aasdk is distributed in the hope that it will be useful,
+*  but WITHOUT ANY WARRANTY; without even the implied warranty of
+*  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+*  GNU General Public License for more details.
+*
+*  You should have received a copy of the GNU General Public License
+*  along with aasdk. If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include <f1x/aasdk/Messenger/ReceiveRing.hpp>
+
+namespace f1x
+{
+namespace aasdk
+{
+namespace messenger
+{
+
+ReceiveRing::ReceiveRing(size_t capacity)
+    : ring_(capacity)
+    , hasOverflow_(false)
+    , overflowCount_(0)
+    , isCancelled_(false)
+    , isWaiting_(false)
+{
+
+}
+
+void ReceiveRing::deliver(Message::Pointer message)
+{
+    if(isCancelled_)
+    {
+        return;
+    }
+
+    if(hasOverflow_ || !ring_.push(message))
+    {
+        std::lock_guard<decltype(mutex_)> lock(mutex_);
+
+        // Once the ring has overflowed every message goes through overflow_ until
+        // the consumer drains it, otherwise newer messages could overtake older ones.
+        if(hasOverflow_ || !ring_.push(message))
+        {
+            overflow_.push_back(std::move(message));
+            hasOverflow_ = true;
+            ++overflowCount_;
+        }
+    }
+
+    this->notify();
+}
+
+void ReceiveRing::fail(const error::Error& e)
+{
+    std::lock_guard<decltype(mutex_)> lock(mutex_);
+    error_ = e;
+    isCancelled_ = true;
+    condition_.notify_all();
+}
+
+void ReceiveRing::cancel()
+{
+    std::lock_guard<decltype(mutex_)> lock(mutex_);
+    isCancelled_ = true;
+    condition_.notify_all();
+}
+
+bool ReceiveRing::isCancelled() const
+{
+    return isCancelled_;
+}
+
+bool ReceiveRing::pop(Message::Pointer& message)
+{
+    return ring_.pop(message) || (hasOverflow_ && this->popOverflow(message));
+}
+
+bool ReceiveRing::pop(Message::Pointer& message, std::chrono::milliseconds timeout)
+{
+    if(this->pop(message))
+    {
+        return true;
+    }
+
+    {
+        std::unique_lock<decltype(mutex_)> lock(mutex_);
+        isWaiting_ = true;
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+
+        condition_.wait_for(lock, timeout, [this]() { return isCancelled_ || hasOverflow_ || !ring_.empty(); });
+        isWaiting_ = false;
+    }
+
+    return this->pop(message);
+}
+
+error::Error ReceiveRing::getError() const
+{
+    std::lock_guard<decltype(mutex_)> lock(mutex_);
+    return error_;
+}
+
+size_t ReceiveRing::getOverflowCount() const
+{
+    return overflowCount_;
+}
+
+bool ReceiveRing::popOverflow(Message::Pointer& message)
+{
+    std::lock_guard<decltype(mutex_)> lock(mutex_);
+
+    if(ring_.pop(message))
+    {
+        return true;
+    }
+    else if(overflow_.empty())
+    {
+        return false;
+    }
+
+    message = std::move(overflow_.front());
+    overflow_.pop_front();
+    hasOverflow_ = !overflow_.empty();
+    return true;
+}
+
+void ReceiveRing::notify()
+{
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+
+    if(isWaiting_)
+    {
+        std::lock_guard<decltype(mutex_)> lock(mutex_);
+        condition_.notify_one();
+    }
+}
+
+}
+}
+}
@@ -0,0 +1,104 @@
+/*
+*  This file is part of aasdk library project.
+*  Copyright (C) 2018 f1x.studio (Michal Szwaj)
+*
+*  aasdk is free software: you can redistribute it and/or modify
+*  it under the terms of the GNU General Public License as published by
+*  the Free Software Foundation; either version 3 of the License, or
+*  (at your option) any later version.
+
+*  aasdk is distributed in the hope that it will be useful,
+*  but WITHOUT ANY WARRANTY; without even the implied warranty of
+*  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+*  GNU General Public License for more details.
+*
+*  You should have received a copy of the GNU General Public License
+*  along with aasdk. If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include <thread>
+#include <boost/test/unit_test.hpp>
+#include <f1x/aasdk/Messenger/ReceiveRing.hpp>
+
+namespace f1x
+{
+namespace aasdk
+{
+namespace messenger
+{
+namespace ut
+{
+
+Message::Pointer createRingMessage()
+{
+    return std::make_shared<Message>(ChannelId::VIDEO, EncryptionType::ENCRYPTED, MessageType::SPECIFIC);
+}
+
+BOOST_AUTO_TEST_CASE(ReceiveRing_KeepOrderOnOverflow)
+{
+    ReceiveRing ring(2);
+    std::vector<Message::Pointer> messages;
+
+    for(size_t i = 0; i < 5; ++i)
+    {
+        messages.push_back(createRingMessage());
+        ring.deliver(messages.back());
+    }
+
+    BOOST_CHECK_EQUAL(ring.getOverflowCount(), 3u);
+
+    Message::Pointer message;
+    BOOST_CHECK(ring.pop(message));
+    BOOST_CHECK(message == messages[0]);
+
+    ring.deliver(createRingMessage());
+    BOOST_CHECK_EQUAL(ring.getOverflowCount(), 4u);
+
+    for(size_t i = 1; i < messages.size(); ++i)
+    {
+        BOOST_CHECK(ring.pop(message));
+        BOOST_CHECK(message == messages[i]);
+    }
+
+    BOOST_CHECK(ring.pop(message));
+    BOOST_CHECK(!ring.pop(message));
+}
+
+BOOST_AUTO_TEST_CASE(ReceiveRing_WakeWaitingConsumer)
+{
+    ReceiveRing ring;
+    auto expectedMessage = createRingMessage();
+    Message::Pointer message;
+    bool result = false;
+
+    std::thread consumer([&]() { result = ring.pop(message, std::chrono::milliseconds(10000)); });
+    std::this_thread::sleep_for(std::chrono::milliseconds(10));
+
+    const auto begin = std::chrono::steady_clock::now();
+    ring.deliver(expectedMessage);
+    consumer.join();
+
+    BOOST_CHECK(result);
+    BOOST_CHECK(message == expectedMessage);
+    BOOST_CHECK(std::chrono::steady_clock::now() - begin < std::chrono::seconds(5));
+}
+
+BOOST_AUTO_TEST_CASE(ReceiveRing_ReportFailure)
+{
+    ReceiveRing ring;
+    const error::Error e(error::ErrorCode::USB_TRANSFER, 5);
+    ring.fail(e);
+
+    Message::Pointer message;
+    BOOST_CHECK(ring.isCancelled());
+    BOOST_CHECK(!ring.pop(message, std::chrono::milliseconds(10000)));
+    BOOST_CHECK(ring.getError() == e);
+
+    ring.deliver(createRingMessage());
+    BOOST_CHECK(!ring.pop(message));
+}
+
+}
+}
+}
+}
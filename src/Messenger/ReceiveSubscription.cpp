@@ -0,0 +1,102 @@
+/*
+*  This file is part of aasdk library project.
+*  Copyright (C) 2018 f1x.studio (Michal Szwaj)
+*
+*  aasdk is free software: you can redistribute it and/or modify
+*  it under the terms of the GNU General Public License as published by
+*  the Free Software Foundation; either version 3 of the License, or
+*  (at your option) any later version.
+
+*  aasdk is distributed in the hope that it will be useful,
+*  but WITHOUT ANY WARRANTY; without even the implied warranty of
+*  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+*  GNU General Public License for more details.
+*
+*  You should have received a copy of the GNU General Public License
+*  along with aasdk. If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include <f1x/aasdk/Messenger/ReceiveSubscription.hpp>
+
+namespace f1x
+{
+namespace aasdk
+{
+namespace messenger
+{
+
+template<typename StrandType>
+BasicReceiveSubscription<StrandType>::BasicReceiveSubscription(StrandType strand, MessageHandler messageHandler, ErrorHandler errorHandler)
+    : strand_(std::forward<StrandType>(strand))
+    , messageHandler_(std::move(messageHandler))
+    , errorHandler_(std::move(errorHandler))
+    , isCancelled_(false)
+{
+
+}
+
+template<typename StrandType>
+template<typename HandlerType>
+void BasicReceiveSubscription<StrandType>::post(boost::asio::io_service::strand& strand, HandlerType&& handler)
+{
+    strand.post(std::forward<HandlerType>(handler));
+}
+
+template<typename StrandType>
+template<typename HandlerType>
+void BasicReceiveSubscription<StrandType>::post(const io::WorkStealingExecutor::Strand::Pointer& strand, HandlerType&& handler)
+{
+    strand->post(std::forward<HandlerType>(handler));
+}
+
+template<typename StrandType>
+void BasicReceiveSubscription<StrandType>::deliver(Message::Pointer message)
+{
+    post(strand_, [this, self = this->shared_from_this(), message = std::move(message)]() mutable {
+        if(!isCancelled_)
+        {
+            messageHandler_(std::move(message));
+        }
+    });
+}
+
+template<typename StrandType>
+void BasicReceiveSubscription<StrandType>::fail(const error::Error& e)
+{
+    if(!isCancelled_.exchange(true))
+    {
+        post(strand_, [this, self = this->shared_from_this(), e]() {
+            auto errorHandler(std::move(errorHandler_));
+            messageHandler_ = nullptr;
+            errorHandler_ = nullptr;
+            errorHandler(e);
+        });
+    }
+}
+
+template<typename StrandType>
+void BasicReceiveSubscription<StrandType>::cancel()
+{
+    if(!isCancelled_.exchange(true))
+    {
+        // Handlers usually keep the channel alive, release them on the strand so that
+        // a subscription cancelled from inside its own message handler stays valid.
+        post(strand_, [this, self = this->shared_from_this()]() {
+            messageHandler_ = nullptr;
+            errorHandler_ = nullptr;
+        });
+    }
+}
+
+template<typename StrandType>
+bool BasicReceiveSubscription<StrandType>::isCancelled() const
+{
+    return isCancelled_;
+}
+
+template class BasicReceiveSubscription<boost::asio::io_service::strand&>;
+template class BasicReceiveSubscription<io::WorkStealingExecutor::Strand::Pointer>;
+
+}
+}
+}
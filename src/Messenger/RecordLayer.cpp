@@ -0,0 +1,332 @@
+/*
+*  This file is part of aasdk library project.
+*  Copyright (C) 2018 f1x.studio (Michal Szwaj)
+*
+*  aasdk is free software: you can redistribute it and/or modify
+*  it under the terms of the GNU General Public License as published by
+*  the Free Software Foundation; either version 3 of the License, or
+*  (at your option) any later version.
+
+*  aasdk is distributed in the hope that it will be useful,
+*  but WITHOUT ANY WARRANTY; without even the implied warranty of
+*  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+*  GNU General Public License for more details.
+*
+*  You should have received a copy of the GNU General Public License
+*  along with aasdk. If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include <algorithm>
+#include <new>
+#include <f1x/aasdk/Messenger/RecordLayer.hpp>
+
+namespace f1x
+{
+namespace aasdk
+{
+namespace messenger
+{
+
+RecordLayer::RecordLayer(const transport::SSLTrafficKeys& trafficKeys, uint64_t writeSequenceNumber, uint64_t readSequenceNumber)
+    : encryptContext_(EVP_CIPHER_CTX_new())
+    , decryptContext_(EVP_CIPHER_CTX_new())
+    , cipher_(trafficKeys.cipher)
+    , readKey_(trafficKeys.serverKey)
+    , writeIV_(trafficKeys.clientIV)
+    , readIV_(trafficKeys.serverIV)
+    , version_(trafficKeys.version)
+    , writeSequenceNumber_(writeSequenceNumber)
+    , readSequenceNumber_(readSequenceNumber)
+{
+    const bool initialized = encryptContext_ != nullptr && decryptContext_ != nullptr
+            && EVP_EncryptInit_ex(encryptContext_, trafficKeys.cipher, nullptr, nullptr, nullptr) == 1
+            && EVP_CIPHER_CTX_ctrl(encryptContext_, EVP_CTRL_GCM_SET_IVLEN, cNonceSize, nullptr) == 1
+            && EVP_EncryptInit_ex(encryptContext_, nullptr, nullptr, trafficKeys.clientKey.data(), nullptr) == 1
+            && EVP_DecryptInit_ex(decryptContext_, trafficKeys.cipher, nullptr, nullptr, nullptr) == 1
+            && EVP_CIPHER_CTX_ctrl(decryptContext_, EVP_CTRL_GCM_SET_IVLEN, cNonceSize, nullptr) == 1
+            && EVP_DecryptInit_ex(decryptContext_, nullptr, nullptr, trafficKeys.serverKey.data(), nullptr) == 1;
+
+    if(!initialized)
+    {
+        EVP_CIPHER_CTX_free(encryptContext_);
+        EVP_CIPHER_CTX_free(decryptContext_);
+        throw error::Error(error::ErrorCode::SSL_CONTEXT_CREATION);
+    }
+}
+
+RecordLayer::~RecordLayer()
+{
+    EVP_CIPHER_CTX_free(encryptContext_);
+    EVP_CIPHER_CTX_free(decryptContext_);
+
+    for(auto context : decryptContexts_)
+    {
+        EVP_CIPHER_CTX_free(context);
+    }
+
+    OPENSSL_cleanse(readKey_.data(), readKey_.size());
+    OPENSSL_cleanse(writeIV_.data(), writeIV_.size());
+    OPENSSL_cleanse(readIV_.data(), readIV_.size());
+}
+
+size_t RecordLayer::encrypt(common::Data& output, const common::DataConstBuffer& buffer, error::Error& e) noexcept
+{
+    const size_t recordsCount = (buffer.size + cMaxPlaintextSize - 1) / cMaxPlaintextSize;
+    const size_t beginOffset = output.size();
+
+    try
+    {
+        output.resize(beginOffset + buffer.size + recordsCount * cOverheadSize);
+    }
+    catch(const std::bad_alloc&)
+    {
+        e = error::Error(error::ErrorCode::SSL_WRITE);
+        return 0;
+    }
+
+    size_t recordOffset = beginOffset;
+
+    for(size_t offset = 0; offset < buffer.size; offset += cMaxPlaintextSize)
+    {
+        const common::DataConstBuffer plaintext(buffer.cdata + offset, std::min(buffer.size - offset, cMaxPlaintextSize));
+
+        if(!this->encryptRecord(&output[recordOffset], plaintext))
+        {
+            output.resize(recordOffset);
+            e = error::Error(error::ErrorCode::SSL_WRITE);
+            return recordOffset - beginOffset;
+        }
+
+        recordOffset += plaintext.size + cOverheadSize;
+    }
+
+    return output.size() - beginOffset;
+}
+
+size_t RecordLayer::decrypt(common::Data& output, const common::DataConstBuffer& buffer, error::Error& e) noexcept
+{
+    uint64_t sequenceNumber = 0;
+    const auto plaintextSize = this->reserveDecrypt(buffer, sequenceNumber, e);
+
+    if(e != error::ErrorCode::NONE)
+    {
+        return 0;
+    }
+
+    const size_t beginOffset = output.size();
+
+    try
+    {
+        output.resize(beginOffset + plaintextSize);
+    }
+    catch(const std::bad_alloc&)
+    {
+        e = error::Error(error::ErrorCode::SSL_READ);
+        return 0;
+    }
+
+    if(!this->decryptRecords(decryptContext_, output.data() + beginOffset, buffer, sequenceNumber))
+    {
+        output.resize(beginOffset);
+        e = error::Error(error::ErrorCode::SSL_READ);
+        return 0;
+    }
+
+    return plaintextSize;
+}
+
+size_t RecordLayer::reserveDecrypt(const common::DataConstBuffer& buffer, uint64_t& sequenceNumber, error::Error& e) noexcept
+{
+    size_t plaintextSize = 0;
+    size_t recordsCount = 0;
+
+    for(size_t offset = 0; offset < buffer.size;)
+    {
+        const auto recordSize = this->getRecordSize(buffer, offset);
+
+        if(recordSize == 0)
+        {
+            e = error::Error(error::ErrorCode::SSL_READ);
+            return 0;
+        }
+
+        plaintextSize += recordSize - cOverheadSize;
+        offset += recordSize;
+        ++recordsCount;
+    }
+
+    sequenceNumber = readSequenceNumber_;
+    readSequenceNumber_ += recordsCount;
+    return plaintextSize;
+}
+
+void RecordLayer::decrypt(uint8_t* output, const common::DataConstBuffer& buffer, uint64_t sequenceNumber, error::Error& e) const noexcept
+{
+    auto context = this->acquireDecryptContext();
+
+    if(context == nullptr || !this->decryptRecords(context, output, buffer, sequenceNumber))
+    {
+        e = error::Error(error::ErrorCode::SSL_READ);
+    }
+
+    this->releaseDecryptContext(context);
+}
+
+EVP_CIPHER_CTX* RecordLayer::acquireDecryptContext() const noexcept
+{
+    {
+        std::lock_guard<std::mutex> lock(decryptContextsMutex_);
+
+        if(!decryptContexts_.empty())
+        {
+            auto context = decryptContexts_.back();
+            decryptContexts_.pop_back();
+            return context;
+        }
+    }
+
+    // Keyed once and kept for the next task, so a worker only sets the nonce per record.
+    auto context = EVP_CIPHER_CTX_new();
+
+    if(context == nullptr
+        || EVP_DecryptInit_ex(context, cipher_, nullptr, nullptr, nullptr) != 1
+        || EVP_CIPHER_CTX_ctrl(context, EVP_CTRL_GCM_SET_IVLEN, cNonceSize, nullptr) != 1
+        || EVP_DecryptInit_ex(context, nullptr, nullptr, readKey_.data(), nullptr) != 1)
+    {
+        EVP_CIPHER_CTX_free(context);
+        return nullptr;
+    }
+
+    return context;
+}
+
+void RecordLayer::releaseDecryptContext(EVP_CIPHER_CTX* context) const noexcept
+{
+    if(context == nullptr)
+    {
+        return;
+    }
+
+    try
+    {
+        std::lock_guard<std::mutex> lock(decryptContextsMutex_);
+        decryptContexts_.push_back(context);
+    }
+    catch(const std::exception&)
+    {
+        EVP_CIPHER_CTX_free(context);
+    }
+}
+
+bool RecordLayer::encryptRecord(uint8_t* record, const common::DataConstBuffer& buffer) noexcept
+{
+    const size_t length = cExplicitNonceSize + buffer.size + cTagSize;
+    record[0] = cApplicationDataContentType;
+    record[1] = static_cast<uint8_t>(version_ >> 8);
+    record[2] = static_cast<uint8_t>(version_);
+    record[3] = static_cast<uint8_t>(length >> 8);
+    record[4] = static_cast<uint8_t>(length);
+
+    uint8_t* explicitNonce = record + cHeaderSize;
+    for(size_t i = 0; i < cExplicitNonceSize; ++i)
+    {
+        explicitNonce[i] = static_cast<uint8_t>(writeSequenceNumber_ >> (8 * (cExplicitNonceSize - 1 - i)));
+    }
+
+    uint8_t nonce[cNonceSize];
+    this->setNonce(nonce, writeIV_, explicitNonce);
+
+    uint8_t additionalData[cAdditionalDataSize];
+    this->setAdditionalData(additionalData, writeSequenceNumber_, cApplicationDataContentType, buffer.size);
+
+    uint8_t* ciphertext = explicitNonce + cExplicitNonceSize;
+    int size = 0;
+
+    if(EVP_EncryptInit_ex(encryptContext_, nullptr, nullptr, nullptr, nonce) != 1
+        || EVP_EncryptUpdate(encryptContext_, nullptr, &size, additionalData, cAdditionalDataSize) != 1
+        || EVP_EncryptUpdate(encryptContext_, ciphertext, &size, buffer.cdata, buffer.size) != 1
+        || EVP_EncryptFinal_ex(encryptContext_, ciphertext + size, &size) != 1
+        || EVP_CIPHER_CTX_ctrl(encryptContext_, EVP_CTRL_GCM_GET_TAG, cTagSize, ciphertext + buffer.size) != 1)
+    {
+        return false;
+    }
+
+    ++writeSequenceNumber_;
+    return true;
+}
+
+bool RecordLayer::decryptRecords(EVP_CIPHER_CTX* context, uint8_t* output, const common::DataConstBuffer& buffer, uint64_t sequenceNumber) const noexcept
+{
+    size_t offset = 0;
+
+    while(offset < buffer.size)
+    {
+        const auto recordSize = this->getRecordSize(buffer, offset);
+
+        if(recordSize == 0 || !this->decryptRecord(context, output, common::DataConstBuffer(buffer.cdata + offset, recordSize), sequenceNumber++))
+        {
+            return false;
+        }
+
+        output += recordSize - cOverheadSize;
+        offset += recordSize;
+    }
+
+    return true;
+}
+
+bool RecordLayer::decryptRecord(EVP_CIPHER_CTX* context, uint8_t* output, const common::DataConstBuffer& record, uint64_t sequenceNumber) const noexcept
+{
+    const size_t plaintextSize = record.size - cOverheadSize;
+    const uint8_t* explicitNonce = record.cdata + cHeaderSize;
+    const uint8_t* ciphertext = explicitNonce + cExplicitNonceSize;
+
+    uint8_t nonce[cNonceSize];
+    this->setNonce(nonce, readIV_, explicitNonce);
+
+    uint8_t additionalData[cAdditionalDataSize];
+    this->setAdditionalData(additionalData, sequenceNumber, record.cdata[0], plaintextSize);
+
+    int size = 0;
+
+    return EVP_DecryptInit_ex(context, nullptr, nullptr, nullptr, nonce) == 1
+        && EVP_DecryptUpdate(context, nullptr, &size, additionalData, cAdditionalDataSize) == 1
+        && EVP_DecryptUpdate(context, output, &size, ciphertext, plaintextSize) == 1
+        && EVP_CIPHER_CTX_ctrl(context, EVP_CTRL_GCM_SET_TAG, cTagSize, const_cast<uint8_t*>(ciphertext + plaintextSize)) == 1
+        && EVP_DecryptFinal_ex(context, output + size, &size) == 1;
+}
+
+size_t RecordLayer::getRecordSize(const common::DataConstBuffer& buffer, size_t offset) const noexcept
+{
+    if(buffer.size - offset < cHeaderSize || buffer.cdata[offset] != cApplicationDataContentType)
+    {
+        return 0;
+    }
+
+    const size_t recordSize = cHeaderSize + ((static_cast<size_t>(buffer.cdata[offset + 3]) << 8) | buffer.cdata[offset + 4]);
+    return recordSize < cOverheadSize || buffer.size - offset < recordSize ? 0 : recordSize;
+}
+
+void RecordLayer::setNonce(uint8_t* nonce, const common::Data& fixedIV, const uint8_t* explicitNonce) const
+{
+    std::copy(fixedIV.begin(), fixedIV.end(), nonce);
+    std::copy(explicitNonce, explicitNonce + cExplicitNonceSize, nonce + fixedIV.size());
+}
+
+void RecordLayer::setAdditionalData(uint8_t* additionalData, uint64_t sequenceNumber, uint8_t contentType, size_t size) const
+{
+    for(size_t i = 0; i < 8; ++i)
+    {
+        additionalData[i] = static_cast<uint8_t>(sequenceNumber >> (8 * (7 - i)));
+    }
+
+    additionalData[8] = contentType;
+    additionalData[9] = static_cast<uint8_t>(version_ >> 8);
+    additionalData[10] = static_cast<uint8_t>(version_);
+    additionalData[11] = static_cast<uint8_t>(size >> 8);
+    additionalData[12] = static_cast<uint8_t>(size);
+}
+
+}
+}
+}
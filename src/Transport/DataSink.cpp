@@ -18,7 +18,6 @@
 
 #include <cstring>
 #include <f1x/aasdk/Transport/DataSink.hpp>
-#include <f1x/aasdk/Error/Error.hpp>
 
 namespace f1x
 {
@@ -42,10 +41,22 @@ common::DataBuffer DataSink::fill()
 }
 
 void DataSink::commit(common::Data::size_type size)
+{
+    error::Error e;
+    this->commit(size, e);
+
+    if(e != error::ErrorCode::NONE)
+    {
+        throw e;
+    }
+}
+
+void DataSink::commit(common::Data::size_type size, error::Error& e) noexcept
 {
     if(size > cChunkSize)
     {
-        throw error::Error(error::ErrorCode::DATA_SINK_COMMIT_OVERFLOW);
+        e = error::Error(error::ErrorCode::DATA_SINK_COMMIT_OVERFLOW);
+        return;
     }
 
     data_.erase_end((cChunkSize - size));
@@ -57,14 +68,27 @@ common::Data::size_type DataSink::getAvailableSize()
 }
 
 common::Data DataSink::consume(common::Data::size_type size)
+{
+    error::Error e;
+    auto data(this->consume(size, e));
+
+    if(e != error::ErrorCode::NONE)
+    {
+        throw e;
+    }
+
+    return data;
+}
+
+common::Data DataSink::consume(common::Data::size_type size, error::Error& e)
 {
     if(size > data_.size())
     {
-        throw error::Error(error::ErrorCode::DATA_SINK_CONSUME_UNDERFLOW);
+        e = error::Error(error::ErrorCode::DATA_SINK_CONSUME_UNDERFLOW);
+        return common::Data();
     }
 
-    common::Data data(size, 0);
-    std::copy(data_.begin(), data_.begin() + size, data.begin());
+    common::Data data(data_.begin(), data_.begin() + size);
     data_.erase_begin(size);
 
     return data;
@@ -0,0 +1,152 @@
+/*
+*  This file is part of aasdk library project.
+*  Copyright (C) 2018 f1x.studio (Michal Szwaj)
+*
+*  aasdk is free software: you can redistribute it and/or modify
+*  it under the terms of the GNU General Public License as published by
+*  the Free Software Foundation; either version 3 of the License, or
+*  (at your option) any later version.
+
+*  aasdk is distributed in the hope that it will be useful,
+*  but WITHOUT ANY WARRANTY; without even the implied warranty of
+*  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+*  GNU General Public License for more details.
+*
+*  You should have received a copy of the GNU General Public License
+*  along with aasdk. If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include <algorithm>
+#include <cstring>
+#include <new>
+#include <f1x/aasdk/Transport/SSLOutputBIO.hpp>
+
+namespace f1x
+{
+namespace aasdk
+{
+namespace transport
+{
+
+SSLOutputBIO::SSLOutputBIO()
+    : pendingOffset_(0)
+    , output_(nullptr)
+{
+
+}
+
+BIO* SSLOutputBIO::create()
+{
+#if (OPENSSL_VERSION_NUMBER >= 0x10100000L)
+    return BIO_new(getMethod());
+#else
+    return BIO_new(BIO_s_mem());
+#endif
+}
+
+void SSLOutputBIO::setOutput(BIO* bio, common::Data* output)
+{
+#if (OPENSSL_VERSION_NUMBER >= 0x10100000L)
+    static_cast<SSLOutputBIO*>(BIO_get_data(bio))->output_ = output;
+#else
+    (void)bio;
+    (void)output;
+#endif
+}
+
+#if (OPENSSL_VERSION_NUMBER >= 0x10100000L)
+BIO_METHOD* SSLOutputBIO::getMethod()
+{
+    static BIO_METHOD* method = []() {
+        auto method = BIO_meth_new(BIO_get_new_index() | BIO_TYPE_SOURCE_SINK, "aasdk output");
+        BIO_meth_set_create(method, &SSLOutputBIO::onCreate);
+        BIO_meth_set_destroy(method, &SSLOutputBIO::onDestroy);
+        BIO_meth_set_write(method, &SSLOutputBIO::onWrite);
+        BIO_meth_set_read(method, &SSLOutputBIO::onRead);
+        BIO_meth_set_ctrl(method, &SSLOutputBIO::onCtrl);
+        return method;
+    }();
+
+    return method;
+}
+
+int SSLOutputBIO::onCreate(BIO* bio)
+{
+    BIO_set_data(bio, new SSLOutputBIO());
+    BIO_set_init(bio, 1);
+    return 1;
+}
+
+int SSLOutputBIO::onDestroy(BIO* bio)
+{
+    delete static_cast<SSLOutputBIO*>(BIO_get_data(bio));
+    BIO_set_data(bio, nullptr);
+    return 1;
+}
+
+int SSLOutputBIO::onWrite(BIO* bio, const char* data, int size)
+{
+    auto self = static_cast<SSLOutputBIO*>(BIO_get_data(bio));
+    auto& output = self->output_ != nullptr ? *self->output_ : self->pending_;
+    const auto begin = reinterpret_cast<const uint8_t*>(data);
+
+    try
+    {
+        output.insert(output.end(), begin, begin + size);
+    }
+    catch(const std::bad_alloc&)
+    {
+        return -1;
+    }
+
+    return size;
+}
+
+int SSLOutputBIO::onRead(BIO* bio, char* data, int size)
+{
+    auto self = static_cast<SSLOutputBIO*>(BIO_get_data(bio));
+    const auto readSize = std::min<size_t>(size, self->pending_.size() - self->pendingOffset_);
+
+    if(readSize == 0)
+    {
+        BIO_set_retry_read(bio);
+        return -1;
+    }
+
+    memcpy(data, &self->pending_[self->pendingOffset_], readSize);
+    self->pendingOffset_ += readSize;
+
+    if(self->pendingOffset_ == self->pending_.size())
+    {
+        self->pending_.clear();
+        self->pendingOffset_ = 0;
+    }
+
+    return readSize;
+}
+
+long SSLOutputBIO::onCtrl(BIO* bio, int command, long, void*)
+{
+    auto self = static_cast<SSLOutputBIO*>(BIO_get_data(bio));
+
+    switch(command)
+    {
+    case BIO_CTRL_PENDING:
+        return self->pending_.size() - self->pendingOffset_;
+    case BIO_CTRL_WPENDING:
+        return 0;
+    case BIO_CTRL_FLUSH:
+        return 1;
+    case BIO_CTRL_RESET:
+        self->pending_.clear();
+        self->pendingOffset_ = 0;
+        return 1;
+    default:
+        return 0;
+    }
+}
+#endif
+
+}
+}
+}
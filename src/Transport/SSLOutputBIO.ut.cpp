@@ -0,0 +1,74 @@
+/*
+*  This file is part of aasdk library project.
+*  Copyright (C) 2018 f1x.studio (Michal Szwaj)
+*
+*  aasdk is free software: you can redistribute it and/or modify
+*  it under the terms of the GNU General Public License as published by
+*  the Free Software Foundation; either version 3 of the License, or
+*  (at your option) any later version.
+
+*  aasdk is distributed in the hope that it will be useful,
+*  but WITHOUT ANY WARRANTY; without even the implied warranty of
+*  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+*  GNU General Public License for more details.
+*
+*  You should have received a copy of the GNU General Public License
+*  along with aasdk. If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include <boost/test/unit_test.hpp>
+#include <f1x/aasdk/Transport/SSLOutputBIO.hpp>
+
+namespace f1x
+{
+namespace aasdk
+{
+namespace transport
+{
+namespace ut
+{
+
+BOOST_AUTO_TEST_CASE(SSLOutputBIO_BufferPendingData)
+{
+    auto bio = SSLOutputBIO::create();
+    const common::Data data{0x01, 0x02, 0x03, 0x04, 0x05};
+
+    BOOST_CHECK_EQUAL(BIO_write(bio, data.data(), data.size()), data.size());
+    BOOST_CHECK_EQUAL(BIO_ctrl_pending(bio), data.size());
+
+    common::Data output(3);
+    BOOST_CHECK_EQUAL(BIO_read(bio, output.data(), output.size()), 3);
+    BOOST_CHECK(output == common::Data(data.begin(), data.begin() + 3));
+    BOOST_CHECK_EQUAL(BIO_ctrl_pending(bio), 2);
+
+    BOOST_CHECK_EQUAL(BIO_read(bio, output.data(), output.size()), 2);
+    BOOST_CHECK_EQUAL(BIO_ctrl_pending(bio), 0);
+    BOOST_CHECK_LE(BIO_read(bio, output.data(), output.size()), 0);
+
+    BIO_free(bio);
+}
+
+BOOST_AUTO_TEST_CASE(SSLOutputBIO_WriteToOutput)
+{
+    auto bio = SSLOutputBIO::create();
+    const common::Data data{0x01, 0x02, 0x03, 0x04, 0x05};
+
+    common::Data output{0xAA};
+    SSLOutputBIO::setOutput(bio, &output);
+    BOOST_CHECK_EQUAL(BIO_write(bio, data.data(), data.size()), data.size());
+    SSLOutputBIO::setOutput(bio, nullptr);
+
+    BOOST_CHECK_EQUAL(BIO_ctrl_pending(bio), 0);
+    BOOST_CHECK(output == common::Data({0xAA, 0x01, 0x02, 0x03, 0x04, 0x05}));
+
+    BIO_write(bio, data.data(), data.size());
+    BOOST_CHECK_EQUAL(BIO_ctrl_pending(bio), data.size());
+    BOOST_CHECK_EQUAL(output.size(), data.size() + 1);
+
+    BIO_free(bio);
+}
+
+}
+}
+}
+}
@@ -0,0 +1,46 @@
+/*
+*  This file is part of aasdk library project.
+*  Copyright (C) 2018 f1x.studio (Michal Szwaj)
+*
+*  aasdk is free software: you can redistribute it and/or modify
+*  it under the terms of the GNU General Public License as published by
+*  the Free Software Foundation; either version 3 of the License, or
+*  (at your option) any later version.
+
+*  aasdk is distributed in the hope that it will be useful,
+*  but WITHOUT ANY WARRANTY; without even the implied warranty of
+*  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+*  GNU General Public License for more details.
+*
+*  You should have received a copy of the GNU General Public License
+*  along with aasdk. If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include <openssl/crypto.h>
+#include <f1x/aasdk/Transport/SSLTrafficKeys.hpp>
+
+namespace f1x
+{
+namespace aasdk
+{
+namespace transport
+{
+
+SSLTrafficKeys::SSLTrafficKeys()
+    : version(0)
+    , cipher(nullptr)
+{
+
+}
+
+SSLTrafficKeys::~SSLTrafficKeys()
+{
+    OPENSSL_cleanse(clientKey.data(), clientKey.size());
+    OPENSSL_cleanse(serverKey.data(), serverKey.size());
+    OPENSSL_cleanse(clientIV.data(), clientIV.size());
+    OPENSSL_cleanse(serverIV.data(), serverIV.size());
+}
+
+}
+}
+}
@@ -21,7 +21,17 @@
 #include <openssl/err.h>
 #include <openssl/ssl.h>
 #include <openssl/conf.h>
+#if (OPENSSL_VERSION_NUMBER >= 0x10101000L)
+#include <openssl/kdf.h>
+#endif
+#if defined(__x86_64__) || defined(__i386__)
+#include <cpuid.h>
+#elif (defined(__aarch64__) || defined(__arm__)) && defined(__linux__)
+#include <sys/auxv.h>
+#include <asm/hwcap.h>
+#endif
 #include <f1x/aasdk/Transport/SSLWrapper.hpp>
+#include <f1x/aasdk/Transport/SSLOutputBIO.hpp>
 
 namespace f1x
 {
@@ -106,7 +116,7 @@ bool SSLWrapper::checkPrivateKey(SSL* ssl)
 std::pair<BIO*, BIO*> SSLWrapper::createBIOs()
 {
     auto readBIO = BIO_new(BIO_s_mem());
-    auto writeBIO = BIO_new(BIO_s_mem());
+    auto writeBIO = SSLOutputBIO::create();
     return std::make_pair(readBIO, writeBIO);
 }
 
@@ -117,12 +127,22 @@ void SSLWrapper::setBIOs(SSL* ssl, const BIOs& bIOs, size_t maxBufferSize)
     BIO_set_write_buf_size(bIOs.second, maxBufferSize);
 }
 
+void SSLWrapper::setBIOOutput(BIO* bio, common::Data* output)
+{
+    SSLOutputBIO::setOutput(bio, output);
+}
+
 void SSLWrapper::setConnectState(SSL* ssl)
 {
     SSL_set_connect_state(ssl);
     SSL_set_verify(ssl, SSL_VERIFY_NONE, nullptr);
 }
 
+bool SSLWrapper::setCipherList(SSL* ssl, const std::string& cipherList)
+{
+    return SSL_set_cipher_list(ssl, cipherList.c_str()) == 1;
+}
+
 int SSLWrapper::doHandshake(SSL* ssl)
 {
     auto result = SSL_do_handshake(ssl);
@@ -156,6 +176,11 @@ void SSLWrapper::free(EVP_PKEY* privateKey)
     EVP_PKEY_free(privateKey);
 }
 
+void SSLWrapper::free(SSL_SESSION* session)
+{
+    SSL_SESSION_free(session);
+}
+
 size_t SSLWrapper::bioCtrlPending(BIO* b)
 {
     return BIO_ctrl_pending(b);
@@ -191,6 +216,128 @@ int SSLWrapper::getError(SSL* ssl, int returnCode)
     return SSL_get_error(ssl, returnCode);
 }
 
+bool SSLWrapper::getTrafficKeys(SSL* ssl, SSLTrafficKeys& trafficKeys)
+{
+#if (OPENSSL_VERSION_NUMBER >= 0x10101000L)
+    const auto cipher = SSL_get_current_cipher(ssl);
+
+    if(SSL_version(ssl) != TLS1_2_VERSION || cipher == nullptr)
+    {
+        return false;
+    }
+
+    switch(SSL_CIPHER_get_cipher_nid(cipher))
+    {
+    case NID_aes_128_gcm:
+        trafficKeys.cipher = EVP_aes_128_gcm();
+        break;
+    case NID_aes_256_gcm:
+        trafficKeys.cipher = EVP_aes_256_gcm();
+        break;
+    default:
+        return false;
+    }
+
+    const auto digest = SSL_CIPHER_get_handshake_digest(cipher);
+    const auto session = SSL_get_session(ssl);
+
+    if(digest == nullptr || session == nullptr)
+    {
+        return false;
+    }
+
+    common::Data masterKey(SSL_MAX_MASTER_KEY_LENGTH);
+    masterKey.resize(SSL_SESSION_get_master_key(session, &masterKey[0], masterKey.size()));
+
+    common::Data seed(SSL3_RANDOM_SIZE * 2);
+    SSL_get_server_random(ssl, &seed[0], SSL3_RANDOM_SIZE);
+    SSL_get_client_random(ssl, &seed[SSL3_RANDOM_SIZE], SSL3_RANDOM_SIZE);
+
+    const size_t keySize = EVP_CIPHER_key_length(trafficKeys.cipher);
+    const size_t ivSize = EVP_GCM_TLS_FIXED_IV_LEN;
+    common::Data keyBlock(keySize * 2 + ivSize * 2);
+    size_t keyBlockSize = keyBlock.size();
+
+    static const std::string label("key expansion");
+    auto context = EVP_PKEY_CTX_new_id(EVP_PKEY_TLS1_PRF, nullptr);
+    const bool derived = context != nullptr
+            && EVP_PKEY_derive_init(context) > 0
+            && EVP_PKEY_CTX_set_tls1_prf_md(context, digest) > 0
+            && EVP_PKEY_CTX_set1_tls1_prf_secret(context, &masterKey[0], masterKey.size()) > 0
+            && EVP_PKEY_CTX_add1_tls1_prf_seed(context, reinterpret_cast<const unsigned char*>(label.c_str()), label.size()) > 0
+            && EVP_PKEY_CTX_add1_tls1_prf_seed(context, &seed[0], seed.size()) > 0
+            && EVP_PKEY_derive(context, &keyBlock[0], &keyBlockSize) > 0;
+
+    EVP_PKEY_CTX_free(context);
+    OPENSSL_cleanse(&masterKey[0], masterKey.size());
+
+    if(!derived)
+    {
+        OPENSSL_cleanse(&keyBlock[0], keyBlock.size());
+        return false;
+    }
+
+    auto keyBlockIter = keyBlock.begin();
+    trafficKeys.version = TLS1_2_VERSION;
+    trafficKeys.clientKey.assign(keyBlockIter, keyBlockIter + keySize);
+    trafficKeys.serverKey.assign(keyBlockIter + keySize, keyBlockIter + keySize * 2);
+    trafficKeys.clientIV.assign(keyBlockIter + keySize * 2, keyBlockIter + keySize * 2 + ivSize);
+    trafficKeys.serverIV.assign(keyBlockIter + keySize * 2 + ivSize, keyBlock.end());
+    OPENSSL_cleanse(&keyBlock[0], keyBlock.size());
+
+    return true;
+#else
+    return false;
+#endif
+}
+
+SSL_SESSION* SSLWrapper::getSession(SSL* ssl)
+{
+#if (OPENSSL_VERSION_NUMBER >= 0x10101000L)
+    const auto session = SSL_get_session(ssl);
+
+    if(session == nullptr || SSL_SESSION_is_resumable(session) != 1)
+    {
+        return nullptr;
+    }
+
+    // SSL_free marks the session of a connection closed without close_notify as not resumable
+    return SSL_SESSION_dup(session);
+#else
+    return SSL_get1_session(ssl);
+#endif
+}
+
+bool SSLWrapper::setSession(SSL* ssl, SSL_SESSION* session)
+{
+    return SSL_set_session(ssl, session) == 1;
+}
+
+bool SSLWrapper::isSessionReused(SSL* ssl)
+{
+    return SSL_session_reused(ssl) == 1;
+}
+
+std::string SSLWrapper::getCipherName(const SSL* ssl)
+{
+    const auto cipher = SSL_get_current_cipher(ssl);
+    return cipher != nullptr ? SSL_CIPHER_get_name(cipher) : std::string();
+}
+
+bool SSLWrapper::hasAESAcceleration()
+{
+#if defined(__x86_64__) || defined(__i386__)
+    unsigned int eax = 0, ebx = 0, ecx = 0, edx = 0;
+    return __get_cpuid(1, &eax, &ebx, &ecx, &edx) != 0 && (ecx & bit_AES) != 0;
+#elif defined(__aarch64__) && defined(__linux__)
+    return (getauxval(AT_HWCAP) & HWCAP_AES) != 0;
+#elif defined(__arm__) && defined(__linux__)
+    return (getauxval(AT_HWCAP2) & HWCAP2_AES) != 0;
+#else
+    return false;
+#endif
+}
+
 }
 }
 }
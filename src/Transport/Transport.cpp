@@ -37,11 +37,10 @@ void Transport::receive(size_t size, ReceivePromise::Pointer promise)
 
         if(receiveQueue_.size() == 1)
         {
-            try
-            {
-                this->distributeReceivedData();
-            }
-            catch(const error::Error& e)
+            error::Error e;
+            this->distributeReceivedData(e);
+
+            if(e != error::ErrorCode::NONE)
             {
                 this->rejectReceivePromises(e);
             }
@@ -51,18 +50,21 @@ void Transport::receive(size_t size, ReceivePromise::Pointer promise)
 
 void Transport::receiveHandler(size_t bytesTransferred)
 {
-    try
+    error::Error e;
+    receivedDataSink_.commit(bytesTransferred, e);
+
+    if(e == error::ErrorCode::NONE)
     {
-        receivedDataSink_.commit(bytesTransferred);
-        this->distributeReceivedData();
+        this->distributeReceivedData(e);
     }
-    catch(const error::Error& e)
+
+    if(e != error::ErrorCode::NONE)
     {
         this->rejectReceivePromises(e);
     }
 }
 
-void Transport::distributeReceivedData()
+void Transport::distributeReceivedData(error::Error& e)
 {
     for(auto queueElement = receiveQueue_.begin(); queueElement != receiveQueue_.end();)
     {
@@ -75,7 +77,13 @@ void Transport::distributeReceivedData()
         }
         else
         {
-            auto data(receivedDataSink_.consume(queueElement->first));
+            auto data(receivedDataSink_.consume(queueElement->first, e));
+
+            if(e != error::ErrorCode::NONE)
+            {
+                return;
+            }
+
             queueElement->second->resolve(std::move(data));
             queueElement = receiveQueue_.erase(queueElement);
         }
@@ -153,6 +153,11 @@ void USBWrapper::handleEvents()
     libusb_handle_events(usbContext_);
 }
 
+void USBWrapper::interruptEventHandler()
+{
+    libusb_interrupt_event_handler(usbContext_);
+}
+
 HotplugCallbackHandle USBWrapper::hotplugRegisterCallback(libusb_hotplug_event events, libusb_hotplug_flag flags, int vendor_id, int product_id, int dev_class,
                                                           libusb_hotplug_callback_fn cb_fn, void *user_data)
 {